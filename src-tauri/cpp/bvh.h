@@ -0,0 +1,595 @@
+// bvh.h
+//
+// Bounding-volume hierarchy over a triangle soup, built for the cutting
+// simulation's query pattern: millions of ray casts and closest-point
+// lookups against one immutable mesh.
+//
+// This header has no dependency on OCCT so it can be compiled and tested
+// independently (same pattern as slot_map.h and section_chaining.h).  The
+// C API wrapper lives in cam_bvh.cpp.
+//
+// Design:
+//   - Binary tree, median split on the longest centroid-bounds axis, leaves
+//     of up to kLeafSize triangles.  Median split is within a few percent of
+//     SAH for the near-uniform tessellations the kernel produces and builds
+//     in one pass.
+//   - Triangle vertices are re-packed into leaf order at build time (9
+//     doubles per triangle), so a leaf test reads one contiguous run —
+//     cache-friendly and independent of the source mesh's lifetime and
+//     precision.  The cost is one extra copy of the position data.
+//   - Nodes are stored in a flat vector; a node's children are adjacent
+//     (left = index, right = index + 1), so traversal needs one child index
+//     per node and a fixed-size stack, no recursion.
+//   - The tree is immutable after build(); all queries are const and safe to
+//     run concurrently from any number of threads.
+//
+// Ray casts use Möller–Trumbore; closest-point uses the standard
+// region-classification test (Ericson, Real-Time Collision Detection §5.1.5)
+// with best-first pruning on node box distance.  Mesh-to-mesh distance
+// (distance_to) walks node pairs of two trees pruned on box-box distance.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class TriangleBvh {
+public:
+    static constexpr size_t   kLeafSize = 4;
+    static constexpr uint32_t kNoHit    = UINT32_MAX;
+
+    struct RayHit {
+        double   t   = -1.0;    // distance along dir (dir's length is the unit)
+        double   u   = 0.0;     // barycentric coordinates of the hit
+        double   v   = 0.0;
+        uint32_t tri = kNoHit;  // original triangle index, kNoHit on miss
+    };
+
+    struct ClosestHit {
+        double   point[3] = {0, 0, 0};
+        double   distance = -1.0;
+        uint32_t tri      = kNoHit;
+    };
+
+    TriangleBvh() = default;
+
+    // Build the tree over n_triangles triangles.  `indices` is 3 uint32 per
+    // triangle into `vertices` (3 VertexT per vertex; float or double).
+    // The inputs are copied — they need not outlive the tree.
+    template <typename VertexT>
+    void build(const VertexT* vertices, const uint32_t* indices,
+               size_t n_triangles) {
+        nodes_.clear();
+        tri_verts_.clear();
+        tri_ids_.clear();
+        if (n_triangles == 0) return;
+
+        // Gather per-triangle vertex positions and centroids up front.
+        std::vector<double> verts(n_triangles * 9);
+        std::vector<double> centroids(n_triangles * 3);
+        for (size_t t = 0; t < n_triangles; ++t) {
+            for (int c = 0; c < 3; ++c) {
+                const VertexT* v = vertices + size_t(indices[t * 3 + c]) * 3;
+                for (int a = 0; a < 3; ++a)
+                    verts[t * 9 + c * 3 + a] = static_cast<double>(v[a]);
+            }
+            for (int a = 0; a < 3; ++a)
+                centroids[t * 3 + a] = (verts[t * 9 + a] +
+                                        verts[t * 9 + 3 + a] +
+                                        verts[t * 9 + 6 + a]) / 3.0;
+        }
+
+        std::vector<uint32_t> order(n_triangles);
+        for (size_t t = 0; t < n_triangles; ++t) order[t] = uint32_t(t);
+
+        nodes_.reserve(2 * n_triangles);
+        tri_verts_.reserve(n_triangles * 9);
+        tri_ids_.reserve(n_triangles);
+        nodes_.emplace_back();
+        build_node(0, verts, centroids, order.data(), 0, n_triangles);
+    }
+
+    bool   empty() const { return nodes_.empty(); }
+    size_t triangle_count() const { return tri_ids_.size(); }
+
+    // Cast a ray from origin along dir (need not be unit length; t is in
+    // units of |dir|).  Returns the nearest front- or back-facing hit with
+    // t >= 0, or a default RayHit (t < 0, tri == kNoHit) on miss.
+    RayHit raycast(const double origin[3], const double dir[3]) const {
+        RayHit best;
+        if (nodes_.empty()) return best;
+        best.t = std::numeric_limits<double>::infinity();
+
+        double inv_dir[3];
+        for (int a = 0; a < 3; ++a)
+            inv_dir[a] = (dir[a] != 0.0)
+                             ? 1.0 / dir[a]
+                             : std::numeric_limits<double>::infinity();
+
+        uint32_t stack[kMaxDepth];
+        size_t   top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = nodes_[stack[--top]];
+            if (!ray_box(origin, inv_dir, node, best.t)) continue;
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i)
+                    ray_triangle(origin, dir, i, best);
+            } else {
+                // The left child holds the lower-axis centroids, so walk it
+                // first when the ray points up the axis (near child is
+                // popped, and therefore tested, first).
+                const bool left_first = dir[node.axis] >= 0.0;
+                stack[top++] = node.first + (left_first ? 1u : 0u);
+                stack[top++] = node.first + (left_first ? 0u : 1u);
+            }
+        }
+        if (!std::isfinite(best.t)) { best.t = -1.0; best.tri = kNoHit; }
+        return best;
+    }
+
+    // Return the closest point on any triangle to p.
+    // Returns a default ClosestHit (distance < 0) for an empty tree.
+    ClosestHit closest_point(const double p[3]) const {
+        ClosestHit best;
+        if (nodes_.empty()) return best;
+        double best_sq = std::numeric_limits<double>::infinity();
+
+        uint32_t stack[kMaxDepth];
+        size_t   top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = nodes_[stack[--top]];
+            if (box_dist_sq(p, node) >= best_sq) continue;
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    double q[3];
+                    closest_on_triangle(p, &tri_verts_[size_t(i) * 9], q);
+                    const double d = dist_sq(p, q);
+                    if (d < best_sq) {
+                        best_sq = d;
+                        best.tri = tri_ids_[i];
+                        for (int a = 0; a < 3; ++a) best.point[a] = q[a];
+                    }
+                }
+            } else {
+                // Push the farther child first so the nearer is tested first.
+                const double dl = box_dist_sq(p, nodes_[node.first]);
+                const double dr = box_dist_sq(p, nodes_[node.first + 1]);
+                if (dl < dr) {
+                    stack[top++] = node.first + 1;
+                    stack[top++] = node.first;
+                } else {
+                    stack[top++] = node.first;
+                    stack[top++] = node.first + 1;
+                }
+            }
+        }
+        if (best.tri != kNoHit) best.distance = std::sqrt(best_sq);
+        return best;
+    }
+
+    // Minimum distance between this tree's triangles and `other`'s, with an
+    // optional rigid transform applied to `other` (row-major 3×4 [R|t];
+    // NULL = identity).  Returns 0 when the meshes touch or interpenetrate
+    // and -1 if either tree is empty.
+    //
+    // Pair traversal pruned on box-box distance; `other`'s node boxes are
+    // re-bounded through the transform (AABB of the 8 mapped corners), so
+    // the prune stays conservative for any placement.  Leaf pairs run the
+    // exact triangle-triangle test: the closest pair of non-intersecting
+    // triangles always involves an edge, so six segment-triangle distances
+    // cover it, and the segment-triangle test itself reports intersection
+    // (distance 0) for penetrating input.
+    double distance_to(const TriangleBvh& other,
+                       const double* xf = nullptr) const {
+        if (nodes_.empty() || other.nodes_.empty()) return -1.0;
+        double best_sq = std::numeric_limits<double>::infinity();
+
+        struct Pair { uint32_t a, b; };
+        Pair   stack[2 * kMaxDepth];
+        size_t top = 0;
+        stack[top++] = {0, 0};
+        while (top > 0) {
+            const Pair pair = stack[--top];
+            const Node& na = nodes_[pair.a];
+            const Node& nb = other.nodes_[pair.b];
+
+            double bbmin[3], bbmax[3];
+            transformed_bounds(nb, xf, bbmin, bbmax);
+            if (box_box_dist_sq(na, bbmin, bbmax) >= best_sq) continue;
+
+            if (na.count > 0 && nb.count > 0) {
+                for (uint32_t i = na.first; i < na.first + na.count; ++i) {
+                    for (uint32_t j = nb.first; j < nb.first + nb.count; ++j) {
+                        double tb[9];
+                        for (int c = 0; c < 3; ++c)
+                            transform_point(
+                                xf, &other.tri_verts_[size_t(j) * 9 + c * 3],
+                                tb + c * 3);
+                        best_sq = std::min(
+                            best_sq,
+                            tri_tri_dist_sq(&tri_verts_[size_t(i) * 9], tb));
+                        if (best_sq == 0.0) return 0.0;
+                    }
+                }
+            } else if (nb.count > 0 ||
+                       (na.count == 0 && node_extent(na) >= node_extent(nb))) {
+                // Split this tree's node (other's is a leaf, or ours is the
+                // larger inner node).
+                stack[top++] = {na.first, pair.b};
+                stack[top++] = {na.first + 1, pair.b};
+            } else {
+                stack[top++] = {pair.a, nb.first};
+                stack[top++] = {pair.a, nb.first + 1};
+            }
+        }
+        return std::sqrt(best_sq);
+    }
+
+private:
+    struct Node {
+        double   bmin[3], bmax[3];
+        uint32_t first = 0;  // child pair index (inner) or triangle run start (leaf)
+        uint32_t count = 0;  // 0 for inner nodes
+        uint8_t  axis  = 0;  // split axis of inner nodes
+    };
+
+    // log2(4M triangles / kLeafSize) is ~20 for a balanced tree; median split
+    // keeps it balanced, and 64 leaves generous slack for degenerate input.
+    static constexpr size_t kMaxDepth = 64;
+
+    std::vector<Node>     nodes_;
+    std::vector<double>   tri_verts_;  // 9 doubles per triangle, leaf order
+    std::vector<uint32_t> tri_ids_;    // packed position -> original index
+
+    // Fill nodes_[index] with the subtree over order[begin, end).  Child
+    // pairs are allocated adjacently before recursing, so right = left + 1
+    // holds as the traversals assume.
+    void build_node(uint32_t index, const std::vector<double>& verts,
+                    const std::vector<double>& centroids,
+                    uint32_t* order, size_t begin, size_t end) {
+        double bmin[3], bmax[3], cmin[3], cmax[3];
+        for (int a = 0; a < 3; ++a) {
+            bmin[a] = cmin[a] = std::numeric_limits<double>::infinity();
+            bmax[a] = cmax[a] = -std::numeric_limits<double>::infinity();
+        }
+        for (size_t i = begin; i < end; ++i) {
+            const double* tv = &verts[size_t(order[i]) * 9];
+            const double* ct = &centroids[size_t(order[i]) * 3];
+            for (int c = 0; c < 3; ++c)
+                for (int a = 0; a < 3; ++a) {
+                    bmin[a] = std::min(bmin[a], tv[c * 3 + a]);
+                    bmax[a] = std::max(bmax[a], tv[c * 3 + a]);
+                }
+            for (int a = 0; a < 3; ++a) {
+                cmin[a] = std::min(cmin[a], ct[a]);
+                cmax[a] = std::max(cmax[a], ct[a]);
+            }
+        }
+        for (int a = 0; a < 3; ++a) {
+            nodes_[index].bmin[a] = bmin[a];
+            nodes_[index].bmax[a] = bmax[a];
+        }
+
+        uint8_t axis = 0;
+        for (int a = 1; a < 3; ++a)
+            if (cmax[a] - cmin[a] > cmax[axis] - cmin[axis]) axis = uint8_t(a);
+
+        // Leaf: small run, or centroids all coincide (no split possible).
+        if (end - begin <= kLeafSize || cmax[axis] - cmin[axis] == 0.0) {
+            nodes_[index].first = uint32_t(tri_ids_.size());
+            nodes_[index].count = uint32_t(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                tri_ids_.push_back(order[i]);
+                const double* tv = &verts[size_t(order[i]) * 9];
+                tri_verts_.insert(tri_verts_.end(), tv, tv + 9);
+            }
+            return;
+        }
+
+        const size_t mid = begin + (end - begin) / 2;
+        std::nth_element(order + begin, order + mid, order + end,
+                         [&](uint32_t a, uint32_t b) {
+                             return centroids[size_t(a) * 3 + axis] <
+                                    centroids[size_t(b) * 3 + axis];
+                         });
+
+        const uint32_t left = uint32_t(nodes_.size());
+        nodes_.emplace_back();
+        nodes_.emplace_back();
+        nodes_[index].axis  = axis;
+        nodes_[index].first = left;
+        build_node(left, verts, centroids, order, begin, mid);
+        build_node(left + 1, verts, centroids, order, mid, end);
+    }
+
+    static double dist_sq(const double a[3], const double b[3]) {
+        double s = 0;
+        for (int i = 0; i < 3; ++i) s += (a[i] - b[i]) * (a[i] - b[i]);
+        return s;
+    }
+
+    static bool ray_box(const double origin[3], const double inv_dir[3],
+                        const Node& node, double t_max) {
+        double t0 = 0.0, t1 = t_max;
+        for (int a = 0; a < 3; ++a) {
+            double tn = (node.bmin[a] - origin[a]) * inv_dir[a];
+            double tf = (node.bmax[a] - origin[a]) * inv_dir[a];
+            if (tn > tf) std::swap(tn, tf);
+            t0 = std::max(t0, tn);
+            t1 = std::min(t1, tf);
+            if (t0 > t1) return false;
+        }
+        return true;
+    }
+
+    void ray_triangle(const double origin[3], const double dir[3],
+                      uint32_t packed, RayHit& best) const {
+        const double* tv = &tri_verts_[size_t(packed) * 9];
+        double e1[3], e2[3];
+        for (int a = 0; a < 3; ++a) {
+            e1[a] = tv[3 + a] - tv[a];
+            e2[a] = tv[6 + a] - tv[a];
+        }
+        double pvec[3] = {dir[1] * e2[2] - dir[2] * e2[1],
+                          dir[2] * e2[0] - dir[0] * e2[2],
+                          dir[0] * e2[1] - dir[1] * e2[0]};
+        const double det = e1[0] * pvec[0] + e1[1] * pvec[1] + e1[2] * pvec[2];
+        if (std::fabs(det) < 1e-300) return;  // ray parallel to triangle
+        const double inv_det = 1.0 / det;
+        double tvec[3];
+        for (int a = 0; a < 3; ++a) tvec[a] = origin[a] - tv[a];
+        const double u =
+            (tvec[0] * pvec[0] + tvec[1] * pvec[1] + tvec[2] * pvec[2]) * inv_det;
+        if (u < 0.0 || u > 1.0) return;
+        double qvec[3] = {tvec[1] * e1[2] - tvec[2] * e1[1],
+                          tvec[2] * e1[0] - tvec[0] * e1[2],
+                          tvec[0] * e1[1] - tvec[1] * e1[0]};
+        const double v =
+            (dir[0] * qvec[0] + dir[1] * qvec[1] + dir[2] * qvec[2]) * inv_det;
+        if (v < 0.0 || u + v > 1.0) return;
+        const double t =
+            (e2[0] * qvec[0] + e2[1] * qvec[1] + e2[2] * qvec[2]) * inv_det;
+        if (t < 0.0 || t >= best.t) return;
+        best.t   = t;
+        best.u   = u;
+        best.v   = v;
+        best.tri = tri_ids_[packed];
+    }
+
+    static double box_dist_sq(const double p[3], const Node& node) {
+        double s = 0;
+        for (int a = 0; a < 3; ++a) {
+            const double d = std::max({node.bmin[a] - p[a], 0.0,
+                                       p[a] - node.bmax[a]});
+            s += d * d;
+        }
+        return s;
+    }
+
+    // Apply a row-major 3×4 rigid transform (NULL = identity) to p.
+    static void transform_point(const double* xf, const double p[3],
+                                double out[3]) {
+        if (!xf) {
+            for (int i = 0; i < 3; ++i) out[i] = p[i];
+            return;
+        }
+        for (int i = 0; i < 3; ++i)
+            out[i] = xf[i * 4 + 0] * p[0] + xf[i * 4 + 1] * p[1] +
+                     xf[i * 4 + 2] * p[2] + xf[i * 4 + 3];
+    }
+
+    // AABB of node's box pushed through xf (corners mapped, re-bounded).
+    static void transformed_bounds(const Node& node, const double* xf,
+                                   double bmin[3], double bmax[3]) {
+        if (!xf) {
+            for (int a = 0; a < 3; ++a) {
+                bmin[a] = node.bmin[a];
+                bmax[a] = node.bmax[a];
+            }
+            return;
+        }
+        for (int a = 0; a < 3; ++a) {
+            bmin[a] = std::numeric_limits<double>::infinity();
+            bmax[a] = -std::numeric_limits<double>::infinity();
+        }
+        for (int corner = 0; corner < 8; ++corner) {
+            const double p[3] = {
+                (corner & 1) ? node.bmax[0] : node.bmin[0],
+                (corner & 2) ? node.bmax[1] : node.bmin[1],
+                (corner & 4) ? node.bmax[2] : node.bmin[2]};
+            double q[3];
+            transform_point(xf, p, q);
+            for (int a = 0; a < 3; ++a) {
+                bmin[a] = std::min(bmin[a], q[a]);
+                bmax[a] = std::max(bmax[a], q[a]);
+            }
+        }
+    }
+
+    static double box_box_dist_sq(const Node& a, const double bmin[3],
+                                  const double bmax[3]) {
+        double s = 0;
+        for (int i = 0; i < 3; ++i) {
+            const double d =
+                std::max({a.bmin[i] - bmax[i], 0.0, bmin[i] - a.bmax[i]});
+            s += d * d;
+        }
+        return s;
+    }
+
+    static double node_extent(const Node& node) {
+        double e = 0;
+        for (int a = 0; a < 3; ++a)
+            e = std::max(e, node.bmax[a] - node.bmin[a]);
+        return e;
+    }
+
+    // Squared distance between segments [p1,q1] and [p2,q2]
+    // (Ericson, Real-Time Collision Detection §5.1.9).
+    static double seg_seg_dist_sq(const double p1[3], const double q1[3],
+                                  const double p2[3], const double q2[3]) {
+        double d1[3], d2[3], r[3];
+        for (int i = 0; i < 3; ++i) {
+            d1[i] = q1[i] - p1[i];
+            d2[i] = q2[i] - p2[i];
+            r[i]  = p1[i] - p2[i];
+        }
+        const double a = d1[0] * d1[0] + d1[1] * d1[1] + d1[2] * d1[2];
+        const double e = d2[0] * d2[0] + d2[1] * d2[1] + d2[2] * d2[2];
+        const double f = d2[0] * r[0] + d2[1] * r[1] + d2[2] * r[2];
+        const double kEps = 1e-30;
+        double s = 0.0, t = 0.0;
+        if (a <= kEps && e <= kEps) {
+            // Both segments degenerate to points.
+        } else if (a <= kEps) {
+            t = std::clamp(f / e, 0.0, 1.0);
+        } else {
+            const double c = d1[0] * r[0] + d1[1] * r[1] + d1[2] * r[2];
+            if (e <= kEps) {
+                s = std::clamp(-c / a, 0.0, 1.0);
+            } else {
+                const double b = d1[0] * d2[0] + d1[1] * d2[1] + d1[2] * d2[2];
+                const double denom = a * e - b * b;
+                if (denom != 0.0)
+                    s = std::clamp((b * f - c * e) / denom, 0.0, 1.0);
+                t = (b * s + f) / e;
+                if (t < 0.0) {
+                    t = 0.0;
+                    s = std::clamp(-c / a, 0.0, 1.0);
+                } else if (t > 1.0) {
+                    t = 1.0;
+                    s = std::clamp((b - c) / a, 0.0, 1.0);
+                }
+            }
+        }
+        double c1[3], c2[3];
+        for (int i = 0; i < 3; ++i) {
+            c1[i] = p1[i] + s * d1[i];
+            c2[i] = p2[i] + t * d2[i];
+        }
+        return dist_sq(c1, c2);
+    }
+
+    // Does segment [p,q] pierce triangle tv?  (Möller–Trumbore with the hit
+    // parameter clamped to the segment.)
+    static bool seg_tri_intersects(const double p[3], const double q[3],
+                                   const double* tv) {
+        double dir[3], e1[3], e2[3];
+        for (int a = 0; a < 3; ++a) {
+            dir[a] = q[a] - p[a];
+            e1[a]  = tv[3 + a] - tv[a];
+            e2[a]  = tv[6 + a] - tv[a];
+        }
+        const double pvec[3] = {dir[1] * e2[2] - dir[2] * e2[1],
+                                dir[2] * e2[0] - dir[0] * e2[2],
+                                dir[0] * e2[1] - dir[1] * e2[0]};
+        const double det = e1[0] * pvec[0] + e1[1] * pvec[1] + e1[2] * pvec[2];
+        if (std::fabs(det) < 1e-300) return false;  // parallel: edges cover it
+        const double inv_det = 1.0 / det;
+        double tvec[3];
+        for (int a = 0; a < 3; ++a) tvec[a] = p[a] - tv[a];
+        const double u =
+            (tvec[0] * pvec[0] + tvec[1] * pvec[1] + tvec[2] * pvec[2]) *
+            inv_det;
+        if (u < 0.0 || u > 1.0) return false;
+        const double qvec[3] = {tvec[1] * e1[2] - tvec[2] * e1[1],
+                                tvec[2] * e1[0] - tvec[0] * e1[2],
+                                tvec[0] * e1[1] - tvec[1] * e1[0]};
+        const double v =
+            (dir[0] * qvec[0] + dir[1] * qvec[1] + dir[2] * qvec[2]) * inv_det;
+        if (v < 0.0 || u + v > 1.0) return false;
+        const double t =
+            (e2[0] * qvec[0] + e2[1] * qvec[1] + e2[2] * qvec[2]) * inv_det;
+        return t >= 0.0 && t <= 1.0;
+    }
+
+    // Squared distance between segment [p,q] and triangle tv.
+    static double seg_tri_dist_sq(const double p[3], const double q[3],
+                                  const double* tv) {
+        if (seg_tri_intersects(p, q, tv)) return 0.0;
+        double out[3];
+        closest_on_triangle(p, tv, out);
+        double best = dist_sq(p, out);
+        closest_on_triangle(q, tv, out);
+        best = std::min(best, dist_sq(q, out));
+        for (int e = 0; e < 3; ++e)
+            best = std::min(best, seg_seg_dist_sq(p, q, tv + e * 3,
+                                                  tv + ((e + 1) % 3) * 3));
+        return best;
+    }
+
+    // Squared distance between triangles ta and tv (9 doubles each).  The
+    // closest pair of disjoint triangles involves at least one edge point,
+    // so the six edge-vs-triangle distances are exhaustive.
+    static double tri_tri_dist_sq(const double* ta, const double* tb) {
+        double best = std::numeric_limits<double>::infinity();
+        for (int e = 0; e < 3 && best > 0.0; ++e)
+            best = std::min(best, seg_tri_dist_sq(ta + e * 3,
+                                                  ta + ((e + 1) % 3) * 3, tb));
+        for (int e = 0; e < 3 && best > 0.0; ++e)
+            best = std::min(best, seg_tri_dist_sq(tb + e * 3,
+                                                  tb + ((e + 1) % 3) * 3, ta));
+        return best;
+    }
+
+    // Closest point on triangle (a, b, c) to p, written to out.
+    static void closest_on_triangle(const double p[3], const double* tv,
+                                    double out[3]) {
+        const double *a = tv, *b = tv + 3, *c = tv + 6;
+        double ab[3], ac[3], ap[3];
+        for (int i = 0; i < 3; ++i) {
+            ab[i] = b[i] - a[i];
+            ac[i] = c[i] - a[i];
+            ap[i] = p[i] - a[i];
+        }
+        const double d1 = ab[0] * ap[0] + ab[1] * ap[1] + ab[2] * ap[2];
+        const double d2 = ac[0] * ap[0] + ac[1] * ap[1] + ac[2] * ap[2];
+        if (d1 <= 0.0 && d2 <= 0.0) {  // vertex a
+            for (int i = 0; i < 3; ++i) out[i] = a[i];
+            return;
+        }
+        double bp[3];
+        for (int i = 0; i < 3; ++i) bp[i] = p[i] - b[i];
+        const double d3 = ab[0] * bp[0] + ab[1] * bp[1] + ab[2] * bp[2];
+        const double d4 = ac[0] * bp[0] + ac[1] * bp[1] + ac[2] * bp[2];
+        if (d3 >= 0.0 && d4 <= d3) {  // vertex b
+            for (int i = 0; i < 3; ++i) out[i] = b[i];
+            return;
+        }
+        const double vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {  // edge ab
+            const double v = d1 / (d1 - d3);
+            for (int i = 0; i < 3; ++i) out[i] = a[i] + v * ab[i];
+            return;
+        }
+        double cp[3];
+        for (int i = 0; i < 3; ++i) cp[i] = p[i] - c[i];
+        const double d5 = ab[0] * cp[0] + ab[1] * cp[1] + ab[2] * cp[2];
+        const double d6 = ac[0] * cp[0] + ac[1] * cp[1] + ac[2] * cp[2];
+        if (d6 >= 0.0 && d5 <= d6) {  // vertex c
+            for (int i = 0; i < 3; ++i) out[i] = c[i];
+            return;
+        }
+        const double vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {  // edge ac
+            const double w = d2 / (d2 - d6);
+            for (int i = 0; i < 3; ++i) out[i] = a[i] + w * ac[i];
+            return;
+        }
+        const double va = d3 * d6 - d5 * d4;
+        if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0) {  // edge bc
+            const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            for (int i = 0; i < 3; ++i) out[i] = b[i] + w * (c[i] - b[i]);
+            return;
+        }
+        // Interior.
+        const double denom = 1.0 / (va + vb + vc);
+        const double v = vb * denom, w = vc * denom;
+        for (int i = 0; i < 3; ++i) out[i] = a[i] + v * ab[i] + w * ac[i];
+    }
+};
@@ -0,0 +1,148 @@
+// cam_bvh.cpp
+//
+// C API wrapper around the TriangleBvh spatial index (bvh.h).
+//
+// A built index is immutable, so the store hands out shared_ptr<const
+// TriangleBvh> and the batch queries run lock-free: worker threads pull
+// query indices from a shared atomic cursor in chunks, the same pool shape
+// as the parallel mesh assembly and multi-z slicing.
+//
+// This file reads mesh data only through the public cg_mesh_* accessors
+// (with a map/unmap pin around the build), so it has no OCCT dependency and
+// links into the no-OCCT test builds alongside cam_polygon.cpp.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "bvh.h"
+#include "cam_error.h"
+#include "cam_geometry.h"
+#include "worker_pool.h"
+
+// ── BVH store ────────────────────────────────────────────────────────────────
+
+static std::shared_mutex g_bvh_mutex;
+static std::unordered_map<uint64_t, std::shared_ptr<const TriangleBvh>> g_bvh_store;
+static std::atomic<uint64_t> g_bvh_next_id{1};
+
+static std::shared_ptr<const TriangleBvh> bvh_store_get(uint64_t id) {
+    std::shared_lock<std::shared_mutex> lock(g_bvh_mutex);
+    auto it = g_bvh_store.find(id);
+    if (it == g_bvh_store.end()) return nullptr;
+    return it->second;
+}
+
+// ── Parallel batch driver ────────────────────────────────────────────────────
+
+// Run fn(i) for i in [0, n) on the kernel worker budget.  Workers grab 1024
+// indices per cursor bump so tiny per-query work does not serialize on the
+// atomic; the calling thread participates.  fn must not throw.
+template <typename Fn>
+static void parallel_for_queries(size_t n, Fn fn) {
+    worker_pool::parallel_for(n, 1024, fn);
+}
+
+// ── C API ────────────────────────────────────────────────────────────────────
+
+extern "C" {
+
+CgBvhId cg_mesh_build_bvh(CgMeshId mesh_id) {
+    if (mesh_id == CG_NULL_ID) {
+        set_last_error("cg_mesh_build_bvh: null handle");
+        return CG_NULL_ID;
+    }
+    if (cg_mesh_map(mesh_id) != CG_OK) {
+        set_last_error("cg_mesh_build_bvh: unknown mesh ID");
+        return CG_NULL_ID;
+    }
+    try {
+        const size_t n_tris = cg_mesh_triangle_count(mesh_id);
+        const uint32_t* indices = cg_mesh_indices_ptr(mesh_id);
+        if (n_tris == 0 || !indices) {
+            cg_mesh_unmap(mesh_id);
+            set_last_error("cg_mesh_build_bvh: empty mesh");
+            return CG_NULL_ID;
+        }
+
+        auto bvh = std::make_shared<TriangleBvh>();
+        if (cg_mesh_precision(mesh_id) == CG_MESH_F32)
+            bvh->build(cg_mesh_vertices_ptr_f32(mesh_id), indices, n_tris);
+        else
+            bvh->build(cg_mesh_vertices_ptr(mesh_id), indices, n_tris);
+        cg_mesh_unmap(mesh_id);
+
+        uint64_t id = g_bvh_next_id.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::shared_mutex> lock(g_bvh_mutex);
+        g_bvh_store.emplace(id, std::move(bvh));
+        return id;
+    } catch (const std::exception& ex) {
+        cg_mesh_unmap(mesh_id);
+        set_last_error(std::string("cg_mesh_build_bvh: ") + ex.what());
+        return CG_NULL_ID;
+    } catch (...) {
+        cg_mesh_unmap(mesh_id);
+        set_last_error("cg_mesh_build_bvh: unknown exception");
+        return CG_NULL_ID;
+    }
+}
+
+CgError cg_bvh_raycast_batch(CgBvhId id,
+                             const double* origins, const double* dirs,
+                             size_t n_rays, CgRayHit* out_hits) {
+    if (!origins || !dirs || !out_hits) {
+        set_last_error("cg_bvh_raycast_batch: null array argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    auto bvh = bvh_store_get(id);
+    if (!bvh) {
+        set_last_error("cg_bvh_raycast_batch: invalid BVH handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    parallel_for_queries(n_rays, [&](size_t i) {
+        const TriangleBvh::RayHit hit =
+            bvh->raycast(origins + i * 3, dirs + i * 3);
+        out_hits[i].t        = hit.t;
+        out_hits[i].u        = hit.u;
+        out_hits[i].v        = hit.v;
+        out_hits[i].triangle = hit.tri;
+    });
+    return CG_OK;
+}
+
+CgError cg_bvh_closest_point_batch(CgBvhId id, const double* points,
+                                   size_t n_points, CgClosestPoint* out_results) {
+    if (!points || !out_results) {
+        set_last_error("cg_bvh_closest_point_batch: null array argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    auto bvh = bvh_store_get(id);
+    if (!bvh) {
+        set_last_error("cg_bvh_closest_point_batch: invalid BVH handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    parallel_for_queries(n_points, [&](size_t i) {
+        const TriangleBvh::ClosestHit hit = bvh->closest_point(points + i * 3);
+        out_results[i].point.x  = hit.point[0];
+        out_results[i].point.y  = hit.point[1];
+        out_results[i].point.z  = hit.point[2];
+        out_results[i].distance = hit.distance;
+        out_results[i].triangle = hit.tri;
+    });
+    return CG_OK;
+}
+
+void cg_bvh_free(CgBvhId id) {
+    if (id == CG_NULL_ID) return;
+    std::unique_lock<std::shared_mutex> lock(g_bvh_mutex);
+    g_bvh_store.erase(id);
+}
+
+} // extern "C"
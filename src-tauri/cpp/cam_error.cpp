@@ -0,0 +1,13 @@
+// cam_error.cpp
+//
+// Out-of-line home of the public error accessor.  Kept in its own translation
+// unit (rather than cam_geometry.cpp) so that no-OCCT modules and their
+// standalone test binaries can link the error channel without pulling in the
+// OCCT-backed kernel.
+
+#include "cam_error.h"
+#include "cam_geometry.h"
+
+extern "C" const char* cg_last_error_message(void) {
+    return g_cg_last_error.c_str();
+}
@@ -0,0 +1,28 @@
+// cam_error.h
+//
+// Thread-local last-error state shared by the kernel's translation units.
+//
+// cam_geometry.cpp originally owned this as file-local state; it lives here
+// so that modules implemented in their own translation units (cam_polygon.cpp
+// and friends) report errors through the same channel read by
+// cg_last_error_message().
+//
+// Internal C++ header — not part of the plain-C public API.
+
+#pragma once
+
+#include <string>
+
+// The per-thread error string returned by cg_last_error_message().
+inline thread_local std::string g_cg_last_error;
+
+inline void set_last_error(const char* msg) {
+    g_cg_last_error = msg ? msg : "";
+}
+
+inline void set_last_error(const std::string& msg) {
+    g_cg_last_error = msg;
+}
+
+// The public accessor cg_last_error_message() lives in cam_error.cpp; link
+// that TU into any binary using this error channel.
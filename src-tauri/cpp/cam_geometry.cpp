@@ -15,108 +15,383 @@
 //     implemented") and return CG_NULL_ID / CG_ERR_NO_RESULT.
 
 // ── OCCT includes ────────────────────────────────────────────────────────────
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BinTools.hxx>
+#include <BRepAlgoAPI_Section.hxx>
 #include <BRepBndLib.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
+#include <BRep_Builder.hxx>
 #include <BRep_Tool.hxx>
+#include <BRepGProp.hxx>
+#include <BRepTools.hxx>
 #include <Bnd_Box.hxx>
+#include <GCPnts_UniformDeflection.hxx>
+#include <GProp_GProps.hxx>
+#include <Geom_Surface.hxx>
 #include <IFSelect_ReturnStatus.hxx>
 #include <Poly_Triangulation.hxx>
 #include <RWStl.hxx>
 #include <STEPControl_Reader.hxx>
+#include <ShapeAnalysis_Surface.hxx>
 #include <ShapeFix_Shape.hxx>
 #include <Standard_Failure.hxx>
 #include <TopAbs_Orientation.hxx>
+#include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <TopoDS_TShape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopLoc_Location.hxx>
+#include <gp.hxx>
+#include <gp_Circ.hxx>
+#include <gp_Cone.hxx>
+#include <gp_Cylinder.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pln.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
 #include <gp_Vec.hxx>
 
 // ── Standard library includes ────────────────────────────────────────────────
+#include <algorithm>
 #include <atomic>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <limits>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 // ── Project includes ─────────────────────────────────────────────────────────
+#include "cam_error.h"
 #include "cam_geometry.h"
+#include "bvh.h"
+#include "decimate.h"
+#include "geom_cache.h"
 #include "handle_registry.h"
+#include "mesh_weld.h"
+#include "perf_counters.h"
+#include "section_chaining.h"
+#include "slot_map.h"
+#include "stl_import.h"
+#include "worker_pool.h"
 
 // ── Internal types ───────────────────────────────────────────────────────────
 
 // Assembled flat mesh buffer stored in the mesh registry.
 // All positions and normals are in world space (face location applied).
+// Exactly one precision's buffers are populated, selected by `precision`:
+// the f64 pair for CG_MESH_F64 (default), the f32 pair for CG_MESH_F32.
 struct CgMeshData {
-    std::vector<double>   vertices; // 3 doubles per vertex [x,y,z, ...]
-    std::vector<double>   normals;  // 3 doubles per vertex [nx,ny,nz, ...] (unit)
-    std::vector<uint32_t> indices;  // 3 uint32 per triangle [i0,i1,i2, ...]
-};
-
-// ── Thread-local error string ────────────────────────────────────────────────
+    CgMeshPrecision       precision = CG_MESH_F64;
+    std::vector<double>   vertices;     // 3 doubles per vertex [x,y,z, ...]
+    std::vector<double>   normals;      // 3 doubles per vertex [nx,ny,nz, ...] (unit)
+    std::vector<float>    vertices_f32; // f32 layout mirrors `vertices`
+    std::vector<float>    normals_f32;  // f32 layout mirrors `normals`
+    std::vector<uint32_t> indices;      // 3 uint32 per triangle [i0,i1,i2, ...]
+
+    // CG_NORMALS_LAZY meshes leave the normal buffer empty at assembly; the
+    // first normal access builds it exactly once (see mesh_ensure_normals).
+    std::once_flag        normals_once;
+
+    // Snapshot view (cg_cache_load): when `backing` is set the accessors
+    // below alias the read-only file mapping instead of the vectors, which
+    // stay empty.  View meshes always carry normals — the save path
+    // materializes them — so the lazy-normal build never runs on one.
+    std::shared_ptr<const stl_import::FileMapping> backing;
+    const double*   view_vertices     = nullptr;
+    const double*   view_normals      = nullptr;
+    const float*    view_vertices_f32 = nullptr;
+    const float*    view_normals_f32  = nullptr;
+    const uint32_t* view_indices      = nullptr;
+    size_t          view_n_scalars    = 0;  // vertex/normal scalar count
+    size_t          view_n_indices    = 0;
+
+    // Buffer accessors: the vectors for an assembled mesh, the mapping for
+    // a snapshot view.  Every reader (including the save path) goes through
+    // these; assembly-time writers touch the vectors directly.
+    const double* vertices_data() const {
+        return backing ? view_vertices : vertices.data();
+    }
+    const double* normals_data() const {
+        return backing ? view_normals : normals.data();
+    }
+    const float* vertices_f32_data() const {
+        return backing ? view_vertices_f32 : vertices_f32.data();
+    }
+    const float* normals_f32_data() const {
+        return backing ? view_normals_f32 : normals_f32.data();
+    }
+    const uint32_t* indices_data() const {
+        return backing ? view_indices : indices.data();
+    }
+    size_t indices_size() const {
+        return backing ? view_n_indices : indices.size();
+    }
+    size_t vertices_size() const {  // scalar count of the active precision
+        if (backing) return view_n_scalars;
+        return precision == CG_MESH_F32 ? vertices_f32.size()
+                                        : vertices.size();
+    }
 
-static thread_local std::string g_last_error;
+    size_t vertex_count() const { return vertices_size() / 3; }
 
-static void set_last_error(const char* msg) {
-    g_last_error = msg ? msg : "";
-}
+    size_t buffer_bytes() const {
+        if (backing) {
+            const size_t scalar = precision == CG_MESH_F32 ? sizeof(float)
+                                                           : sizeof(double);
+            return view_n_scalars * 2 * scalar +
+                   view_n_indices * sizeof(uint32_t);
+        }
+        return vertices.size() * sizeof(double) +
+               normals.size() * sizeof(double) +
+               vertices_f32.size() * sizeof(float) +
+               normals_f32.size() * sizeof(float) +
+               indices.size() * sizeof(uint32_t);
+    }
+};
 
-static void set_last_error(const std::string& msg) {
-    g_last_error = msg;
-}
+// ── Thread-local error string ────────────────────────────────────────────────
+// Shared with the other kernel translation units — see cam_error.h.
 
 // ── Mesh data store ──────────────────────────────────────────────────────────
 // Separate from the shape registry so that we store CgMeshData (flat buffers)
 // rather than Poly_Triangulation (OCCT mesh) objects.  IDs are in a separate
 // namespace from shape IDs; callers use CgMeshId vs CgShapeId to distinguish.
+//
+// Backed by the generation-tagged slot arena (slot_map.h): count/copy/ptr
+// accessors resolve the ID with an array index and a generation compare —
+// no hash, no lock, no refcount bump — and a stale ID after cg_mesh_free
+// cleanly misses instead of aliasing a recycled slot.
 
-static std::shared_mutex                                              g_mesh_mutex;
-static std::unordered_map<uint64_t, std::shared_ptr<CgMeshData>>     g_mesh_store;
-static std::atomic<uint64_t>                                          g_mesh_next_id{1};
+static SlotMap<CgMeshData> g_mesh_store;
 
 static uint64_t mesh_store_insert(std::shared_ptr<CgMeshData> data) {
-    uint64_t id = g_mesh_next_id.fetch_add(1, std::memory_order_relaxed);
-    std::unique_lock<std::shared_mutex> lock(g_mesh_mutex);
-    g_mesh_store.emplace(id, std::move(data));
-    return id;
+    return g_mesh_store.insert(std::move(data));
 }
 
+// Pin table for cg_mesh_map()/cg_mesh_unmap().  Each entry holds an extra
+// shared_ptr keeping the CgMeshData alive (even across cg_mesh_free) plus the
+// number of outstanding maps.  Guarded by its own mutex — the slot arena no
+// longer has a store-wide lock to piggyback on.
+static std::mutex g_mesh_pin_mutex;
+static std::unordered_map<uint64_t,
+                          std::pair<std::shared_ptr<CgMeshData>, uint64_t>> g_mesh_pins;
+
+// Borrow the mesh for the duration of one call (no refcount traffic).
 // Returns nullptr when id is not found (caller sets error).
-static std::shared_ptr<CgMeshData> mesh_store_get(uint64_t id) {
-    std::shared_lock<std::shared_mutex> lock(g_mesh_mutex);
-    auto it = g_mesh_store.find(id);
-    if (it == g_mesh_store.end()) return nullptr;
-    return it->second;
+// Also finds meshes that have been freed but are still pinned via
+// cg_mesh_map(), so mapped buffers remain readable per the pinning contract.
+static CgMeshData* mesh_store_get(uint64_t id) {
+    if (CgMeshData* mesh = g_mesh_store.get(id)) return mesh;
+    std::lock_guard<std::mutex> lock(g_mesh_pin_mutex);
+    auto pit = g_mesh_pins.find(id);
+    if (pit != g_mesh_pins.end()) return pit->second.first.get();
+    return nullptr;
 }
 
 static bool mesh_store_erase(uint64_t id) {
-    std::unique_lock<std::shared_mutex> lock(g_mesh_mutex);
-    return g_mesh_store.erase(id) > 0;
+    return g_mesh_store.erase(id) != nullptr;
+}
+
+// ── Mesh stream store ────────────────────────────────────────────────────────
+// In-progress chunked extractions started by cg_mesh_stream_begin().  Each
+// stream keeps its own reference to the mesh data (so it survives
+// cg_mesh_free, like a map pin) plus a triangle cursor.  Same store pattern
+// as the slicer store below, in its own ID namespace.
+
+struct CgMeshStreamData {
+    std::shared_ptr<CgMeshData> mesh;
+    size_t                      chunk_tris = 0;
+    size_t                      cursor     = 0;  // next triangle to emit
+    std::mutex                  mutex;           // serializes next() calls
+};
+
+static std::shared_mutex g_stream_mutex;
+static std::unordered_map<uint64_t, std::shared_ptr<CgMeshStreamData>>
+    g_stream_store;
+static std::atomic<uint64_t> g_stream_next_id{1};
+
+static uint64_t stream_store_insert(std::shared_ptr<CgMeshStreamData> data) {
+    uint64_t id = g_stream_next_id.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock<std::shared_mutex> lock(g_stream_mutex);
+    g_stream_store.emplace(id, std::move(data));
+    return id;
+}
+
+static std::shared_ptr<CgMeshStreamData> stream_store_get(uint64_t id) {
+    std::shared_lock<std::shared_mutex> lock(g_stream_mutex);
+    auto it = g_stream_store.find(id);
+    if (it == g_stream_store.end()) return nullptr;
+    return it->second;
+}
+
+static bool stream_store_erase(uint64_t id) {
+    std::unique_lock<std::shared_mutex> lock(g_stream_mutex);
+    return g_stream_store.erase(id) > 0;
+}
+
+// ── Slicer store ─────────────────────────────────────────────────────────────
+// Persistent slicing engines built by cg_slicer_new().  Each slicer keeps its
+// own TopoDS_Shape reference plus a per-face Z-interval table, so individual
+// slice calls only visit the faces a plane actually crosses.  Same store
+// pattern as the mesh store above, in its own ID namespace.
+
+// One face with its precomputed Z extent.
+struct SlicerFace {
+    TopoDS_Face face;
+    double      zmin = 0.0;
+    double      zmax = 0.0;
+};
+
+struct CgSlicerData {
+    TopoDS_Shape            shape;  // own reference — outlives cg_shape_free
+    std::vector<SlicerFace> faces;
+};
+
+static std::shared_mutex                                          g_slicer_mutex;
+static std::unordered_map<uint64_t, std::shared_ptr<CgSlicerData>> g_slicer_store;
+static std::atomic<uint64_t>                                      g_slicer_next_id{1};
+
+static uint64_t slicer_store_insert(std::shared_ptr<CgSlicerData> data) {
+    uint64_t id = g_slicer_next_id.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock<std::shared_mutex> lock(g_slicer_mutex);
+    g_slicer_store.emplace(id, std::move(data));
+    return id;
+}
+
+static std::shared_ptr<CgSlicerData> slicer_store_get(uint64_t id) {
+    std::shared_lock<std::shared_mutex> lock(g_slicer_mutex);
+    auto it = g_slicer_store.find(id);
+    if (it == g_slicer_store.end()) return nullptr;
+    return it->second;
+}
+
+static bool slicer_store_erase(uint64_t id) {
+    std::unique_lock<std::shared_mutex> lock(g_slicer_mutex);
+    return g_slicer_store.erase(id) > 0;
+}
+
+// Build the per-face Z-interval table for a shape.
+static void slicer_build_faces(const TopoDS_Shape&      shape,
+                                std::vector<SlicerFace>& out)
+{
+    for (TopExp_Explorer ex(shape, TopAbs_FACE); ex.More(); ex.Next()) {
+        SlicerFace sf;
+        sf.face = TopoDS::Face(ex.Current());
+        Bnd_Box box;
+        BRepBndLib::Add(sf.face, box);
+        if (box.IsVoid()) continue;
+        double xmin, ymin, xmax, ymax;
+        box.Get(xmin, ymin, sf.zmin, xmax, ymax, sf.zmax);
+        out.push_back(sf);
+    }
+}
+
+// Section one Z level against the faces whose Z interval contains it.
+// Appends unordered (start, end) segment pairs to out_pts; curved section
+// edges are discretized to chord_tol.  May throw Standard_Failure.
+static void slicer_section_level(const CgSlicerData&    slicer,
+                                  double                 z,
+                                  double                 chord_tol,
+                                  std::vector<CgPoint3>& out_pts)
+{
+    // Gather candidate faces from the Z-interval table.
+    const double eps = 1e-9;
+    BRep_Builder    builder;
+    TopoDS_Compound candidates;
+    builder.MakeCompound(candidates);
+    size_t n_candidates = 0;
+    for (const SlicerFace& sf : slicer.faces) {
+        if (z < sf.zmin - eps || z > sf.zmax + eps) continue;
+        builder.Add(candidates, sf.face);
+        ++n_candidates;
+    }
+    if (n_candidates == 0) return;
+
+    const gp_Pln plane(gp_Pnt(0.0, 0.0, z), gp::DZ());
+
+    BRepAlgoAPI_Section section(candidates, plane, /*PerformNow=*/Standard_False);
+    section.Approximation(Standard_True);
+    section.Build();
+    if (!section.IsDone()) return;
+
+    // Discretize each section edge into segment pairs.
+    for (TopExp_Explorer ex(section.Shape(), TopAbs_EDGE); ex.More(); ex.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(ex.Current());
+        BRepAdaptor_Curve curve(edge);
+        GCPnts_UniformDeflection disc(curve, chord_tol,
+                                      curve.FirstParameter(),
+                                      curve.LastParameter());
+        if (!disc.IsDone() || disc.NbPoints() < 2) {
+            // Degenerate edge — fall back to its parametric endpoints.
+            gp_Pnt a = curve.Value(curve.FirstParameter());
+            gp_Pnt b = curve.Value(curve.LastParameter());
+            out_pts.push_back(CgPoint3{a.X(), a.Y(), a.Z()});
+            out_pts.push_back(CgPoint3{b.X(), b.Y(), b.Z()});
+            continue;
+        }
+        for (int i = 1; i < disc.NbPoints(); ++i) {
+            gp_Pnt a = disc.Value(i);
+            gp_Pnt b = disc.Value(i + 1);
+            out_pts.push_back(CgPoint3{a.X(), a.Y(), a.Z()});
+            out_pts.push_back(CgPoint3{b.X(), b.Y(), b.Z()});
+        }
+    }
 }
 
 // ── Helper: build CgMeshData from Poly_Triangulation ─────────────────────────
-// Used by both cg_load_stl and cg_shape_tessellate.
+// Used by cg_load_stl; cg_shape_tessellate assembles from cached per-face
+// fragments instead (see the tessellation fragment cache below).
 // face_reversed: if true, winding order is flipped (TopAbs_REVERSED face).
 
-static void append_triangulation(CgMeshData&                           out,
-                                  const Handle(Poly_Triangulation)&      tri,
-                                  const TopLoc_Location&                 loc,
-                                  bool                                   face_reversed)
+// One triangulation's slice of the merged mesh buffers, with disjoint
+// [vert_base, index_base) offsets so fills of distinct blocks never touch
+// the same slots.
+struct FaceMeshBlock {
+    Handle(Poly_Triangulation) tri;
+    TopLoc_Location            loc;
+    bool                       reversed   = false;
+    uint32_t                   vert_base  = 0;  // first vertex slot (per-vertex, not per-double)
+    size_t                     index_base = 0;  // first element in the index buffer
+};
+
+// Write one face's transformed nodes, indices, and normal contributions into
+// its slice of the (already sized) merged buffers.  Templated over the
+// vertex/normal scalar type so the same assembly code serves CG_MESH_F64
+// (Real = double) and CG_MESH_F32 (Real = float).  In the f32 case positions
+// are narrowed once at store time and normals are accumulated in float —
+// more than enough for render meshes.
+//
+// Normal accumulation only touches the face's own vertex slice (faces are not
+// welded), so concurrent calls on distinct blocks never race.
+template <typename Real>
+static void fill_face_block(std::vector<Real>&     vertices,
+                             std::vector<Real>&     normals,
+                             std::vector<uint32_t>& indices,
+                             const FaceMeshBlock&   blk)
 {
+    const Handle(Poly_Triangulation)& tri = blk.tri;
+    const TopLoc_Location&            loc = blk.loc;
+
     const int nNodes     = tri->NbNodes();
     const int nTriangles = tri->NbTriangles();
-
-    const uint32_t base = static_cast<uint32_t>(out.vertices.size() / 3);
-
-    // Reserve space.
-    out.vertices.resize(out.vertices.size() + nNodes * 3);
-    out.normals.resize(out.normals.size()   + nNodes * 3, 0.0);
-    out.indices.reserve(out.indices.size()  + nTriangles * 3);
+    const uint32_t base  = blk.vert_base;
+    // An empty normals vector means a lazy-normal mesh: skip accumulation.
+    const bool accumulate = !normals.empty();
 
     // Copy nodes (apply location transform to get world coordinates).
     for (int i = 1; i <= nNodes; ++i) {
@@ -125,9 +400,9 @@ static void append_triangulation(CgMeshData&                           out,
             p.Transform(loc.Transformation());
         }
         const uint32_t vi = base + static_cast<uint32_t>(i - 1);
-        out.vertices[vi * 3 + 0] = p.X();
-        out.vertices[vi * 3 + 1] = p.Y();
-        out.vertices[vi * 3 + 2] = p.Z();
+        vertices[vi * 3 + 0] = static_cast<Real>(p.X());
+        vertices[vi * 3 + 1] = static_cast<Real>(p.Y());
+        vertices[vi * 3 + 2] = static_cast<Real>(p.Z());
     }
 
     // Copy triangles; accumulate area-weighted face normals to vertex normals.
@@ -136,64 +411,344 @@ static void append_triangulation(CgMeshData&                           out,
         tri->Triangle(t).Get(n1, n2, n3);
 
         // Flip winding for reversed face orientation.
-        if (face_reversed) std::swap(n1, n2);
+        if (blk.reversed) std::swap(n1, n2);
 
-        // Push indices (0-based, offset by base).
-        out.indices.push_back(base + static_cast<uint32_t>(n1 - 1));
-        out.indices.push_back(base + static_cast<uint32_t>(n2 - 1));
-        out.indices.push_back(base + static_cast<uint32_t>(n3 - 1));
+        // Write indices (0-based, offset by base).
+        const size_t out_i = blk.index_base + static_cast<size_t>(t - 1) * 3;
+        indices[out_i + 0] = base + static_cast<uint32_t>(n1 - 1);
+        indices[out_i + 1] = base + static_cast<uint32_t>(n2 - 1);
+        indices[out_i + 2] = base + static_cast<uint32_t>(n3 - 1);
+
+        if (!accumulate) continue;
 
         // Compute face normal from cross product using already-transformed
         // world-space positions (avoids recomputing loc.Transformation()).
         const size_t i1 = (base + static_cast<uint32_t>(n1 - 1)) * 3;
         const size_t i2 = (base + static_cast<uint32_t>(n2 - 1)) * 3;
         const size_t i3 = (base + static_cast<uint32_t>(n3 - 1)) * 3;
-        gp_Vec e1(out.vertices[i2] - out.vertices[i1],
-                  out.vertices[i2+1] - out.vertices[i1+1],
-                  out.vertices[i2+2] - out.vertices[i1+2]);
-        gp_Vec e2(out.vertices[i3] - out.vertices[i1],
-                  out.vertices[i3+1] - out.vertices[i1+1],
-                  out.vertices[i3+2] - out.vertices[i1+2]);
+        gp_Vec e1(vertices[i2]   - vertices[i1],
+                  vertices[i2+1] - vertices[i1+1],
+                  vertices[i2+2] - vertices[i1+2]);
+        gp_Vec e2(vertices[i3]   - vertices[i1],
+                  vertices[i3+1] - vertices[i1+1],
+                  vertices[i3+2] - vertices[i1+2]);
         gp_Vec fn = e1.Crossed(e2); // area-weighted normal in world space
 
         // Accumulate to vertex normals (area weighting is implicit — longer
         // cross product = larger triangle = more weight).
         for (int vi : {n1, n2, n3}) {
             const uint32_t idx = (base + static_cast<uint32_t>(vi - 1)) * 3;
-            out.normals[idx + 0] += fn.X();
-            out.normals[idx + 1] += fn.Y();
-            out.normals[idx + 2] += fn.Z();
+            normals[idx + 0] += static_cast<Real>(fn.X());
+            normals[idx + 1] += static_cast<Real>(fn.Y());
+            normals[idx + 2] += static_cast<Real>(fn.Z());
         }
     }
 }
 
-// Normalize all vertex normals in out.  Called once after all faces are merged.
-static void normalize_normals(CgMeshData& out) {
-    const size_t nVerts = out.vertices.size() / 3;
+// Grow the buffers by one triangulation and fill it in place.  Serial
+// convenience wrapper used by cg_load_stl (single triangulation).
+template <typename Real>
+static void append_triangulation_t(std::vector<Real>&                 vertices,
+                                    std::vector<Real>&                 normals,
+                                    std::vector<uint32_t>&             indices,
+                                    const Handle(Poly_Triangulation)&  tri,
+                                    const TopLoc_Location&             loc,
+                                    bool                               face_reversed)
+{
+    FaceMeshBlock blk;
+    blk.tri        = tri;
+    blk.loc        = loc;
+    blk.reversed   = face_reversed;
+    blk.vert_base  = static_cast<uint32_t>(vertices.size() / 3);
+    blk.index_base = indices.size();
+
+    vertices.resize(vertices.size() + tri->NbNodes() * 3);
+    normals.resize(normals.size()   + tri->NbNodes() * 3, Real(0));
+    indices.resize(indices.size()   + tri->NbTriangles() * 3);
+
+    fill_face_block(vertices, normals, indices, blk);
+}
+
+// Dispatch on the mesh's storage precision.
+static void append_triangulation(CgMeshData&                           out,
+                                  const Handle(Poly_Triangulation)&      tri,
+                                  const TopLoc_Location&                 loc,
+                                  bool                                   face_reversed)
+{
+    if (out.precision == CG_MESH_F32) {
+        append_triangulation_t(out.vertices_f32, out.normals_f32, out.indices,
+                               tri, loc, face_reversed);
+    } else {
+        append_triangulation_t(out.vertices, out.normals, out.indices,
+                               tri, loc, face_reversed);
+    }
+}
+
+// Normalize all vertex normals.  Called once after all faces are merged.
+template <typename Real>
+static void normalize_normals_t(std::vector<Real>& normals) {
+    const size_t nVerts = normals.size() / 3;
     for (size_t i = 0; i < nVerts; ++i) {
-        double nx = out.normals[i * 3 + 0];
-        double ny = out.normals[i * 3 + 1];
-        double nz = out.normals[i * 3 + 2];
+        double nx = normals[i * 3 + 0];
+        double ny = normals[i * 3 + 1];
+        double nz = normals[i * 3 + 2];
         double len = std::sqrt(nx * nx + ny * ny + nz * nz);
         if (len > 1e-12) {
-            out.normals[i * 3 + 0] = nx / len;
-            out.normals[i * 3 + 1] = ny / len;
-            out.normals[i * 3 + 2] = nz / len;
+            normals[i * 3 + 0] = static_cast<Real>(nx / len);
+            normals[i * 3 + 1] = static_cast<Real>(ny / len);
+            normals[i * 3 + 2] = static_cast<Real>(nz / len);
         }
         // If len == 0 (degenerate triangle only), leave normal as zero vector.
     }
 }
 
-// ── Public C API ─────────────────────────────────────────────────────────────
+static void normalize_normals(CgMeshData& out) {
+    if (out.precision == CG_MESH_F32) {
+        normalize_normals_t(out.normals_f32);
+    } else {
+        normalize_normals_t(out.normals);
+    }
+}
 
-extern "C" {
+// Build smooth per-vertex normals from scratch for a lazy-normal mesh: a
+// parallel pass over triangles into a face-normal scratch buffer, one serial
+// scatter (triangles share vertices, so the adds cannot run concurrently),
+// and a parallel normalize.  Plain componentwise arithmetic throughout so
+// the compiler can vectorize the hot loops — unlike the per-triangle gp_Vec
+// accumulation the eager path inherits from assembly.
+template <typename Real>
+static void compute_vertex_normals(const std::vector<Real>&     vertices,
+                                    const std::vector<uint32_t>& indices,
+                                    std::vector<Real>&           normals)
+{
+    const size_t n_tris = indices.size() / 3;
+    normals.assign(vertices.size(), Real(0));
+
+    std::vector<double> face_n(n_tris * 3);
+    worker_pool::parallel_for(n_tris, 4096, [&](size_t t) {
+        const size_t i1 = size_t(indices[t * 3 + 0]) * 3;
+        const size_t i2 = size_t(indices[t * 3 + 1]) * 3;
+        const size_t i3 = size_t(indices[t * 3 + 2]) * 3;
+        const double e1x = double(vertices[i2 + 0]) - double(vertices[i1 + 0]);
+        const double e1y = double(vertices[i2 + 1]) - double(vertices[i1 + 1]);
+        const double e1z = double(vertices[i2 + 2]) - double(vertices[i1 + 2]);
+        const double e2x = double(vertices[i3 + 0]) - double(vertices[i1 + 0]);
+        const double e2y = double(vertices[i3 + 1]) - double(vertices[i1 + 1]);
+        const double e2z = double(vertices[i3 + 2]) - double(vertices[i1 + 2]);
+        // Area-weighted normal: longer cross product = larger triangle.
+        face_n[t * 3 + 0] = e1y * e2z - e1z * e2y;
+        face_n[t * 3 + 1] = e1z * e2x - e1x * e2z;
+        face_n[t * 3 + 2] = e1x * e2y - e1y * e2x;
+    });
+
+    for (size_t t = 0; t < n_tris; ++t) {
+        for (int c = 0; c < 3; ++c) {
+            const size_t vi = size_t(indices[t * 3 + c]) * 3;
+            normals[vi + 0] += static_cast<Real>(face_n[t * 3 + 0]);
+            normals[vi + 1] += static_cast<Real>(face_n[t * 3 + 1]);
+            normals[vi + 2] += static_cast<Real>(face_n[t * 3 + 2]);
+        }
+    }
+
+    const size_t n_verts = vertices.size() / 3;
+    worker_pool::parallel_for(n_verts, 8192, [&](size_t i) {
+        const double nx = double(normals[i * 3 + 0]);
+        const double ny = double(normals[i * 3 + 1]);
+        const double nz = double(normals[i * 3 + 2]);
+        const double len = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (len > 1e-12) {
+            normals[i * 3 + 0] = static_cast<Real>(nx / len);
+            normals[i * 3 + 1] = static_cast<Real>(ny / len);
+            normals[i * 3 + 2] = static_cast<Real>(nz / len);
+        }
+    });
+}
+
+// Materialize the normal buffer of a lazy-normal mesh.  Runs the build at
+// most once per mesh; concurrent first readers block on the once_flag and
+// all see the finished buffer.  Eagerly-built meshes fall straight through.
+static void mesh_ensure_normals(CgMeshData* mesh) {
+    if (mesh->backing) return;  // snapshot views always carry normals
+    std::call_once(mesh->normals_once, [mesh]() {
+        if (mesh->precision == CG_MESH_F32) {
+            if (mesh->normals_f32.empty() && !mesh->vertices_f32.empty())
+                compute_vertex_normals(mesh->vertices_f32, mesh->indices,
+                                       mesh->normals_f32);
+        } else {
+            if (mesh->normals.empty() && !mesh->vertices.empty())
+                compute_vertex_normals(mesh->vertices, mesh->indices,
+                                       mesh->normals);
+        }
+    });
+}
+
+// ── Tessellation fragment cache ──────────────────────────────────────────────
+// Finished per-face mesh fragments (world-space vertices + local indices)
+// keyed by the face's underlying TShape, its placement, orientation, and the
+// meshing tolerances, held in a memory-budgeted LRU.  Tessellating the same
+// shape again — or a healed copy that kept most of its faces — re-merges
+// cached fragments and only meshes the faces that actually changed; flipping
+// the viewport between coarse and fine display tolerance keeps both sets
+// resident.  Keying by TShape rather than shape handle is what makes the
+// cross-handle reuse work; the key holds a strong TShape handle so the
+// address can never be recycled while its entry lives, and eviction is the
+// only way fragments (and the B-rep memory they pin) are released.
+
+struct TessFragment {
+    std::vector<double>   vertices;  // world-space xyz triples
+    std::vector<uint32_t> indices;   // fragment-local, wound per orientation
+    size_t bytes() const {
+        return vertices.size() * sizeof(double) +
+               indices.size() * sizeof(uint32_t);
+    }
+};
+
+struct TessCacheKey {
+    Handle(TopoDS_TShape) tshape;  // strong ref: identity + keeps it alive
+    double trsf[12] = {};          // row-major 3×4 world placement
+    bool   reversed  = false;
+    double chord_tol = 0.0;
+    double angle_tol = 0.0;
+
+    bool operator==(const TessCacheKey& o) const {
+        if (tshape.get() != o.tshape.get() || reversed != o.reversed ||
+            chord_tol != o.chord_tol || angle_tol != o.angle_tol)
+            return false;
+        for (int i = 0; i < 12; ++i)
+            if (trsf[i] != o.trsf[i]) return false;
+        return true;
+    }
+};
+
+struct TessCacheKeyHash {
+    size_t operator()(const TessCacheKey& k) const {
+        // Same mixing spirit as mesh_weld::detail::cell_key.
+        uint64_t h = uint64_t(reinterpret_cast<uintptr_t>(k.tshape.get()));
+        auto mix = [&h](uint64_t v) {
+            h ^= v * 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        };
+        uint64_t bits;
+        for (double d : k.trsf) {
+            std::memcpy(&bits, &d, sizeof(bits));
+            mix(bits);
+        }
+        std::memcpy(&bits, &k.chord_tol, sizeof(bits));
+        mix(bits);
+        std::memcpy(&bits, &k.angle_tol, sizeof(bits));
+        mix(bits);
+        mix(k.reversed ? 0x165667b19e3779f9ULL : 0);
+        return size_t(h);
+    }
+};
+
+static TessCacheKey tess_cache_key(const TopoDS_Face& face,
+                                    double chord_tol, double angle_tol) {
+    TessCacheKey k;
+    k.tshape = face.TShape();
+    const TopLoc_Location& loc = face.Location();
+    if (loc.IsIdentity()) {
+        k.trsf[0] = k.trsf[5] = k.trsf[10] = 1.0;
+    } else {
+        const gp_Trsf& t = loc.Transformation();
+        for (int r = 1; r <= 3; ++r)
+            for (int c = 1; c <= 4; ++c)
+                k.trsf[(r - 1) * 4 + (c - 1)] = t.Value(r, c);
+    }
+    k.reversed  = (face.Orientation() == TopAbs_REVERSED);
+    k.chord_tol = chord_tol;
+    k.angle_tol = angle_tol;
+    return k;
+}
+
+struct TessCacheEntry {
+    std::shared_ptr<const TessFragment> frag;
+    std::list<TessCacheKey>::iterator   lru_it;
+};
+
+static constexpr size_t kTessCacheDefaultBudget = size_t(256) << 20;  // bytes
+
+static std::mutex               g_tess_cache_mutex;
+static std::list<TessCacheKey>  g_tess_cache_lru;  // front = most recent
+static std::unordered_map<TessCacheKey, TessCacheEntry, TessCacheKeyHash>
+    g_tess_cache;
+static size_t   g_tess_cache_bytes  = 0;
+static size_t   g_tess_cache_budget = kTessCacheDefaultBudget;
+static uint64_t g_tess_cache_hits   = 0;
+static uint64_t g_tess_cache_misses = 0;
+
+// Caller holds g_tess_cache_mutex.
+static void tess_cache_evict_over_budget() {
+    while (g_tess_cache_bytes > g_tess_cache_budget &&
+           !g_tess_cache_lru.empty()) {
+        auto vit = g_tess_cache.find(g_tess_cache_lru.back());
+        g_tess_cache_bytes -= vit->second.frag->bytes();
+        g_tess_cache.erase(vit);
+        g_tess_cache_lru.pop_back();
+    }
+}
 
-/* ── Error handling ──────────────────────────────────────────────────────── */
+static std::shared_ptr<const TessFragment>
+tess_cache_lookup(const TessCacheKey& key) {
+    std::lock_guard<std::mutex> lock(g_tess_cache_mutex);
+    auto it = g_tess_cache.find(key);
+    if (it == g_tess_cache.end()) {
+        ++g_tess_cache_misses;
+        return nullptr;
+    }
+    ++g_tess_cache_hits;
+    g_tess_cache_lru.splice(g_tess_cache_lru.begin(), g_tess_cache_lru,
+                            it->second.lru_it);
+    return it->second.frag;
+}
+
+static void tess_cache_insert(const TessCacheKey&                 key,
+                               std::shared_ptr<const TessFragment> frag) {
+    std::lock_guard<std::mutex> lock(g_tess_cache_mutex);
+    if (g_tess_cache_budget == 0) return;
+    if (g_tess_cache.count(key)) return;  // a racing builder published first
+    g_tess_cache_bytes += frag->bytes();
+    g_tess_cache_lru.push_front(key);
+    g_tess_cache.emplace(
+        key, TessCacheEntry{std::move(frag), g_tess_cache_lru.begin()});
+    tess_cache_evict_over_budget();
+}
 
-const char* cg_last_error_message(void) {
-    return g_last_error.c_str();
+// Build one face's fragment from its triangulation: nodes transformed to
+// world space, indices fragment-local, winding flipped for reversed faces.
+// fill_face_block minus the normal accumulation, into local buffers.
+static std::shared_ptr<const TessFragment>
+tess_fragment_build(const Handle(Poly_Triangulation)& tri,
+                    const TopLoc_Location& loc, bool reversed) {
+    auto frag = std::make_shared<TessFragment>();
+    const int nNodes = tri->NbNodes();
+    const int nTris  = tri->NbTriangles();
+    frag->vertices.resize(size_t(nNodes) * 3);
+    frag->indices.resize(size_t(nTris) * 3);
+
+    for (int i = 1; i <= nNodes; ++i) {
+        gp_Pnt p = tri->Node(i);
+        if (!loc.IsIdentity()) p.Transform(loc.Transformation());
+        frag->vertices[size_t(i - 1) * 3 + 0] = p.X();
+        frag->vertices[size_t(i - 1) * 3 + 1] = p.Y();
+        frag->vertices[size_t(i - 1) * 3 + 2] = p.Z();
+    }
+    for (int t = 1; t <= nTris; ++t) {
+        int n1, n2, n3;
+        tri->Triangle(t).Get(n1, n2, n3);
+        if (reversed) std::swap(n1, n2);
+        frag->indices[size_t(t - 1) * 3 + 0] = uint32_t(n1 - 1);
+        frag->indices[size_t(t - 1) * 3 + 1] = uint32_t(n2 - 1);
+        frag->indices[size_t(t - 1) * 3 + 2] = uint32_t(n3 - 1);
+    }
+    return frag;
 }
 
+// ── Public C API ─────────────────────────────────────────────────────────────
+
+extern "C" {
+
+/* cg_last_error_message() is defined in cam_error.cpp. */
+
 /* ── Shape import ────────────────────────────────────────────────────────── */
 
 // OCCT's STEP protocol initialisation is not thread-safe: the global schema
@@ -202,33 +757,225 @@ const char* cg_last_error_message(void) {
 // exceptions.  Serialise all STEP reads with this mutex.
 static std::mutex g_step_mutex;
 
-CgShapeId cg_load_step(const char* path) {
-    if (!path) {
-        set_last_error("cg_load_step: null path");
-        return CG_NULL_ID;
+// ── Binary shape cache ──────────────────────────────────────────────────────
+// Sidecar cache of healed shapes in OCCT's binary BRep format, keyed by a
+// content hash of the source file.  A cache hit replaces the STEP parse and
+// ShapeFix pass (minutes on large assemblies) with one BinTools read — and
+// runs outside g_step_mutex, since the binary reader does not touch the STEP
+// schema registry.
+
+static std::mutex  g_shape_cache_mutex;
+static std::string g_shape_cache_dir;  // empty = caching disabled
+
+// Streamed FNV-1a 64-bit hash of a file's contents.
+// Returns false if the file cannot be read.
+static bool hash_file_contents(const char* path, uint64_t& out_hash) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    uint64_t hash = 14695981039346656037ull;
+    char buf[65536];
+    while (in.read(buf, sizeof(buf)) || in.gcount() > 0) {
+        const std::streamsize n = in.gcount();
+        for (std::streamsize i = 0; i < n; ++i) {
+            hash ^= static_cast<unsigned char>(buf[i]);
+            hash *= 1099511628211ull;
+        }
     }
-    std::lock_guard<std::mutex> lock(g_step_mutex);
-    try {
+    out_hash = hash;
+    return true;
+}
+
+// "<dir>/<hash hex>.bbrep", or empty when caching is disabled or the source
+// file is unreadable.
+static std::string shape_cache_path_for(const char* source_path) {
+    std::string dir;
+    {
+        std::lock_guard<std::mutex> lock(g_shape_cache_mutex);
+        dir = g_shape_cache_dir;
+    }
+    if (dir.empty()) return {};
+    uint64_t hash = 0;
+    if (!hash_file_contents(source_path, hash)) return {};
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bbrep",
+                  static_cast<unsigned long long>(hash));
+    return dir + "/" + name;
+}
+
+CgError cg_shape_cache_set_dir(const char* dir) {
+    std::lock_guard<std::mutex> lock(g_shape_cache_mutex);
+    g_shape_cache_dir = dir ? dir : "";
+    return CG_OK;
+}
+
+// ── Shape healing pipeline ──────────────────────────────────────────────────
+
+// Healing level applied by cg_shape_heal() and the import pipeline.
+static std::atomic<int> g_heal_level{CG_HEAL_FULL};
+
+// Heal one shape at the given level.  ShapeFix_Shape instances share no
+// mutable state, so distinct shapes can be fixed concurrently.
+static TopoDS_Shape heal_one_shape(const TopoDS_Shape& shape, int level) {
+    ShapeFix_Shape fixer(shape);
+    if (level == CG_HEAL_BASIC) {
+        // The same-parameter recomputation dominates ShapeFix wall time on
+        // clean files; BASIC keeps the structural fixes and skips it.
+        fixer.FixSameParameterMode() = 0;
+    }
+    fixer.Perform();
+    return fixer.Shape();
+}
+
+// Heal a shape, exploding compounds so each top-level sub-shape (solid or
+// shell) runs through ShapeFix on its own worker.  Workers pull indices from
+// a shared atomic cursor so a few slow children don't serialize behind one
+// thread; results keep the compound's original child order.
+static TopoDS_Shape heal_shape_parallel(const TopoDS_Shape& raw, int level) {
+    if (level == CG_HEAL_NONE) return raw;
+    if (raw.ShapeType() != TopAbs_COMPOUND) return heal_one_shape(raw, level);
+
+    std::vector<TopoDS_Shape> children;
+    for (TopoDS_Iterator it(raw); it.More(); it.Next())
+        children.push_back(it.Value());
+    if (children.size() <= 1) return heal_one_shape(raw, level);
+
+    std::vector<TopoDS_Shape> healed(children.size());
+    const size_t n = children.size();
+
+    const size_t n_workers = std::min(worker_pool::effective(), n);
+    if (n_workers > 1) worker_pool::note_batch(n);
+
+    std::atomic<size_t> cursor{0};
+    std::mutex          err_mutex;
+    std::string         first_error;
+
+    auto worker = [&]() {
+        try {
+            for (size_t i = cursor.fetch_add(1, std::memory_order_relaxed);
+                 i < n;
+                 i = cursor.fetch_add(1, std::memory_order_relaxed)) {
+                healed[i] = heal_one_shape(children[i], level);
+            }
+        } catch (const Standard_Failure& ex) {
+            std::lock_guard<std::mutex> lock(err_mutex);
+            if (first_error.empty())
+                first_error = std::string("OCCT exception in healing: ") +
+                              ex.GetMessageString();
+        } catch (const std::exception& ex) {
+            std::lock_guard<std::mutex> lock(err_mutex);
+            if (first_error.empty()) first_error = ex.what();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(err_mutex);
+            if (first_error.empty()) first_error = "unknown exception in healing";
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_workers - 1);
+    for (size_t w = 0; w + 1 < n_workers; ++w) threads.emplace_back(worker);
+    worker();  // the calling thread participates
+    for (auto& t : threads) t.join();
+
+    if (!first_error.empty()) throw std::runtime_error(first_error);
+
+    TopoDS_Compound out;
+    BRep_Builder    builder;
+    builder.MakeCompound(out);
+    for (const TopoDS_Shape& child : healed) builder.Add(out, child);
+    return out;
+}
+
+// Outcome of one import attempt (shared by the sync and async paths).
+enum class StepImportOutcome { Ok, Failed, Cancelled };
+
+// Full STEP import pipeline: cache probe, read + transfer (under the STEP
+// mutex), heal, cache write.  Only the schema-registry window — ReadFile and
+// TransferRoots — holds g_step_mutex; healing and cache I/O run unlocked so
+// concurrent kernel work is not stalled behind them.
+//
+// progress/cancel are optional hooks for the async path: progress advances at
+// phase boundaries, and cancellation is honoured between phases (OCCT's
+// reader calls are not interruptible mid-call).  May throw OCCT or standard
+// exceptions; callers translate.
+static StepImportOutcome import_step_shape(const char*          path,
+                                           TopoDS_Shape&        out_shape,
+                                           std::string&         out_error,
+                                           std::atomic<double>* progress,
+                                           const std::atomic<bool>* cancel)
+{
+    auto report = [&](double p) {
+        if (progress) progress->store(p, std::memory_order_relaxed);
+    };
+    auto cancelled = [&]() {
+        return cancel && cancel->load(std::memory_order_relaxed);
+    };
+
+    // Cache hit: load the previously healed shape directly.  A failed or
+    // truncated sidecar falls through to the full import below, which
+    // rewrites it.
+    const std::string cache_path = shape_cache_path_for(path);
+    if (!cache_path.empty()) {
+        TopoDS_Shape cached;
+        if (BinTools::Read(cached, cache_path.c_str()) && !cached.IsNull()) {
+            out_shape = cached;
+            report(1.0);
+            return StepImportOutcome::Ok;
+        }
+    }
+    report(0.05);
+    if (cancelled()) return StepImportOutcome::Cancelled;
+
+    TopoDS_Shape raw;
+    {
+        std::lock_guard<std::mutex> lock(g_step_mutex);
         STEPControl_Reader reader;
         IFSelect_ReturnStatus status = reader.ReadFile(path);
         if (status != IFSelect_RetDone) {
-            set_last_error(std::string("STEP: failed to read '") + path + "'");
-            return CG_NULL_ID;
+            out_error = std::string("STEP: failed to read '") + path + "'";
+            return StepImportOutcome::Failed;
         }
+        report(0.4);
+        if (cancelled()) return StepImportOutcome::Cancelled;
         Standard_Integer nRoots = reader.TransferRoots();
         if (nRoots == 0) {
-            set_last_error("STEP: no transferable roots found");
-            return CG_NULL_ID;
+            out_error = "STEP: no transferable roots found";
+            return StepImportOutcome::Failed;
         }
-        TopoDS_Shape raw = reader.OneShape();
-
-        // Always attempt healing — real-world STEP files often have tolerance
-        // violations or gap issues that cause downstream algorithms to fail.
-        ShapeFix_Shape fixer(raw);
-        fixer.Perform();
-        TopoDS_Shape healed = fixer.Shape();
+        raw = reader.OneShape();
+    }
+    report(0.7);
+    if (cancelled()) return StepImportOutcome::Cancelled;
+
+    // Always attempt healing — real-world STEP files often have tolerance
+    // violations or gap issues that cause downstream algorithms to fail.
+    // Multi-solid assemblies heal one sub-shape per worker.
+    out_shape = heal_shape_parallel(raw, g_heal_level.load(std::memory_order_relaxed));
+    report(0.95);
+
+    // Best-effort cache write; an import that cannot be cached still
+    // succeeds, and a partial write self-heals via the fallback above.
+    if (!cache_path.empty())
+        (void)BinTools::Write(out_shape, cache_path.c_str());
+
+    report(1.0);
+    return StepImportOutcome::Ok;
+}
 
-        return registry_store_shape(healed);
+CgShapeId cg_load_step(const char* path) {
+    if (!path) {
+        set_last_error("cg_load_step: null path");
+        return CG_NULL_ID;
+    }
+    perf_counters::Scope perf(perf_counters::kImport);
+    try {
+        TopoDS_Shape shape;
+        std::string  error;
+        if (import_step_shape(path, shape, error, nullptr, nullptr) !=
+            StepImportOutcome::Ok) {
+            set_last_error(error);
+            return CG_NULL_ID;
+        }
+        return registry_store_shape(shape);
     } catch (const Standard_Failure& ex) {
         set_last_error(std::string("STEP exception: ") + ex.GetMessageString());
         return CG_NULL_ID;
@@ -249,23 +996,223 @@ CgShapeId cg_load_iges(const char* /*path*/) {
     return CG_NULL_ID;
 }
 
+/* ── Asynchronous import ─────────────────────────────────────────────────── */
+
+// One in-flight import.  The worker communicates through atomics; the error
+// string is written by the worker before the (release) status store and only
+// read after an (acquire) load sees a terminal status.
+struct CgJobData {
+    std::thread           worker;
+    std::atomic<int>      status{CG_JOB_RUNNING};
+    std::atomic<double>   progress{0.0};
+    std::atomic<bool>     cancel{false};
+    std::atomic<uint64_t> shape_id{CG_NULL_ID};
+    std::atomic<bool>     shape_taken{false};
+    std::string           error;
+
+    ~CgJobData() {
+        // Safety net for handles leaked without cg_job_free: a joinable
+        // thread reaching ~thread() would terminate the process.
+        cancel.store(true, std::memory_order_relaxed);
+        if (worker.joinable()) worker.join();
+    }
+};
+
+static std::shared_mutex                                        g_job_mutex;
+static std::unordered_map<uint64_t, std::shared_ptr<CgJobData>> g_job_store;
+static std::atomic<uint64_t>                                    g_job_next_id{1};
+
+static std::shared_ptr<CgJobData> job_store_get(uint64_t id) {
+    std::shared_lock<std::shared_mutex> lock(g_job_mutex);
+    auto it = g_job_store.find(id);
+    if (it == g_job_store.end()) return nullptr;
+    return it->second;
+}
+
+CgJobId cg_load_step_async(const char* path) {
+    if (!path) {
+        set_last_error("cg_load_step_async: null path");
+        return CG_NULL_ID;
+    }
+    try {
+        auto job = std::make_shared<CgJobData>();
+        uint64_t id = g_job_next_id.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::unique_lock<std::shared_mutex> lock(g_job_mutex);
+            g_job_store.emplace(id, job);
+        }
+        std::string path_copy(path);
+        job->worker = std::thread([job, path_copy]() {
+            try {
+                TopoDS_Shape shape;
+                std::string  error;
+                switch (import_step_shape(path_copy.c_str(), shape, error,
+                                          &job->progress, &job->cancel)) {
+                    case StepImportOutcome::Ok:
+                        job->shape_id.store(registry_store_shape(shape),
+                                            std::memory_order_relaxed);
+                        job->status.store(CG_JOB_DONE, std::memory_order_release);
+                        break;
+                    case StepImportOutcome::Cancelled:
+                        job->status.store(CG_JOB_CANCELLED,
+                                          std::memory_order_release);
+                        break;
+                    case StepImportOutcome::Failed:
+                        job->error = std::move(error);
+                        job->status.store(CG_JOB_FAILED,
+                                          std::memory_order_release);
+                        break;
+                }
+            } catch (const Standard_Failure& ex) {
+                job->error = std::string("STEP exception: ") +
+                             ex.GetMessageString();
+                job->status.store(CG_JOB_FAILED, std::memory_order_release);
+            } catch (const std::exception& ex) {
+                job->error = std::string("STEP std::exception: ") + ex.what();
+                job->status.store(CG_JOB_FAILED, std::memory_order_release);
+            } catch (...) {
+                job->error = "STEP: unknown exception";
+                job->status.store(CG_JOB_FAILED, std::memory_order_release);
+            }
+        });
+        return id;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_load_step_async std::exception: ") +
+                       ex.what());
+        return CG_NULL_ID;
+    }
+}
+
+CgJobStatus cg_job_status(CgJobId id) {
+    auto job = job_store_get(id);
+    if (!job) {
+        set_last_error("cg_job_status: invalid job ID");
+        return CG_JOB_FAILED;
+    }
+    return static_cast<CgJobStatus>(job->status.load(std::memory_order_acquire));
+}
+
+double cg_job_progress(CgJobId id) {
+    auto job = job_store_get(id);
+    if (!job) return 0.0;
+    return job->progress.load(std::memory_order_relaxed);
+}
+
+CgError cg_job_cancel(CgJobId id) {
+    auto job = job_store_get(id);
+    if (!job) {
+        set_last_error("cg_job_cancel: invalid job ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    job->cancel.store(true, std::memory_order_relaxed);
+    return CG_OK;
+}
+
+CgShapeId cg_job_shape(CgJobId id) {
+    auto job = job_store_get(id);
+    if (!job) {
+        set_last_error("cg_job_shape: invalid job ID");
+        return CG_NULL_ID;
+    }
+    const int status = job->status.load(std::memory_order_acquire);
+    if (status != CG_JOB_DONE) {
+        if (status == CG_JOB_FAILED)
+            set_last_error(job->error);
+        else
+            set_last_error("cg_job_shape: job has not completed");
+        return CG_NULL_ID;
+    }
+    job->shape_taken.store(true, std::memory_order_relaxed);
+    return job->shape_id.load(std::memory_order_relaxed);
+}
+
+void cg_job_free(CgJobId id) {
+    if (id == CG_NULL_ID) return;
+    std::shared_ptr<CgJobData> job;
+    {
+        std::unique_lock<std::shared_mutex> lock(g_job_mutex);
+        auto it = g_job_store.find(id);
+        if (it == g_job_store.end()) return;
+        job = std::move(it->second);
+        g_job_store.erase(it);
+    }
+    if (job->worker.joinable()) job->worker.join();
+    // Release an orphaned result so a fire-and-forget job cannot leak the
+    // imported shape.
+    if (!job->shape_taken.load(std::memory_order_relaxed)) {
+        const uint64_t shape = job->shape_id.load(std::memory_order_relaxed);
+        if (shape != CG_NULL_ID) registry_free_shape(shape);
+    }
+}
+
 CgMeshId cg_load_stl(const char* path) {
+    return cg_load_stl_ex(path, CG_MESH_F64, /*weld_tol=*/0.0);
+}
+
+CgMeshId cg_load_stl_ex(const char* path, CgMeshPrecision precision,
+                        double weld_tol) {
     if (!path) {
         set_last_error("cg_load_stl: null path");
         return CG_NULL_ID;
     }
+    if (precision != CG_MESH_F64 && precision != CG_MESH_F32) {
+        set_last_error("cg_load_stl: invalid precision");
+        return CG_NULL_ID;
+    }
+    if (weld_tol < 0.0 || !std::isfinite(weld_tol)) {
+        set_last_error("cg_load_stl: invalid weld tolerance");
+        return CG_NULL_ID;
+    }
+    perf_counters::Scope perf(perf_counters::kImport);
     try {
-        Handle(Poly_Triangulation) tri = RWStl::ReadFile(path);
-        if (tri.IsNull()) {
-            set_last_error(std::string("STL: failed to read '") + path + "'");
-            return CG_NULL_ID;
+        auto data = std::make_shared<CgMeshData>();
+        data->precision = precision;
+
+        // Fast path: memory-map the file and parse the fixed-size binary
+        // records in parallel, straight into the final buffer layout.
+        // ASCII files (and binaries whose declared count does not match the
+        // file size) fall through to RWStl below.
+        stl_import::FileMapping map;
+        uint32_t n_tris = 0;
+        if (map.open(path) &&
+            stl_import::binary_triangle_count(map.data(), map.size(), n_tris)) {
+            if (precision == CG_MESH_F32) {
+                stl_import::parse_binary(map.data(), n_tris,
+                                         data->vertices_f32,
+                                         data->normals_f32, data->indices,
+                                         worker_pool::effective());
+            } else {
+                stl_import::parse_binary(map.data(), n_tris, data->vertices,
+                                         data->normals, data->indices,
+                                         worker_pool::effective());
+            }
+        } else {
+            map.close();
+            Handle(Poly_Triangulation) tri = RWStl::ReadFile(path);
+            if (tri.IsNull()) {
+                set_last_error(std::string("STL: failed to read '") + path +
+                               "'");
+                return CG_NULL_ID;
+            }
+            TopLoc_Location identity; // STL carries no face location
+            append_triangulation(*data, tri, identity,
+                                 /*face_reversed=*/false);
         }
 
-        auto data = std::make_shared<CgMeshData>();
-        TopLoc_Location identity; // identity transform for STL (no face location)
-        append_triangulation(*data, tri, identity, /*face_reversed=*/false);
+        // Same optional welding as tessellation: merge seam duplicates and
+        // their accumulated normals before normalizing.
+        if (weld_tol > 0.0) {
+            if (precision == CG_MESH_F32) {
+                mesh_weld::weld(data->vertices_f32, data->normals_f32,
+                                data->indices, weld_tol);
+            } else {
+                mesh_weld::weld(data->vertices, data->normals,
+                                data->indices, weld_tol);
+            }
+        }
         normalize_normals(*data);
 
+        perf.add_bytes(data->buffer_bytes());
         return mesh_store_insert(std::move(data));
     } catch (const Standard_Failure& ex) {
         set_last_error(std::string("STL exception: ") + ex.GetMessageString());
@@ -279,16 +1226,51 @@ CgMeshId cg_load_stl(const char* path) {
     }
 }
 
+// Defined with the distance-query and feature-detection machinery below.
+static void distance_bvh_invalidate(uint64_t id);
+static void face_table_invalidate(uint64_t id);
+
 void cg_shape_free(CgShapeId id) {
     if (id == CG_NULL_ID) return;
+    distance_bvh_invalidate(id);
+    face_table_invalidate(id);
     registry_free_shape(id);
 }
 
 /* ── Shape healing ───────────────────────────────────────────────────────── */
 
-CgShapeId cg_shape_heal(CgShapeId /*id*/) {
-    set_last_error("not implemented");
-    return CG_NULL_ID;
+CgError cg_shape_heal_set_level(CgHealLevel level) {
+    if (level != CG_HEAL_NONE && level != CG_HEAL_BASIC && level != CG_HEAL_FULL) {
+        set_last_error("cg_shape_heal_set_level: invalid level");
+        return CG_ERR_INVALID_ARG;
+    }
+    g_heal_level.store(level, std::memory_order_relaxed);
+    return CG_OK;
+}
+
+CgShapeId cg_shape_heal(CgShapeId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_shape_heal: null handle");
+        return CG_NULL_ID;
+    }
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        TopoDS_Shape healed =
+            heal_shape_parallel(shape, g_heal_level.load(std::memory_order_relaxed));
+        return registry_store_shape(healed);
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_shape_heal: invalid shape ID");
+        return CG_NULL_ID;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Heal exception: ") + ex.GetMessageString());
+        return CG_NULL_ID;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Heal std::exception: ") + ex.what());
+        return CG_NULL_ID;
+    } catch (...) {
+        set_last_error("Heal: unknown exception");
+        return CG_NULL_ID;
+    }
 }
 
 /* ── Shape topology traversal ────────────────────────────────────────────── */
@@ -322,65 +1304,234 @@ CgBbox cg_shape_bounding_box(CgShapeId id) {
     }
 }
 
-size_t cg_shape_faces(CgShapeId /*id*/, CgFaceId* /*out_faces*/, size_t /*capacity*/) {
-    set_last_error("not implemented");
-    return 0;
-}
-
-size_t cg_shape_edges(CgShapeId /*id*/, CgEdgeId* /*out_edges*/, size_t /*capacity*/) {
-    set_last_error("not implemented");
-    return 0;
+size_t cg_shape_faces(CgShapeId id, CgFaceId* out_faces, size_t capacity) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_shape_faces: null handle");
+        return 0;
+    }
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        size_t count = 0;
+        for (TopExp_Explorer exp(shape, TopAbs_FACE); exp.More(); exp.Next()) {
+            if (out_faces && count < capacity)
+                out_faces[count] = registry_store_shape(exp.Current());
+            ++count;
+        }
+        return count;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_shape_faces: invalid shape ID");
+        return 0;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Faces exception: ") + ex.GetMessageString());
+        return 0;
+    } catch (...) {
+        set_last_error("Faces: unknown exception");
+        return 0;
+    }
+}
+
+size_t cg_shape_edges(CgShapeId id, CgEdgeId* out_edges, size_t capacity) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_shape_edges: null handle");
+        return 0;
+    }
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        // Unlike faces, every edge is shared by its bordering faces and an
+        // explorer revisits shared sub-shapes; map to unique edges first.
+        TopTools_IndexedMapOfShape edges;
+        TopExp::MapShapes(shape, TopAbs_EDGE, edges);
+        const size_t count = size_t(edges.Extent());
+        if (out_edges) {
+            const size_t n = std::min(count, capacity);
+            for (size_t i = 0; i < n; ++i)
+                out_edges[i] = registry_store_shape(edges(int(i) + 1));
+        }
+        return count;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_shape_edges: invalid shape ID");
+        return 0;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Edges exception: ") + ex.GetMessageString());
+        return 0;
+    } catch (...) {
+        set_last_error("Edges: unknown exception");
+        return 0;
+    }
 }
 
 void cg_face_free(CgFaceId id) {
     if (id == CG_NULL_ID) return;
+    distance_bvh_invalidate(id);
     registry_free_shape(id);
 }
 
 void cg_edge_free(CgEdgeId id) {
     if (id == CG_NULL_ID) return;
+    distance_bvh_invalidate(id);
     registry_free_shape(id);
 }
 
 /* ── Tessellation ────────────────────────────────────────────────────────── */
 
 CgMeshId cg_shape_tessellate(CgShapeId id, double chord_tol, double angle_tol) {
+    return cg_shape_tessellate_ex(id, chord_tol, angle_tol, CG_MESH_F64);
+}
+
+CgMeshId cg_shape_tessellate_ex(CgShapeId id, double chord_tol,
+                                 double angle_tol, CgMeshPrecision precision) {
+    return cg_shape_tessellate_welded(id, chord_tol, angle_tol, precision,
+                                      /*weld_tol=*/0.0);
+}
+
+CgMeshId cg_shape_tessellate_welded(CgShapeId id, double chord_tol,
+                                    double angle_tol,
+                                    CgMeshPrecision precision,
+                                    double weld_tol) {
+    return cg_shape_tessellate_welded_ex(id, chord_tol, angle_tol, precision,
+                                         weld_tol, CG_NORMALS_LAZY);
+}
+
+CgMeshId cg_shape_tessellate_welded_ex(CgShapeId id, double chord_tol,
+                                       double angle_tol,
+                                       CgMeshPrecision precision,
+                                       double weld_tol,
+                                       CgNormalMode normal_mode) {
     if (id == CG_NULL_ID) {
         set_last_error("cg_shape_tessellate: null handle");
         return CG_NULL_ID;
     }
+    if (weld_tol < 0.0 || !std::isfinite(weld_tol)) {
+        set_last_error("cg_shape_tessellate: invalid weld tolerance");
+        return CG_NULL_ID;
+    }
+    if (precision != CG_MESH_F64 && precision != CG_MESH_F32) {
+        set_last_error("cg_shape_tessellate: invalid precision");
+        return CG_NULL_ID;
+    }
+    if (normal_mode != CG_NORMALS_LAZY && normal_mode != CG_NORMALS_EAGER) {
+        set_last_error("cg_shape_tessellate: invalid normal mode");
+        return CG_NULL_ID;
+    }
+    perf_counters::Scope perf(perf_counters::kTessellate);
     try {
         const TopoDS_Shape& shape = registry_get_shape(id);
 
-        // Mesh the shape (stores triangulations inside the shape's topology).
-        BRepMesh_IncrementalMesh mesher(shape, chord_tol,
-                                        /*isRelative=*/Standard_False,
-                                        angle_tol,
-                                        /*isParallel=*/Standard_True);
-        if (!mesher.IsDone()) {
-            set_last_error("cg_shape_tessellate: mesher did not complete");
-            return CG_NULL_ID;
+        // Probe the fragment cache face by face; only the misses pay for
+        // meshing and extraction below.
+        struct FacePlan {
+            TopoDS_Face                         face;
+            TessCacheKey                        key;
+            std::shared_ptr<const TessFragment> frag;
+        };
+        std::vector<FacePlan> plans;
+        bool any_miss = false;
+        for (TopExp_Explorer ex(shape, TopAbs_FACE); ex.More(); ex.Next()) {
+            FacePlan p;
+            p.face = TopoDS::Face(ex.Current());
+            p.key  = tess_cache_key(p.face, chord_tol, angle_tol);
+            p.frag = tess_cache_lookup(p.key);
+            if (!p.frag) any_miss = true;
+            plans.push_back(std::move(p));
         }
 
-        auto data = std::make_shared<CgMeshData>();
-
-        // Iterate over all faces and merge their triangulations.
-        for (TopExp_Explorer ex(shape, TopAbs_FACE); ex.More(); ex.Next()) {
-            const TopoDS_Face& face = TopoDS::Face(ex.Current());
-            TopLoc_Location loc;
-            Handle(Poly_Triangulation) tri = BRep_Tool::Triangulation(face, loc);
-            if (tri.IsNull()) continue; // face not meshed (degenerate)
+        if (any_miss) {
+            // Mesh the shape (stores triangulations inside the topology;
+            // faces that already carry a compliant triangulation are kept).
+            BRepMesh_IncrementalMesh mesher(
+                shape, chord_tol,
+                /*isRelative=*/Standard_False, angle_tol,
+                /*isParallel=*/worker_pool::effective() > 1);
+            if (!mesher.IsDone()) {
+                set_last_error("cg_shape_tessellate: mesher did not complete");
+                return CG_NULL_ID;
+            }
+
+            // Extract the missing fragments in parallel and publish them.
+            worker_pool::parallel_for(plans.size(), 1, [&](size_t i) {
+                FacePlan& p = plans[i];
+                if (p.frag) return;
+                TopLoc_Location loc;
+                Handle(Poly_Triangulation) tri =
+                    BRep_Tool::Triangulation(p.face, loc);
+                if (tri.IsNull()) return;  // face not meshed (degenerate)
+                p.frag = tess_fragment_build(
+                    tri, loc, p.face.Orientation() == TopAbs_REVERSED);
+                tess_cache_insert(p.key, p.frag);
+            });
+        }
 
-            const bool reversed = (face.Orientation() == TopAbs_REVERSED);
-            append_triangulation(*data, tri, loc, reversed);
+        // Sizing pass: disjoint offsets per fragment, so the merge below can
+        // run in parallel without resize/reserve churn.
+        std::vector<size_t> vert_base(plans.size()), index_base(plans.size());
+        size_t total_nodes = 0;
+        size_t total_tris  = 0;
+        for (size_t i = 0; i < plans.size(); ++i) {
+            vert_base[i]  = total_nodes;
+            index_base[i] = total_tris * 3;
+            if (!plans[i].frag) continue;
+            total_nodes += plans[i].frag->vertices.size() / 3;
+            total_tris  += plans[i].frag->indices.size() / 3;
         }
 
-        if (data->indices.empty()) {
+        if (total_tris == 0) {
             set_last_error("cg_shape_tessellate: no triangles produced");
             return CG_NULL_ID;
         }
 
-        normalize_normals(*data);
+        auto data = std::make_shared<CgMeshData>();
+        data->precision = precision;
+        if (precision == CG_MESH_F32)
+            data->vertices_f32.resize(total_nodes * 3);
+        else
+            data->vertices.resize(total_nodes * 3);
+        data->indices.resize(total_tris * 3);
+
+        // Merge pass: each worker copies its fragments' disjoint slices,
+        // narrowing to f32 at store time for render meshes.
+        worker_pool::parallel_for(plans.size(), 1, [&](size_t i) {
+            if (!plans[i].frag) return;
+            const TessFragment& frag = *plans[i].frag;
+            const size_t vb = vert_base[i];
+            if (precision == CG_MESH_F32) {
+                for (size_t j = 0; j < frag.vertices.size(); ++j)
+                    data->vertices_f32[vb * 3 + j] =
+                        static_cast<float>(frag.vertices[j]);
+            } else {
+                std::memcpy(data->vertices.data() + vb * 3,
+                            frag.vertices.data(),
+                            frag.vertices.size() * sizeof(double));
+            }
+            const uint32_t base = static_cast<uint32_t>(vb);
+            for (size_t j = 0; j < frag.indices.size(); ++j)
+                data->indices[index_base[i] + j] = base + frag.indices[j];
+        });
+
+        // Weld before any normal build so seam duplicates merge and a
+        // subsequent build smooths across face edges (the merged vertex
+        // collects every incident triangle's contribution).
+        if (weld_tol > 0.0) {
+            if (precision == CG_MESH_F32) {
+                mesh_weld::weld(data->vertices_f32, data->normals_f32,
+                                data->indices, weld_tol);
+            } else {
+                mesh_weld::weld(data->vertices, data->normals,
+                                data->indices, weld_tol);
+            }
+        }
+
+        // Fragments carry no normals, so the eager mode runs the same build
+        // the first lazy access would.
+        if (normal_mode == CG_NORMALS_EAGER) {
+            if (precision == CG_MESH_F32)
+                compute_vertex_normals(data->vertices_f32, data->indices,
+                                       data->normals_f32);
+            else
+                compute_vertex_normals(data->vertices, data->indices,
+                                       data->normals);
+        }
+
+        perf.add_bytes(data->buffer_bytes());
         return mesh_store_insert(std::move(data));
 
     } catch (const std::out_of_range&) {
@@ -389,24 +1540,60 @@ CgMeshId cg_shape_tessellate(CgShapeId id, double chord_tol, double angle_tol) {
     } catch (const Standard_Failure& ex) {
         set_last_error(std::string("Tessellate exception: ") + ex.GetMessageString());
         return CG_NULL_ID;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Tessellate std::exception: ") + ex.what());
+        return CG_NULL_ID;
     } catch (...) {
         set_last_error("Tessellate: unknown exception");
         return CG_NULL_ID;
     }
 }
 
+CgError cg_tess_cache_set_budget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(g_tess_cache_mutex);
+    g_tess_cache_budget = bytes;
+    tess_cache_evict_over_budget();
+    return CG_OK;
+}
+
+CgError cg_tess_cache_stats(size_t* out_entries, size_t* out_bytes,
+                            uint64_t* out_hits, uint64_t* out_misses) {
+    std::lock_guard<std::mutex> lock(g_tess_cache_mutex);
+    if (out_entries) *out_entries = g_tess_cache.size();
+    if (out_bytes)   *out_bytes   = g_tess_cache_bytes;
+    if (out_hits)    *out_hits    = g_tess_cache_hits;
+    if (out_misses)  *out_misses  = g_tess_cache_misses;
+    return CG_OK;
+}
+
+void cg_tess_cache_clear(void) {
+    std::lock_guard<std::mutex> lock(g_tess_cache_mutex);
+    g_tess_cache.clear();
+    g_tess_cache_lru.clear();
+    g_tess_cache_bytes  = 0;
+    g_tess_cache_hits   = 0;
+    g_tess_cache_misses = 0;
+}
+
+CgMeshPrecision cg_mesh_precision(CgMeshId id) {
+    if (id == CG_NULL_ID) return CG_MESH_F64;
+    auto mesh = mesh_store_get(id);
+    if (!mesh) return CG_MESH_F64;
+    return mesh->precision;
+}
+
 size_t cg_mesh_vertex_count(CgMeshId id) {
     if (id == CG_NULL_ID) return 0;
     auto mesh = mesh_store_get(id);
     if (!mesh) return 0;
-    return mesh->vertices.size() / 3;
+    return mesh->vertex_count();
 }
 
 size_t cg_mesh_triangle_count(CgMeshId id) {
     if (id == CG_NULL_ID) return 0;
     auto mesh = mesh_store_get(id);
     if (!mesh) return 0;
-    return mesh->indices.size() / 3;
+    return mesh->indices_size() / 3;
 }
 
 CgError cg_mesh_copy_vertices(CgMeshId id, double* out_vertices) {
@@ -419,8 +1606,15 @@ CgError cg_mesh_copy_vertices(CgMeshId id, double* out_vertices) {
         set_last_error("cg_mesh_copy_vertices: invalid mesh ID");
         return CG_ERR_NULL_HANDLE;
     }
-    std::memcpy(out_vertices, mesh->vertices.data(),
-                mesh->vertices.size() * sizeof(double));
+    if (mesh->precision == CG_MESH_F32) {
+        // Widen during the copy.
+        const float* src = mesh->vertices_f32_data();
+        for (size_t i = 0; i < mesh->vertices_size(); ++i)
+            out_vertices[i] = static_cast<double>(src[i]);
+        return CG_OK;
+    }
+    std::memcpy(out_vertices, mesh->vertices_data(),
+                mesh->vertices_size() * sizeof(double));
     return CG_OK;
 }
 
@@ -434,8 +1628,15 @@ CgError cg_mesh_copy_normals(CgMeshId id, double* out_normals) {
         set_last_error("cg_mesh_copy_normals: invalid mesh ID");
         return CG_ERR_NULL_HANDLE;
     }
-    std::memcpy(out_normals, mesh->normals.data(),
-                mesh->normals.size() * sizeof(double));
+    mesh_ensure_normals(mesh);
+    if (mesh->precision == CG_MESH_F32) {
+        const float* src = mesh->normals_f32_data();
+        for (size_t i = 0; i < mesh->vertices_size(); ++i)
+            out_normals[i] = static_cast<double>(src[i]);
+        return CG_OK;
+    }
+    std::memcpy(out_normals, mesh->normals_data(),
+                mesh->vertices_size() * sizeof(double));
     return CG_OK;
 }
 
@@ -449,159 +1650,2127 @@ CgError cg_mesh_copy_indices(CgMeshId id, uint32_t* out_indices) {
         set_last_error("cg_mesh_copy_indices: invalid mesh ID");
         return CG_ERR_NULL_HANDLE;
     }
-    std::memcpy(out_indices, mesh->indices.data(),
-                mesh->indices.size() * sizeof(uint32_t));
+    std::memcpy(out_indices, mesh->indices_data(),
+                mesh->indices_size() * sizeof(uint32_t));
     return CG_OK;
 }
 
-void cg_mesh_free(CgMeshId id) {
-    if (id == CG_NULL_ID) return;
-    mesh_store_erase(id);
+CgError cg_mesh_copy_vertices_f32(CgMeshId id, float* out_vertices) {
+    if (id == CG_NULL_ID || !out_vertices) {
+        set_last_error("cg_mesh_copy_vertices_f32: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    auto mesh = mesh_store_get(id);
+    if (!mesh) {
+        set_last_error("cg_mesh_copy_vertices_f32: invalid mesh ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    if (mesh->precision == CG_MESH_F32) {
+        std::memcpy(out_vertices, mesh->vertices_f32_data(),
+                    mesh->vertices_size() * sizeof(float));
+        return CG_OK;
+    }
+    // Narrow during the copy.
+    const double* src = mesh->vertices_data();
+    for (size_t i = 0; i < mesh->vertices_size(); ++i)
+        out_vertices[i] = static_cast<float>(src[i]);
+    return CG_OK;
 }
 
-/* ── Surface evaluation (stubs) ──────────────────────────────────────────── */
-
-CgSurfaceType cg_face_surface_type(CgFaceId /*id*/) {
-    set_last_error("not implemented");
-    return CG_SURF_OTHER;
+CgError cg_mesh_copy_normals_f32(CgMeshId id, float* out_normals) {
+    if (id == CG_NULL_ID || !out_normals) {
+        set_last_error("cg_mesh_copy_normals_f32: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    auto mesh = mesh_store_get(id);
+    if (!mesh) {
+        set_last_error("cg_mesh_copy_normals_f32: invalid mesh ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    mesh_ensure_normals(mesh);
+    if (mesh->precision == CG_MESH_F32) {
+        std::memcpy(out_normals, mesh->normals_f32_data(),
+                    mesh->vertices_size() * sizeof(float));
+        return CG_OK;
+    }
+    const double* src = mesh->normals_data();
+    for (size_t i = 0; i < mesh->vertices_size(); ++i)
+        out_normals[i] = static_cast<float>(src[i]);
+    return CG_OK;
 }
 
-CgUVBounds cg_face_uv_bounds(CgFaceId /*id*/) {
-    set_last_error("not implemented");
-    return CgUVBounds{0, 0, 0, 0};
-}
+/* ── Zero-copy mesh access ───────────────────────────────────────────────── */
 
-CgPoint3 cg_face_eval_point(CgFaceId /*id*/, double /*u*/, double /*v*/) {
-    set_last_error("not implemented");
-    return CgPoint3{0, 0, 0};
+CgError cg_mesh_map(CgMeshId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_mesh_map: null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    std::lock_guard<std::mutex> lock(g_mesh_pin_mutex);
+    auto pit = g_mesh_pins.find(id);
+    if (pit != g_mesh_pins.end()) {
+        ++pit->second.second;
+        return CG_OK;
+    }
+    auto mesh = g_mesh_store.get_shared(id);
+    if (!mesh) {
+        set_last_error("cg_mesh_map: invalid mesh ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    g_mesh_pins.emplace(id, std::make_pair(std::move(mesh), uint64_t{1}));
+    return CG_OK;
 }
 
-CgVec3 cg_face_eval_normal(CgFaceId /*id*/, double /*u*/, double /*v*/) {
-    set_last_error("not implemented");
-    return CgVec3{0, 0, 0};
+CgError cg_mesh_unmap(CgMeshId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_mesh_unmap: null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    std::lock_guard<std::mutex> lock(g_mesh_pin_mutex);
+    auto pit = g_mesh_pins.find(id);
+    if (pit == g_mesh_pins.end()) {
+        set_last_error("cg_mesh_unmap: mesh is not mapped");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (--pit->second.second == 0) {
+        g_mesh_pins.erase(pit);  // drops the pin's shared_ptr
+    }
+    return CG_OK;
 }
 
-CgVec3 cg_face_eval_du(CgFaceId /*id*/, double /*u*/, double /*v*/) {
-    set_last_error("not implemented");
-    return CgVec3{0, 0, 0};
+const double* cg_mesh_vertices_ptr(CgMeshId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_mesh_vertices_ptr: null handle");
+        return nullptr;
+    }
+    auto mesh = mesh_store_get(id);
+    if (!mesh) {
+        set_last_error("cg_mesh_vertices_ptr: invalid mesh ID");
+        return nullptr;
+    }
+    if (mesh->precision != CG_MESH_F64) {
+        set_last_error("cg_mesh_vertices_ptr: mesh is stored as float32");
+        return nullptr;
+    }
+    return mesh->vertices_data();
 }
 
-CgVec3 cg_face_eval_dv(CgFaceId /*id*/, double /*u*/, double /*v*/) {
-    set_last_error("not implemented");
-    return CgVec3{0, 0, 0};
+const double* cg_mesh_normals_ptr(CgMeshId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_mesh_normals_ptr: null handle");
+        return nullptr;
+    }
+    auto mesh = mesh_store_get(id);
+    if (!mesh) {
+        set_last_error("cg_mesh_normals_ptr: invalid mesh ID");
+        return nullptr;
+    }
+    if (mesh->precision != CG_MESH_F64) {
+        set_last_error("cg_mesh_normals_ptr: mesh is stored as float32");
+        return nullptr;
+    }
+    mesh_ensure_normals(mesh);
+    return mesh->normals_data();
 }
 
-CgPoint2 cg_face_project_point(CgFaceId /*id*/, CgPoint3 /*point*/, double* /*out_dist*/) {
-    set_last_error("not implemented");
-    return CgPoint2{0, 0};
+const float* cg_mesh_vertices_ptr_f32(CgMeshId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_mesh_vertices_ptr_f32: null handle");
+        return nullptr;
+    }
+    auto mesh = mesh_store_get(id);
+    if (!mesh) {
+        set_last_error("cg_mesh_vertices_ptr_f32: invalid mesh ID");
+        return nullptr;
+    }
+    if (mesh->precision != CG_MESH_F32) {
+        set_last_error("cg_mesh_vertices_ptr_f32: mesh is stored as double");
+        return nullptr;
+    }
+    return mesh->vertices_f32_data();
 }
 
-CgError cg_face_plane(CgFaceId /*id*/, CgVec3* /*out_normal*/, CgPoint3* /*out_origin*/) {
-    set_last_error("not implemented");
-    return CG_ERR_NO_RESULT;
+const float* cg_mesh_normals_ptr_f32(CgMeshId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_mesh_normals_ptr_f32: null handle");
+        return nullptr;
+    }
+    auto mesh = mesh_store_get(id);
+    if (!mesh) {
+        set_last_error("cg_mesh_normals_ptr_f32: invalid mesh ID");
+        return nullptr;
+    }
+    if (mesh->precision != CG_MESH_F32) {
+        set_last_error("cg_mesh_normals_ptr_f32: mesh is stored as double");
+        return nullptr;
+    }
+    mesh_ensure_normals(mesh);
+    return mesh->normals_f32_data();
 }
 
-CgError cg_face_cylinder(CgFaceId /*id*/, CgVec3* /*out_axis*/,
-                          CgPoint3* /*out_origin*/, double* /*out_radius*/) {
-    set_last_error("not implemented");
-    return CG_ERR_NO_RESULT;
+const uint32_t* cg_mesh_indices_ptr(CgMeshId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_mesh_indices_ptr: null handle");
+        return nullptr;
+    }
+    auto mesh = mesh_store_get(id);
+    if (!mesh) {
+        set_last_error("cg_mesh_indices_ptr: invalid mesh ID");
+        return nullptr;
+    }
+    return mesh->indices_data();
 }
 
-/* ── Edge / curve evaluation (stubs) ─────────────────────────────────────── */
-
-void cg_edge_param_range(CgEdgeId /*id*/, double* out_tmin, double* out_tmax) {
-    set_last_error("not implemented");
-    if (out_tmin) *out_tmin = 0.0;
-    if (out_tmax) *out_tmax = 0.0;
+void cg_mesh_free(CgMeshId id) {
+    if (id == CG_NULL_ID) return;
+    mesh_store_erase(id);
 }
 
-CgPoint3 cg_edge_eval_point(CgEdgeId /*id*/, double /*t*/) {
-    set_last_error("not implemented");
-    return CgPoint3{0, 0, 0};
-}
+/* ── Streaming mesh extraction ───────────────────────────────────────────── */
 
-CgVec3 cg_edge_eval_tangent(CgEdgeId /*id*/, double /*t*/) {
-    set_last_error("not implemented");
-    return CgVec3{0, 0, 0};
+CgMeshStreamId cg_mesh_stream_begin(CgMeshId mesh_id, size_t chunk_triangles) {
+    if (mesh_id == CG_NULL_ID) {
+        set_last_error("cg_mesh_stream_begin: null handle");
+        return CG_NULL_ID;
+    }
+    if (chunk_triangles == 0) {
+        set_last_error("cg_mesh_stream_begin: chunk_triangles must be > 0");
+        return CG_NULL_ID;
+    }
+    // Extend the mesh's lifetime like a map pin — also catches meshes that
+    // are freed but still pinned.
+    std::shared_ptr<CgMeshData> mesh = g_mesh_store.get_shared(mesh_id);
+    if (!mesh) {
+        std::lock_guard<std::mutex> lock(g_mesh_pin_mutex);
+        auto pit = g_mesh_pins.find(mesh_id);
+        if (pit != g_mesh_pins.end()) mesh = pit->second.first;
+    }
+    if (!mesh) {
+        set_last_error("cg_mesh_stream_begin: invalid mesh ID");
+        return CG_NULL_ID;
+    }
+    auto stream = std::make_shared<CgMeshStreamData>();
+    stream->mesh       = std::move(mesh);
+    stream->chunk_tris = chunk_triangles;
+    return stream_store_insert(std::move(stream));
 }
 
-double cg_edge_length(CgEdgeId /*id*/) {
-    set_last_error("not implemented");
-    return 0.0;
+CgError cg_mesh_stream_next(CgMeshStreamId id, float* out_vertices,
+                             float* out_normals, uint32_t* out_indices,
+                             size_t* out_n_vertices, size_t* out_n_triangles) {
+    if (out_n_vertices)  *out_n_vertices  = 0;
+    if (out_n_triangles) *out_n_triangles = 0;
+    if (!out_vertices || !out_indices || !out_n_vertices || !out_n_triangles) {
+        set_last_error("cg_mesh_stream_next: null output pointer");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_mesh_stream_next: null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    auto stream = stream_store_get(id);
+    if (!stream) {
+        set_last_error("cg_mesh_stream_next: invalid stream ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    CgMeshData* mesh = stream->mesh.get();
+    if (out_normals) mesh_ensure_normals(mesh);
+
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    const size_t total = mesh->indices_size() / 3;
+    const size_t begin = stream->cursor;
+    const size_t count = std::min(stream->chunk_tris, total - begin);
+    if (count == 0) return CG_OK;  // exhausted — counts stay 0
+
+    const bool      f32 = (mesh->precision == CG_MESH_F32);
+    const uint32_t* idx = mesh->indices_data();
+    const double*   v64 = f32 ? nullptr : mesh->vertices_data();
+    const double*   n64 = f32 ? nullptr : mesh->normals_data();
+    const float*    v32 = f32 ? mesh->vertices_f32_data() : nullptr;
+    const float*    n32 = f32 ? mesh->normals_f32_data() : nullptr;
+
+    // Gather the chunk's vertices in first-appearance order and rebase the
+    // indices onto them, so the chunk draws standalone.
+    std::unordered_map<uint32_t, uint32_t> local;
+    local.reserve(count * 3);
+    uint32_t n_local = 0;
+    for (size_t t = 0; t < count; ++t) {
+        for (int c = 0; c < 3; ++c) {
+            const uint32_t global = idx[(begin + t) * 3 + c];
+            auto ins = local.emplace(global, n_local);
+            if (ins.second) {
+                const size_t src = size_t(global) * 3;
+                const size_t dst = size_t(n_local) * 3;
+                for (int k = 0; k < 3; ++k) {
+                    out_vertices[dst + k] =
+                        f32 ? v32[src + k]
+                            : static_cast<float>(v64[src + k]);
+                    if (out_normals)
+                        out_normals[dst + k] =
+                            f32 ? n32[src + k]
+                                : static_cast<float>(n64[src + k]);
+                }
+                ++n_local;
+            }
+            out_indices[t * 3 + c] = ins.first->second;
+        }
+    }
+
+    stream->cursor = begin + count;
+    *out_n_vertices  = n_local;
+    *out_n_triangles = count;
+    return CG_OK;
 }
 
-int cg_edge_is_circle(CgEdgeId /*id*/, CgPoint3* /*out_center*/,
-                       CgVec3* /*out_axis*/, double* /*out_radius*/) {
-    set_last_error("not implemented");
-    return 0;
+void cg_mesh_stream_free(CgMeshStreamId id) {
+    if (id == CG_NULL_ID) return;
+    stream_store_erase(id);
 }
 
-/* ── Geometric queries (stubs) ───────────────────────────────────────────── */
+/* ── Geometry snapshot cache ─────────────────────────────────────────────── */
 
-double cg_shape_distance(CgShapeId /*a*/, CgShapeId /*b*/) {
-    set_last_error("not implemented");
-    return -1.0;
-}
+CgError cg_cache_save(const char* path) {
+    if (!path) {
+        set_last_error("cg_cache_save: null path");
+        return CG_ERR_INVALID_ARG;
+    }
+    perf_counters::Scope perf(perf_counters::kImport);
+    try {
+        // Snapshot the live meshes and materialize lazy normals, so the file
+        // — and every view later loaded from it — always carries them.
+        auto live = g_mesh_store.snapshot();
+        std::vector<geom_cache::MeshRecord> records(live.size());
+        for (size_t i = 0; i < live.size(); ++i) {
+            CgMeshData* mesh = live[i].second.get();
+            mesh_ensure_normals(mesh);
+            geom_cache::MeshRecord& r = records[i];
+            r.precision    = uint32_t(mesh->precision);
+            r.scalar_bytes = mesh->precision == CG_MESH_F32 ? sizeof(float)
+                                                            : sizeof(double);
+            r.n_vertices   = mesh->vertex_count();
+            r.n_indices    = mesh->indices_size();
+        }
+        const size_t total = geom_cache::plan_offsets(records);
 
-CgError cg_shape_section_at_z(CgShapeId /*id*/, double /*z_value*/,
-                               CgPoint3** out_points, size_t* out_count) {
-    set_last_error("not implemented");
-    if (out_points) *out_points = nullptr;
-    if (out_count)  *out_count  = 0;
-    return CG_ERR_NO_RESULT;
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            set_last_error(std::string("cg_cache_save: cannot open ") + path);
+            return CG_ERR_FILE_NOT_FOUND;
+        }
+        geom_cache::FileHeader hdr{};
+        std::memcpy(hdr.magic, geom_cache::kMagic, sizeof(hdr.magic));
+        hdr.version  = geom_cache::kVersion;
+        hdr.n_meshes = uint32_t(records.size());
+        out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        out.write(reinterpret_cast<const char*>(records.data()),
+                  std::streamsize(records.size() *
+                                  sizeof(geom_cache::MeshRecord)));
+
+        // Payload sections in record order; pad to each planned offset
+        // (gaps are always under one kAlign).
+        size_t pos = sizeof(hdr) +
+                     records.size() * sizeof(geom_cache::MeshRecord);
+        const char pad[geom_cache::kAlign] = {};
+        auto section = [&](uint64_t offset, const void* src, size_t bytes) {
+            out.write(pad, std::streamsize(size_t(offset) - pos));
+            out.write(reinterpret_cast<const char*>(src),
+                      std::streamsize(bytes));
+            pos = size_t(offset) + bytes;
+        };
+        for (size_t i = 0; i < live.size(); ++i) {
+            const CgMeshData* mesh = live[i].second.get();
+            const geom_cache::MeshRecord& r = records[i];
+            const size_t vertex_bytes =
+                size_t(r.n_vertices) * 3 * r.scalar_bytes;
+            if (mesh->precision == CG_MESH_F32) {
+                section(r.vertices_offset, mesh->vertices_f32_data(),
+                        vertex_bytes);
+                section(r.normals_offset, mesh->normals_f32_data(),
+                        vertex_bytes);
+            } else {
+                section(r.vertices_offset, mesh->vertices_data(),
+                        vertex_bytes);
+                section(r.normals_offset, mesh->normals_data(), vertex_bytes);
+            }
+            section(r.indices_offset, mesh->indices_data(),
+                    size_t(r.n_indices) * sizeof(uint32_t));
+        }
+        if (!out) {
+            set_last_error("cg_cache_save: write failed");
+            return CG_ERR_NO_RESULT;
+        }
+        perf.add_bytes(total);
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_cache_save: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("cg_cache_save: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
 }
 
-void cg_section_free(CgPoint3* points) {
-    delete[] points;
-}
+CgError cg_cache_load(const char* path, CgMeshId** out_meshes,
+                      size_t* out_count) {
+    if (!path || !out_meshes || !out_count) {
+        set_last_error("cg_cache_load: null argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    *out_meshes = nullptr;
+    *out_count  = 0;
+    perf_counters::Scope perf(perf_counters::kImport);
+    try {
+        auto map = std::make_shared<stl_import::FileMapping>();
+        if (!map->open(path)) {
+            set_last_error(std::string("cg_cache_load: cannot map ") + path);
+            return CG_ERR_FILE_NOT_FOUND;
+        }
+        std::vector<geom_cache::MeshRecord> records;
+        if (!geom_cache::validate(map->data(), map->size(), records)) {
+            set_last_error("cg_cache_load: not a valid geometry snapshot");
+            return CG_ERR_PARSE_FAILED;
+        }
+        for (const geom_cache::MeshRecord& r : records) {
+            const size_t scalar = r.precision == CG_MESH_F32 ? sizeof(float)
+                                                             : sizeof(double);
+            if ((r.precision != CG_MESH_F64 && r.precision != CG_MESH_F32) ||
+                r.scalar_bytes != scalar) {
+                set_last_error("cg_cache_load: unknown mesh precision");
+                return CG_ERR_PARSE_FAILED;
+            }
+        }
 
-/* ── Feature detection (stubs) ───────────────────────────────────────────── */
+        // Register each mesh as a zero-copy view into the shared mapping;
+        // the mapping lives until the last view (or pin on one) is freed.
+        const uint8_t* base = map->data();
+        std::vector<CgMeshId> ids;
+        ids.reserve(records.size());
+        size_t bytes = 0;
+        for (const geom_cache::MeshRecord& r : records) {
+            auto data = std::make_shared<CgMeshData>();
+            data->precision = CgMeshPrecision(r.precision);
+            data->backing   = map;
+            if (data->precision == CG_MESH_F32) {
+                data->view_vertices_f32 = reinterpret_cast<const float*>(
+                    base + r.vertices_offset);
+                data->view_normals_f32 = reinterpret_cast<const float*>(
+                    base + r.normals_offset);
+            } else {
+                data->view_vertices = reinterpret_cast<const double*>(
+                    base + r.vertices_offset);
+                data->view_normals = reinterpret_cast<const double*>(
+                    base + r.normals_offset);
+            }
+            data->view_indices = reinterpret_cast<const uint32_t*>(
+                base + r.indices_offset);
+            data->view_n_scalars = size_t(r.n_vertices) * 3;
+            data->view_n_indices = size_t(r.n_indices);
+            bytes += data->buffer_bytes();
+            ids.push_back(mesh_store_insert(std::move(data)));
+        }
 
-size_t cg_shape_find_holes(CgShapeId /*id*/,
-                            double /*min_diameter*/, double /*max_diameter*/,
-                            CgHoleInfo** out_holes) {
-    set_last_error("not implemented");
-    if (out_holes) *out_holes = nullptr;
-    return 0;
+        if (!ids.empty()) {
+            *out_meshes = new CgMeshId[ids.size()];
+            std::memcpy(*out_meshes, ids.data(),
+                        ids.size() * sizeof(CgMeshId));
+        }
+        *out_count = ids.size();
+        perf.add_bytes(bytes);
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_cache_load: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("cg_cache_load: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
 }
 
-void cg_holes_free(CgHoleInfo* holes) {
-    delete[] holes;
+void cg_mesh_ids_free(CgMeshId* ids) {
+    delete[] ids;
 }
 
-size_t cg_shape_find_planar_faces(CgShapeId /*id*/, CgPlanarFaceInfo** out_faces) {
-    set_last_error("not implemented");
-    if (out_faces) *out_faces = nullptr;
-    return 0;
+/* ── Mesh decimation ─────────────────────────────────────────────────────── */
+
+// Decimate one mesh's buffers into a fresh CgMeshData (QEM edge collapse in
+// decimate.h).  Shared by cg_mesh_simplify and the per-level LOD workers.
+static std::shared_ptr<CgMeshData> simplify_mesh_data(const CgMeshData& src,
+                                                      double target_ratio,
+                                                      double max_error) {
+    auto out = std::make_shared<CgMeshData>();
+    out->precision = src.precision;
+    out->indices.assign(src.indices_data(),
+                        src.indices_data() + src.indices_size());
+    const size_t target =
+        size_t(double(src.indices_size() / 3) * target_ratio);
+    const double err = (max_error > 0.0)
+                           ? max_error
+                           : std::numeric_limits<double>::infinity();
+    if (src.precision == CG_MESH_F32) {
+        out->vertices_f32.assign(
+            src.vertices_f32_data(),
+            src.vertices_f32_data() + src.vertices_size());
+        decimate::simplify(out->vertices_f32, out->indices, target, err);
+        decimate::recompute_normals(out->vertices_f32, out->indices,
+                                    out->normals_f32);
+    } else {
+        out->vertices.assign(src.vertices_data(),
+                             src.vertices_data() + src.vertices_size());
+        decimate::simplify(out->vertices, out->indices, target, err);
+        decimate::recompute_normals(out->vertices, out->indices,
+                                    out->normals);
+    }
+    return out;
 }
 
-void cg_planar_faces_free(CgPlanarFaceInfo* faces) {
-    delete[] faces;
+CgMeshId cg_mesh_simplify(CgMeshId id, double target_ratio, double max_error) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_mesh_simplify: null handle");
+        return CG_NULL_ID;
+    }
+    if (!(target_ratio > 0.0) || target_ratio > 1.0) {
+        set_last_error("cg_mesh_simplify: target_ratio must be in (0, 1]");
+        return CG_NULL_ID;
+    }
+    if (max_error < 0.0 || !std::isfinite(max_error)) {
+        set_last_error("cg_mesh_simplify: invalid max_error");
+        return CG_NULL_ID;
+    }
+    CgMeshData* mesh = mesh_store_get(id);
+    if (!mesh) {
+        set_last_error("cg_mesh_simplify: invalid mesh ID");
+        return CG_NULL_ID;
+    }
+    try {
+        return mesh_store_insert(
+            simplify_mesh_data(*mesh, target_ratio, max_error));
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_mesh_simplify: ") + ex.what());
+        return CG_NULL_ID;
+    } catch (...) {
+        set_last_error("cg_mesh_simplify: unknown exception");
+        return CG_NULL_ID;
+    }
 }
 
-/* ── 2D polygon operations (stubs — Clipper2 impl in later phase) ────────── */
-
-CgError cg_poly_offset(const double* /*points*/, size_t /*point_count*/,
-                        double /*delta*/, double /*arc_tolerance*/,
-                        double** out_points, size_t* out_count) {
-    set_last_error("not implemented");
-    if (out_points) *out_points = nullptr;
-    if (out_count)  *out_count  = 0;
-    return CG_ERR_NO_RESULT;
+CgError cg_mesh_build_lods(CgMeshId id, const double* target_ratios,
+                           size_t n_levels, CgMeshId* out_meshes) {
+    if (!target_ratios || !out_meshes || n_levels == 0) {
+        set_last_error("cg_mesh_build_lods: null array");
+        return CG_ERR_INVALID_ARG;
+    }
+    // Null every slot before validating so a failed call leaves no caller
+    // garbage in out_meshes, as the header promises.
+    for (size_t i = 0; i < n_levels; ++i)
+        out_meshes[i] = CG_NULL_ID;
+    for (size_t i = 0; i < n_levels; ++i) {
+        if (!(target_ratios[i] > 0.0) || target_ratios[i] > 1.0) {
+            set_last_error("cg_mesh_build_lods: target ratios must be in (0, 1]");
+            return CG_ERR_INVALID_ARG;
+        }
+    }
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_mesh_build_lods: null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    CgMeshData* mesh = mesh_store_get(id);
+    if (!mesh) {
+        set_last_error("cg_mesh_build_lods: invalid mesh ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    try {
+        // Every level decimates independently from the source, so the
+        // levels run concurrently and each result is identical to a
+        // standalone cg_mesh_simplify call at that ratio.
+        std::vector<std::shared_ptr<CgMeshData>> results(n_levels);
+        std::atomic<size_t> cursor{0};
+        std::mutex  err_mutex;
+        std::string first_error;
+        auto worker = [&]() {
+            try {
+                for (size_t i = cursor.fetch_add(1, std::memory_order_relaxed);
+                     i < n_levels;
+                     i = cursor.fetch_add(1, std::memory_order_relaxed)) {
+                    results[i] = simplify_mesh_data(
+                        *mesh, target_ratios[i],
+                        std::numeric_limits<double>::infinity());
+                }
+            } catch (const std::exception& ex) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty()) first_error = ex.what();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty())
+                    first_error = "unknown exception in LOD build";
+            }
+        };
+        const size_t n_workers = std::min(worker_pool::effective(), n_levels);
+        if (n_workers > 1) worker_pool::note_batch(n_levels);
+        std::vector<std::thread> threads;
+        threads.reserve(n_workers - 1);
+        for (size_t w = 1; w < n_workers; ++w) threads.emplace_back(worker);
+        worker();
+        for (auto& t : threads) t.join();
+        if (!first_error.empty()) {
+            set_last_error(std::string("cg_mesh_build_lods: ") + first_error);
+            return CG_ERR_NO_RESULT;
+        }
+        for (size_t i = 0; i < n_levels; ++i)
+            out_meshes[i] = mesh_store_insert(std::move(results[i]));
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_mesh_build_lods: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("cg_mesh_build_lods: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
 }
 
-void cg_poly_free(double* points) {
-    delete[] points;
+/* ── Surface evaluation ──────────────────────────────────────────────────── */
+
+// Map OCCT's surface classification to the C enum.
+static CgSurfaceType surface_type_of(const BRepAdaptor_Surface& surf) {
+    switch (surf.GetType()) {
+        case GeomAbs_Plane:                return CG_SURF_PLANE;
+        case GeomAbs_Cylinder:             return CG_SURF_CYLINDER;
+        case GeomAbs_Cone:                 return CG_SURF_CONE;
+        case GeomAbs_Sphere:               return CG_SURF_SPHERE;
+        case GeomAbs_Torus:                return CG_SURF_TORUS;
+        case GeomAbs_BSplineSurface:       return CG_SURF_BSPLINE;
+        case GeomAbs_BezierSurface:        return CG_SURF_BEZIER;
+        case GeomAbs_OffsetSurface:        return CG_SURF_OFFSET;
+        default:                           return CG_SURF_OTHER;
+    }
 }
 
-CgError cg_poly_boolean(const double* /*a_points*/, size_t /*a_count*/,
-                         const double* /*b_points*/, size_t /*b_count*/,
-                         CgBoolOp /*op*/,
-                         double** out_points, size_t* out_count) {
-    set_last_error("not implemented");
-    if (out_points) *out_points = nullptr;
-    if (out_count)  *out_count  = 0;
-    return CG_ERR_NO_RESULT;
+CgSurfaceType cg_face_surface_type(CgFaceId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_face_surface_type: null handle");
+        return CG_SURF_OTHER;
+    }
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        BRepAdaptor_Surface surf(TopoDS::Face(shape));
+        return surface_type_of(surf);
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_face_surface_type: invalid face ID");
+        return CG_SURF_OTHER;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Surface type exception: ") +
+                       ex.GetMessageString());
+        return CG_SURF_OTHER;
+    } catch (...) {
+        set_last_error("Surface type: unknown exception");
+        return CG_SURF_OTHER;
+    }
 }
 
+CgUVBounds cg_face_uv_bounds(CgFaceId id) {
+    CgUVBounds result{0, 0, 0, 0};
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_face_uv_bounds: null handle");
+        return result;
+    }
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        BRepTools::UVBounds(TopoDS::Face(shape),
+                            result.umin, result.umax, result.vmin, result.vmax);
+        return result;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_face_uv_bounds: invalid face ID");
+        return result;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("UV bounds exception: ") +
+                       ex.GetMessageString());
+        return result;
+    } catch (...) {
+        set_last_error("UV bounds: unknown exception");
+        return result;
+    }
+}
+
+/* ── Batch surface evaluation ────────────────────────────────────────────── */
+
+namespace {
+
+// Write one evaluated sample.  The normal is d1u x d1v normalized, flipped
+// for reversed faces so it points out of the solid; a degenerate cross
+// product (e.g. a cone apex) yields the zero vector.
+inline void write_sample(size_t i, const gp_Pnt& p, const gp_Vec& du,
+                         const gp_Vec& dv, double normal_sign,
+                         CgPoint3* out_points, CgVec3* out_normals,
+                         CgVec3* out_du, CgVec3* out_dv) {
+    if (out_points) out_points[i] = CgPoint3{p.X(), p.Y(), p.Z()};
+    if (out_du) out_du[i] = CgVec3{du.X(), du.Y(), du.Z()};
+    if (out_dv) out_dv[i] = CgVec3{dv.X(), dv.Y(), dv.Z()};
+    if (out_normals) {
+        gp_Vec n = du.Crossed(dv);
+        const double len = n.Magnitude();
+        if (len > 1e-12) {
+            const double s = normal_sign / len;
+            out_normals[i] = CgVec3{n.X() * s, n.Y() * s, n.Z() * s};
+        } else {
+            out_normals[i] = CgVec3{0, 0, 0};
+        }
+    }
+}
+
+// Evaluate samples [begin, end).  The adaptor is built per call so workers
+// never share one (BRepAdaptor_Surface caches are not thread-safe); the
+// analytic types bypass the adaptor's virtual D1 with closed forms that
+// the compiler vectorizes.
+void eval_face_range(const TopoDS_Face& face, const double* uv,
+                     size_t begin, size_t end, double normal_sign,
+                     CgPoint3* out_points, CgVec3* out_normals,
+                     CgVec3* out_du, CgVec3* out_dv) {
+    BRepAdaptor_Surface surf(face);
+    switch (surf.GetType()) {
+        case GeomAbs_Plane: {
+            const gp_Pln pln = surf.Plane();
+            const gp_Pnt o  = pln.Location();
+            const gp_Dir dx = pln.XAxis().Direction();
+            const gp_Dir dy = pln.YAxis().Direction();
+            const gp_Vec vdx(dx), vdy(dy);
+            for (size_t i = begin; i < end; ++i) {
+                const double u = uv[i * 2], v = uv[i * 2 + 1];
+                gp_Pnt p(o.X() + u * dx.X() + v * dy.X(),
+                         o.Y() + u * dx.Y() + v * dy.Y(),
+                         o.Z() + u * dx.Z() + v * dy.Z());
+                write_sample(i, p, vdx, vdy, normal_sign,
+                             out_points, out_normals, out_du, out_dv);
+            }
+            return;
+        }
+        case GeomAbs_Cylinder: {
+            const gp_Cylinder cyl = surf.Cylinder();
+            const gp_Pnt o  = cyl.Location();
+            const gp_Dir dx = cyl.XAxis().Direction();
+            const gp_Dir dy = cyl.YAxis().Direction();
+            const gp_Dir dz = cyl.Axis().Direction();
+            const double R  = cyl.Radius();
+            const gp_Vec vdz(dz);
+            for (size_t i = begin; i < end; ++i) {
+                const double u = uv[i * 2], v = uv[i * 2 + 1];
+                const double cu = std::cos(u), su = std::sin(u);
+                gp_Pnt p(o.X() + R * (cu * dx.X() + su * dy.X()) + v * dz.X(),
+                         o.Y() + R * (cu * dx.Y() + su * dy.Y()) + v * dz.Y(),
+                         o.Z() + R * (cu * dx.Z() + su * dy.Z()) + v * dz.Z());
+                gp_Vec du(R * (-su * dx.X() + cu * dy.X()),
+                          R * (-su * dx.Y() + cu * dy.Y()),
+                          R * (-su * dx.Z() + cu * dy.Z()));
+                write_sample(i, p, du, vdz, normal_sign,
+                             out_points, out_normals, out_du, out_dv);
+            }
+            return;
+        }
+        case GeomAbs_Cone: {
+            const gp_Cone cone = surf.Cone();
+            const gp_Pnt o  = cone.Location();
+            const gp_Dir dx = cone.XAxis().Direction();
+            const gp_Dir dy = cone.YAxis().Direction();
+            const gp_Dir dz = cone.Axis().Direction();
+            const double R  = cone.RefRadius();
+            const double sa = std::sin(cone.SemiAngle());
+            const double ca = std::cos(cone.SemiAngle());
+            for (size_t i = begin; i < end; ++i) {
+                const double u = uv[i * 2], v = uv[i * 2 + 1];
+                const double cu = std::cos(u), su = std::sin(u);
+                const double r = R + v * sa;
+                gp_Pnt p(o.X() + r * (cu * dx.X() + su * dy.X()) + v * ca * dz.X(),
+                         o.Y() + r * (cu * dx.Y() + su * dy.Y()) + v * ca * dz.Y(),
+                         o.Z() + r * (cu * dx.Z() + su * dy.Z()) + v * ca * dz.Z());
+                gp_Vec du(r * (-su * dx.X() + cu * dy.X()),
+                          r * (-su * dx.Y() + cu * dy.Y()),
+                          r * (-su * dx.Z() + cu * dy.Z()));
+                gp_Vec dv(sa * (cu * dx.X() + su * dy.X()) + ca * dz.X(),
+                          sa * (cu * dx.Y() + su * dy.Y()) + ca * dz.Y(),
+                          sa * (cu * dx.Z() + su * dy.Z()) + ca * dz.Z());
+                write_sample(i, p, du, dv, normal_sign,
+                             out_points, out_normals, out_du, out_dv);
+            }
+            return;
+        }
+        default: {
+            gp_Pnt p;
+            gp_Vec du, dv;
+            for (size_t i = begin; i < end; ++i) {
+                surf.D1(uv[i * 2], uv[i * 2 + 1], p, du, dv);
+                write_sample(i, p, du, dv, normal_sign,
+                             out_points, out_normals, out_du, out_dv);
+            }
+            return;
+        }
+    }
+}
+
+// Batches below this size are evaluated on the calling thread; the
+// per-worker adaptor construction is not worth it for less.
+constexpr size_t kEvalParallelThreshold = 4096;
+
+} // namespace
+
+CgError cg_face_eval_batch(CgFaceId id, const double* uv_pairs, size_t n,
+                           CgPoint3* out_points, CgVec3* out_normals,
+                           CgVec3* out_du, CgVec3* out_dv) {
+    if (!uv_pairs) {
+        set_last_error("cg_face_eval_batch: null uv_pairs");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_face_eval_batch: null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    perf_counters::Scope perf(perf_counters::kEval);
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        if (shape.ShapeType() != TopAbs_FACE) {
+            set_last_error("cg_face_eval_batch: handle is not a face");
+            return CG_ERR_INVALID_ARG;
+        }
+        uint64_t out_bytes = 0;
+        if (out_points)  out_bytes += n * sizeof(CgPoint3);
+        if (out_normals) out_bytes += n * sizeof(CgVec3);
+        if (out_du)      out_bytes += n * sizeof(CgVec3);
+        if (out_dv)      out_bytes += n * sizeof(CgVec3);
+        perf.add_bytes(out_bytes);
+        const TopoDS_Face face = TopoDS::Face(shape);
+        const double normal_sign =
+            (face.Orientation() == TopAbs_REVERSED) ? -1.0 : 1.0;
+
+        const size_t n_workers = std::min(worker_pool::effective(),
+                                          n / kEvalParallelThreshold + 1);
+        if (n_workers <= 1) {
+            eval_face_range(face, uv_pairs, 0, n, normal_sign,
+                            out_points, out_normals, out_du, out_dv);
+            return CG_OK;
+        }
+        worker_pool::note_batch(n);
+
+        const size_t per = (n + n_workers - 1) / n_workers;
+        std::mutex  err_mutex;
+        std::string first_error;
+        auto worker = [&](size_t begin, size_t end) {
+            try {
+                eval_face_range(face, uv_pairs, begin, end, normal_sign,
+                                out_points, out_normals, out_du, out_dv);
+            } catch (const Standard_Failure& ex) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty())
+                    first_error = std::string("OCCT exception in eval: ") +
+                                  ex.GetMessageString();
+            } catch (const std::exception& ex) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty()) first_error = ex.what();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty()) first_error = "unknown exception in eval";
+            }
+        };
+        std::vector<std::thread> threads;
+        threads.reserve(n_workers - 1);
+        for (size_t w = 1; w < n_workers; ++w)
+            threads.emplace_back(worker, w * per, std::min(n, (w + 1) * per));
+        worker(0, std::min(n, per));
+        for (auto& t : threads) t.join();
+        if (!first_error.empty()) {
+            set_last_error(first_error);
+            return CG_ERR_OCCT_EXCEPTION;
+        }
+        return CG_OK;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_face_eval_batch: invalid face ID");
+        return CG_ERR_NULL_HANDLE;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Eval exception: ") + ex.GetMessageString());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (...) {
+        set_last_error("Eval: unknown exception");
+        return CG_ERR_OCCT_EXCEPTION;
+    }
+}
+
+// The single-sample evaluators are one-element batches.
+
+CgPoint3 cg_face_eval_point(CgFaceId id, double u, double v) {
+    const double uv[2] = {u, v};
+    CgPoint3 p{0, 0, 0};
+    cg_face_eval_batch(id, uv, 1, &p, nullptr, nullptr, nullptr);
+    return p;
+}
+
+CgVec3 cg_face_eval_normal(CgFaceId id, double u, double v) {
+    const double uv[2] = {u, v};
+    CgVec3 n{0, 0, 0};
+    cg_face_eval_batch(id, uv, 1, nullptr, &n, nullptr, nullptr);
+    return n;
+}
+
+CgVec3 cg_face_eval_du(CgFaceId id, double u, double v) {
+    const double uv[2] = {u, v};
+    CgVec3 d{0, 0, 0};
+    cg_face_eval_batch(id, uv, 1, nullptr, nullptr, &d, nullptr);
+    return d;
+}
+
+CgVec3 cg_face_eval_dv(CgFaceId id, double u, double v) {
+    const double uv[2] = {u, v};
+    CgVec3 d{0, 0, 0};
+    cg_face_eval_batch(id, uv, 1, nullptr, nullptr, nullptr, &d);
+    return d;
+}
+
+CgError cg_face_project_points(CgFaceId id, const CgPoint3* points, size_t n,
+                               const double* seed_uvs, CgPoint2* out_uvs,
+                               double* out_dists) {
+    if (!points || !out_uvs) {
+        set_last_error("cg_face_project_points: null array");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_face_project_points: null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    perf_counters::Scope perf(perf_counters::kEval);
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        if (shape.ShapeType() != TopAbs_FACE) {
+            set_last_error("cg_face_project_points: handle is not a face");
+            return CG_ERR_INVALID_ARG;
+        }
+        perf.add_bytes(n * sizeof(CgPoint2) +
+                       (out_dists ? n * sizeof(double) : 0));
+        const TopoDS_Face face = TopoDS::Face(shape);
+        Handle(Geom_Surface) geom = BRep_Tool::Surface(face);
+        if (geom.IsNull()) {
+            set_last_error("cg_face_project_points: face has no surface");
+            return CG_ERR_NO_RESULT;
+        }
+        ShapeAnalysis_Surface sas(geom);
+        const double tol = BRep_Tool::Tolerance(face);
+
+        // Consecutive toolpath samples project near each other, so each
+        // point's Newton iteration starts from the previous solution (or
+        // the caller's seed).  The warm result is trusted only if its gap
+        // respects the triangle bound  true_dist <= prev_gap + |p - p_prev|
+        // (the previous projection is itself a surface point); otherwise
+        // the iteration diverged and we redo a cold global search.
+        gp_Pnt prev_pnt;
+        double prev_gap = 0.0;
+        bool   have_prev = false;
+        for (size_t i = 0; i < n; ++i) {
+            const gp_Pnt p(points[i].x, points[i].y, points[i].z);
+            gp_Pnt2d uv;
+            bool warm = false;
+            if (seed_uvs) {
+                uv = sas.NextValueOfUV(
+                    gp_Pnt2d(seed_uvs[i * 2], seed_uvs[i * 2 + 1]), p, tol);
+                warm = true;
+            } else if (have_prev) {
+                uv = sas.NextValueOfUV(gp_Pnt2d(out_uvs[i - 1].u,
+                                                out_uvs[i - 1].v), p, tol);
+                warm = true;
+            } else {
+                uv = sas.ValueOfUV(p, tol);
+            }
+            double gap = sas.Gap();
+            if (warm && have_prev) {
+                const double bound = prev_gap + p.Distance(prev_pnt) + tol;
+                if (!(gap <= bound)) {  // also catches NaN
+                    uv  = sas.ValueOfUV(p, tol);
+                    gap = sas.Gap();
+                }
+            }
+            out_uvs[i] = CgPoint2{uv.X(), uv.Y()};
+            if (out_dists) out_dists[i] = gap;
+            prev_pnt  = p;
+            prev_gap  = gap;
+            have_prev = true;
+        }
+        return CG_OK;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_face_project_points: invalid face ID");
+        return CG_ERR_NULL_HANDLE;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Project exception: ") +
+                       ex.GetMessageString());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (...) {
+        set_last_error("Project: unknown exception");
+        return CG_ERR_OCCT_EXCEPTION;
+    }
+}
+
+CgPoint2 cg_face_project_point(CgFaceId id, CgPoint3 point, double* out_dist) {
+    CgPoint2 uv{0, 0};
+    cg_face_project_points(id, &point, 1, nullptr, &uv, out_dist);
+    return uv;
+}
+
+CgError cg_face_plane(CgFaceId /*id*/, CgVec3* /*out_normal*/, CgPoint3* /*out_origin*/) {
+    set_last_error("not implemented");
+    return CG_ERR_NO_RESULT;
+}
+
+CgError cg_face_cylinder(CgFaceId /*id*/, CgVec3* /*out_axis*/,
+                          CgPoint3* /*out_origin*/, double* /*out_radius*/) {
+    set_last_error("not implemented");
+    return CG_ERR_NO_RESULT;
+}
+
+/* ── Edge / curve evaluation ─────────────────────────────────────────────── */
+
+void cg_edge_param_range(CgEdgeId id, double* out_tmin, double* out_tmax) {
+    if (out_tmin) *out_tmin = 0.0;
+    if (out_tmax) *out_tmax = 0.0;
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_edge_param_range: null handle");
+        return;
+    }
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        BRepAdaptor_Curve curve(TopoDS::Edge(shape));
+        if (out_tmin) *out_tmin = curve.FirstParameter();
+        if (out_tmax) *out_tmax = curve.LastParameter();
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_edge_param_range: invalid edge ID");
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Edge exception: ") + ex.GetMessageString());
+    } catch (...) {
+        set_last_error("Edge: unknown exception");
+    }
+}
+
+CgPoint3 cg_edge_eval_point(CgEdgeId id, double t) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_edge_eval_point: null handle");
+        return CgPoint3{0, 0, 0};
+    }
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        BRepAdaptor_Curve curve(TopoDS::Edge(shape));
+        const gp_Pnt p = curve.Value(t);
+        return CgPoint3{p.X(), p.Y(), p.Z()};
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_edge_eval_point: invalid edge ID");
+        return CgPoint3{0, 0, 0};
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Edge exception: ") + ex.GetMessageString());
+        return CgPoint3{0, 0, 0};
+    } catch (...) {
+        set_last_error("Edge: unknown exception");
+        return CgPoint3{0, 0, 0};
+    }
+}
+
+CgVec3 cg_edge_eval_tangent(CgEdgeId id, double t) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_edge_eval_tangent: null handle");
+        return CgVec3{0, 0, 0};
+    }
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        BRepAdaptor_Curve curve(TopoDS::Edge(shape));
+        gp_Pnt p;
+        gp_Vec d1;
+        curve.D1(t, p, d1);
+        const double mag = d1.Magnitude();
+        if (mag < gp::Resolution()) {
+            set_last_error("cg_edge_eval_tangent: degenerate tangent");
+            return CgVec3{0, 0, 0};
+        }
+        return CgVec3{d1.X() / mag, d1.Y() / mag, d1.Z() / mag};
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_edge_eval_tangent: invalid edge ID");
+        return CgVec3{0, 0, 0};
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Edge exception: ") + ex.GetMessageString());
+        return CgVec3{0, 0, 0};
+    } catch (...) {
+        set_last_error("Edge: unknown exception");
+        return CgVec3{0, 0, 0};
+    }
+}
+
+double cg_edge_length(CgEdgeId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_edge_length: null handle");
+        return 0.0;
+    }
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        GProp_GProps props;
+        BRepGProp::LinearProperties(shape, props);
+        return props.Mass();
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_edge_length: invalid edge ID");
+        return 0.0;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Edge exception: ") + ex.GetMessageString());
+        return 0.0;
+    } catch (...) {
+        set_last_error("Edge: unknown exception");
+        return 0.0;
+    }
+}
+
+int cg_edge_is_circle(CgEdgeId id, CgPoint3* out_center,
+                       CgVec3* out_axis, double* out_radius) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_edge_is_circle: null handle");
+        return 0;
+    }
+    try {
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        BRepAdaptor_Curve curve(TopoDS::Edge(shape));
+        if (curve.GetType() != GeomAbs_Circle) return 0;
+        const gp_Circ circ = curve.Circle();
+        if (out_center) {
+            const gp_Pnt c = circ.Location();
+            *out_center = CgPoint3{c.X(), c.Y(), c.Z()};
+        }
+        if (out_axis) {
+            const gp_Dir a = circ.Axis().Direction();
+            *out_axis = CgVec3{a.X(), a.Y(), a.Z()};
+        }
+        if (out_radius) *out_radius = circ.Radius();
+        return 1;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_edge_is_circle: invalid edge ID");
+        return 0;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Edge exception: ") + ex.GetMessageString());
+        return 0;
+    } catch (...) {
+        set_last_error("Edge: unknown exception");
+        return 0;
+    }
+}
+
+// Sample one edge into pts/params so the chordal deviation stays within tol.
+// Lines need only their endpoints and circles admit the exact chord step
+// dθ = 2·acos(1 − tol/r), clamped to a quarter turn; everything else goes
+// through OCCT's curvature-adaptive deflection walker.
+static void discretize_edge(const TopoDS_Edge& edge, double tol,
+                            std::vector<CgPoint3>& pts,
+                            std::vector<double>& params) {
+    BRepAdaptor_Curve curve(edge);
+    const double t0 = curve.FirstParameter();
+    const double t1 = curve.LastParameter();
+
+    size_t segments = 1;
+    switch (curve.GetType()) {
+        case GeomAbs_Line:
+            break;  // the chord IS the curve
+        case GeomAbs_Circle: {
+            const double r = curve.Circle().Radius();
+            // Clamp the chord-exact step to a quarter turn: with tol >= r
+            // it would otherwise span the whole parameter range, and a
+            // closed circle would collapse to a single chord whose
+            // endpoints coincide.
+            double step = 1.5707963267948966;  // π/2
+            if (tol < r) {
+                const double exact = 2.0 * std::acos(1.0 - tol / r);
+                if (exact < step) step = exact;
+            }
+            segments = (size_t)std::ceil((t1 - t0) / step);
+            if (segments < 1) segments = 1;
+            break;
+        }
+        default: {
+            GCPnts_UniformDeflection walker(curve, tol, t0, t1);
+            if (!walker.IsDone() || walker.NbPoints() < 2)
+                throw std::runtime_error("edge discretization failed");
+            const int n = walker.NbPoints();
+            pts.reserve(pts.size() + (size_t)n);
+            params.reserve(params.size() + (size_t)n);
+            for (int i = 1; i <= n; ++i) {
+                const gp_Pnt p = walker.Value(i);
+                pts.push_back(CgPoint3{p.X(), p.Y(), p.Z()});
+                params.push_back(walker.Parameter(i));
+            }
+            return;
+        }
+    }
+
+    pts.reserve(pts.size() + segments + 1);
+    params.reserve(params.size() + segments + 1);
+    for (size_t i = 0; i <= segments; ++i) {
+        const double t =
+            (i == segments) ? t1 : t0 + (t1 - t0) * (double)i / (double)segments;
+        const gp_Pnt p = curve.Value(t);
+        pts.push_back(CgPoint3{p.X(), p.Y(), p.Z()});
+        params.push_back(t);
+    }
+}
+
+CgError cg_edge_discretize(CgEdgeId id, double chord_tol,
+                            CgPoint3** out_points, double** out_params,
+                            size_t* out_count) {
+    if (out_points) *out_points = nullptr;
+    if (out_params) *out_params = nullptr;
+    if (out_count)  *out_count  = 0;
+    if (!out_points || !out_count) {
+        set_last_error("cg_edge_discretize: null output pointer");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (!(chord_tol > 0.0)) {
+        set_last_error("cg_edge_discretize: chord_tol must be positive");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_edge_discretize: null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    try {
+        perf_counters::Scope perf(perf_counters::kEval);
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        const TopoDS_Edge edge = TopoDS::Edge(shape);
+
+        std::vector<CgPoint3> pts;
+        std::vector<double> params;
+        discretize_edge(edge, chord_tol, pts, params);
+        perf.add_bytes(pts.size() * sizeof(CgPoint3));
+
+        CgPoint3* p = new CgPoint3[pts.size()];
+        std::memcpy(p, pts.data(), pts.size() * sizeof(CgPoint3));
+        *out_points = p;
+        if (out_params) {
+            double* t = new double[params.size()];
+            std::memcpy(t, params.data(), params.size() * sizeof(double));
+            *out_params = t;
+        }
+        *out_count = pts.size();
+        return CG_OK;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_edge_discretize: invalid edge ID");
+        return CG_ERR_NULL_HANDLE;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Discretize exception: ") +
+                       ex.GetMessageString());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Discretize std::exception: ") + ex.what());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (...) {
+        set_last_error("Discretize: unknown exception");
+        return CG_ERR_OCCT_EXCEPTION;
+    }
+}
+
+CgError cg_edge_discretize_batch(const CgEdgeId* edges, size_t n_edges,
+                                  double chord_tol, CgPoint3** out_points,
+                                  double** out_params,
+                                  size_t** out_edge_counts) {
+    if (out_points)      *out_points      = nullptr;
+    if (out_params)      *out_params      = nullptr;
+    if (out_edge_counts) *out_edge_counts = nullptr;
+    if (!edges || !out_points || !out_edge_counts) {
+        set_last_error("cg_edge_discretize_batch: null argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (!(chord_tol > 0.0)) {
+        set_last_error("cg_edge_discretize_batch: chord_tol must be positive");
+        return CG_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < n_edges; ++i) {
+        if (edges[i] == CG_NULL_ID) {
+            set_last_error("cg_edge_discretize_batch: null handle in array");
+            return CG_ERR_NULL_HANDLE;
+        }
+    }
+    try {
+        perf_counters::Scope perf(perf_counters::kEval);
+
+        // Resolve handles up front, serially — the registry lock is not
+        // worth contending for from the workers.
+        std::vector<TopoDS_Edge> resolved(n_edges);
+        for (size_t i = 0; i < n_edges; ++i)
+            resolved[i] = TopoDS::Edge(registry_get_shape(edges[i]));
+
+        std::vector<std::vector<CgPoint3>> pts(n_edges);
+        std::vector<std::vector<double>> params(n_edges);
+        worker_pool::parallel_for(n_edges, 4, [&](size_t i) {
+            discretize_edge(resolved[i], chord_tol, pts[i], params[i]);
+        });
+
+        size_t total = 0;
+        for (size_t i = 0; i < n_edges; ++i) total += pts[i].size();
+        perf.add_bytes(total * sizeof(CgPoint3));
+
+        CgPoint3* p = new CgPoint3[total];
+        size_t* counts = new size_t[n_edges];
+        double* t = out_params ? new double[total] : nullptr;
+        size_t at = 0;
+        for (size_t i = 0; i < n_edges; ++i) {
+            counts[i] = pts[i].size();
+            std::memcpy(p + at, pts[i].data(),
+                        pts[i].size() * sizeof(CgPoint3));
+            if (t)
+                std::memcpy(t + at, params[i].data(),
+                            params[i].size() * sizeof(double));
+            at += pts[i].size();
+        }
+        *out_points = p;
+        *out_edge_counts = counts;
+        if (out_params) *out_params = t;
+        return CG_OK;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_edge_discretize_batch: invalid edge ID");
+        return CG_ERR_NULL_HANDLE;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Discretize exception: ") +
+                       ex.GetMessageString());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Discretize std::exception: ") + ex.what());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (...) {
+        set_last_error("Discretize: unknown exception");
+        return CG_ERR_OCCT_EXCEPTION;
+    }
+}
+
+void cg_params_free(double* params) {
+    delete[] params;
+}
+
+/* ── Geometric queries ───────────────────────────────────────────────────── */
+
+// Distance queries accelerate through a per-shape triangle BVH built over a
+// fixed-tolerance tessellation on the first query and cached until the
+// shape is freed, so repeat clearance checks cost only the pair traversal.
+// BRepMesh keeps an existing finer triangulation, so a shape the caller has
+// already tessellated tightly is not re-meshed.
+static const double kDistanceChordTol = 0.05;
+static const double kDistanceAngleTol = 0.5;
+
+static std::shared_mutex g_distance_bvh_mutex;
+static std::unordered_map<uint64_t, std::shared_ptr<const TriangleBvh>>
+    g_distance_bvh;
+
+static void distance_bvh_invalidate(uint64_t id) {
+    std::unique_lock<std::shared_mutex> lock(g_distance_bvh_mutex);
+    g_distance_bvh.erase(id);
+}
+
+static std::shared_ptr<const TriangleBvh> distance_bvh_for(uint64_t id) {
+    {
+        std::shared_lock<std::shared_mutex> lock(g_distance_bvh_mutex);
+        auto it = g_distance_bvh.find(id);
+        if (it != g_distance_bvh.end()) return it->second;
+    }
+
+    const TopoDS_Shape& shape = registry_get_shape(id);  // throws out_of_range
+    BRepMesh_IncrementalMesh mesher(shape, kDistanceChordTol,
+                                    /*isRelative=*/Standard_False,
+                                    kDistanceAngleTol,
+                                    /*isParallel=*/worker_pool::effective() > 1);
+    if (!mesher.IsDone())
+        throw std::runtime_error("mesher did not complete");
+
+    std::vector<double>   verts;
+    std::vector<uint32_t> indices;
+    for (TopExp_Explorer ex(shape, TopAbs_FACE); ex.More(); ex.Next()) {
+        const TopoDS_Face& face = TopoDS::Face(ex.Current());
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) tri = BRep_Tool::Triangulation(face, loc);
+        if (tri.IsNull()) continue;
+        const uint32_t base = static_cast<uint32_t>(verts.size() / 3);
+        const gp_Trsf& trsf = loc.Transformation();
+        for (int i = 1; i <= tri->NbNodes(); ++i) {
+            gp_Pnt p = tri->Node(i);
+            p.Transform(trsf);
+            verts.push_back(p.X());
+            verts.push_back(p.Y());
+            verts.push_back(p.Z());
+        }
+        // Winding is irrelevant for distance, so face orientation is ignored.
+        for (int t = 1; t <= tri->NbTriangles(); ++t) {
+            Standard_Integer n1, n2, n3;
+            tri->Triangle(t).Get(n1, n2, n3);
+            indices.push_back(base + static_cast<uint32_t>(n1 - 1));
+            indices.push_back(base + static_cast<uint32_t>(n2 - 1));
+            indices.push_back(base + static_cast<uint32_t>(n3 - 1));
+        }
+    }
+
+    auto bvh = std::make_shared<TriangleBvh>();
+    bvh->build(verts.data(), indices.data(), indices.size() / 3);
+
+    std::unique_lock<std::shared_mutex> lock(g_distance_bvh_mutex);
+    // A concurrent first query may have raced us here; keep the incumbent so
+    // both callers share one tree.
+    auto inserted = g_distance_bvh.emplace(id, std::move(bvh));
+    return inserted.first->second;
+}
+
+double cg_shape_distance(CgShapeId a, CgShapeId b) {
+    if (a == CG_NULL_ID || b == CG_NULL_ID) {
+        set_last_error("cg_shape_distance: null handle");
+        return -1.0;
+    }
+    try {
+        auto bvh_a = distance_bvh_for(a);
+        auto bvh_b = distance_bvh_for(b);
+        const double d = bvh_a->distance_to(*bvh_b);
+        if (d < 0.0) {
+            set_last_error("cg_shape_distance: shape produced no triangles");
+            return -1.0;
+        }
+        return d;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_shape_distance: invalid shape ID");
+        return -1.0;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Distance exception: ") +
+                       ex.GetMessageString());
+        return -1.0;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Distance std::exception: ") + ex.what());
+        return -1.0;
+    } catch (...) {
+        set_last_error("Distance: unknown exception");
+        return -1.0;
+    }
+}
+
+CgError cg_shape_distance_batch(CgShapeId fixed_shape, CgShapeId moving,
+                                 const double* transforms,
+                                 size_t n_transforms,
+                                 double* out_distances) {
+    if (!transforms || !out_distances) {
+        set_last_error("cg_shape_distance_batch: null array");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (fixed_shape == CG_NULL_ID || moving == CG_NULL_ID) {
+        set_last_error("cg_shape_distance_batch: null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    try {
+        auto bvh_fixed  = distance_bvh_for(fixed_shape);
+        auto bvh_moving = distance_bvh_for(moving);
+        if (bvh_fixed->empty() || bvh_moving->empty()) {
+            set_last_error(
+                "cg_shape_distance_batch: shape produced no triangles");
+            return CG_ERR_NO_RESULT;
+        }
+        worker_pool::parallel_for(n_transforms, 1, [&](size_t i) {
+            out_distances[i] =
+                bvh_fixed->distance_to(*bvh_moving, transforms + i * 12);
+        });
+        return CG_OK;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_shape_distance_batch: invalid shape ID");
+        return CG_ERR_NULL_HANDLE;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Distance exception: ") +
+                       ex.GetMessageString());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Distance std::exception: ") + ex.what());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (...) {
+        set_last_error("Distance: unknown exception");
+        return CG_ERR_OCCT_EXCEPTION;
+    }
+}
+
+// Default chord tolerance for the single-plane convenience API (mm).
+// The batched API takes the tolerance explicitly.
+static const double kSectionChordTol = 0.01;
+
+CgError cg_shape_section_at_z(CgShapeId id, double z_value,
+                               CgPoint3** out_points, size_t* out_count) {
+    if (out_points) *out_points = nullptr;
+    if (out_count)  *out_count  = 0;
+    if (id == CG_NULL_ID || !out_points || !out_count) {
+        set_last_error("cg_shape_section_at_z: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    perf_counters::Scope perf(perf_counters::kSection);
+    try {
+        // One-shot slicer: build the Z-interval table just for this call.
+        CgSlicerData slicer;
+        slicer.shape = registry_get_shape(id);
+        slicer_build_faces(slicer.shape, slicer.faces);
+
+        std::vector<CgPoint3> pts;
+        slicer_section_level(slicer, z_value, kSectionChordTol, pts);
+        if (pts.empty()) {
+            set_last_error("cg_shape_section_at_z: no intersection");
+            return CG_ERR_NO_RESULT;
+        }
+
+        CgPoint3* result = new CgPoint3[pts.size()];
+        std::memcpy(result, pts.data(), pts.size() * sizeof(CgPoint3));
+        *out_points = result;
+        *out_count  = pts.size();
+        perf.add_bytes(pts.size() * sizeof(CgPoint3));
+        return CG_OK;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_shape_section_at_z: invalid shape ID");
+        return CG_ERR_NULL_HANDLE;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Section exception: ") + ex.GetMessageString());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Section std::exception: ") + ex.what());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (...) {
+        set_last_error("Section: unknown exception");
+        return CG_ERR_OCCT_EXCEPTION;
+    }
+}
+
+void cg_section_free(CgPoint3* points) {
+    delete[] points;
+}
+
+/* ── Batched multi-plane sectioning ──────────────────────────────────────── */
+
+CgSlicerId cg_slicer_new(CgShapeId id) {
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_slicer_new: null handle");
+        return CG_NULL_ID;
+    }
+    try {
+        auto slicer = std::make_shared<CgSlicerData>();
+        slicer->shape = registry_get_shape(id);
+        slicer_build_faces(slicer->shape, slicer->faces);
+        if (slicer->faces.empty()) {
+            set_last_error("cg_slicer_new: shape has no faces");
+            return CG_NULL_ID;
+        }
+        return slicer_store_insert(std::move(slicer));
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_slicer_new: invalid shape ID");
+        return CG_NULL_ID;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Slicer exception: ") + ex.GetMessageString());
+        return CG_NULL_ID;
+    } catch (...) {
+        set_last_error("Slicer: unknown exception");
+        return CG_NULL_ID;
+    }
+}
+
+void cg_slicer_free(CgSlicerId id) {
+    if (id == CG_NULL_ID) return;
+    slicer_store_erase(id);
+}
+
+CgError cg_slicer_section_multi_z(CgSlicerId id,
+                                   const double* z_values, size_t n_levels,
+                                   double chord_tol,
+                                   CgPoint3** out_points,
+                                   size_t** out_level_counts) {
+    if (out_points)       *out_points       = nullptr;
+    if (out_level_counts) *out_level_counts = nullptr;
+    if (id == CG_NULL_ID || !z_values || !out_points || !out_level_counts) {
+        set_last_error("cg_slicer_section_multi_z: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    if (n_levels == 0 || chord_tol <= 0.0) {
+        set_last_error("cg_slicer_section_multi_z: invalid argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    auto slicer = slicer_store_get(id);
+    if (!slicer) {
+        set_last_error("cg_slicer_section_multi_z: invalid slicer ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    perf_counters::Scope perf(perf_counters::kSection);
+    try {
+        // Slice levels in parallel; each level writes only its own slot.
+        std::vector<std::vector<CgPoint3>> per_level(n_levels);
+
+        std::atomic<size_t> cursor{0};
+        std::mutex          err_mutex;
+        std::string         first_error;
+
+        auto worker = [&]() {
+            try {
+                for (size_t i = cursor.fetch_add(1, std::memory_order_relaxed);
+                     i < n_levels;
+                     i = cursor.fetch_add(1, std::memory_order_relaxed)) {
+                    slicer_section_level(*slicer, z_values[i], chord_tol,
+                                         per_level[i]);
+                }
+            } catch (const Standard_Failure& ex) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty())
+                    first_error = std::string("OCCT exception in slice: ") +
+                                  ex.GetMessageString();
+            } catch (const std::exception& ex) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty()) first_error = ex.what();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty()) first_error = "unknown exception in slice";
+            }
+        };
+
+        const size_t n_workers = std::min(worker_pool::effective(), n_levels);
+        if (n_workers > 1) worker_pool::note_batch(n_levels);
+        std::vector<std::thread> threads;
+        threads.reserve(n_workers - 1);
+        for (size_t w = 0; w + 1 < n_workers; ++w) threads.emplace_back(worker);
+        worker();
+        for (auto& t : threads) t.join();
+
+        if (!first_error.empty()) {
+            set_last_error(first_error);
+            return CG_ERR_OCCT_EXCEPTION;
+        }
+
+        // Concatenate levels in input order.
+        size_t total = 0;
+        for (const auto& lvl : per_level) total += lvl.size();
+
+        CgPoint3* points = new CgPoint3[total > 0 ? total : 1];
+        size_t*   counts = new size_t[n_levels];
+        size_t offset = 0;
+        for (size_t i = 0; i < n_levels; ++i) {
+            counts[i] = per_level[i].size();
+            if (!per_level[i].empty()) {
+                std::memcpy(points + offset, per_level[i].data(),
+                            per_level[i].size() * sizeof(CgPoint3));
+                offset += per_level[i].size();
+            }
+        }
+
+        *out_points       = points;
+        *out_level_counts = counts;
+        perf.add_bytes(total * sizeof(CgPoint3) + n_levels * sizeof(size_t));
+        return CG_OK;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Slice exception: ") + ex.GetMessageString());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Slice std::exception: ") + ex.what());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (...) {
+        set_last_error("Slice: unknown exception");
+        return CG_ERR_OCCT_EXCEPTION;
+    }
+}
+
+void cg_level_counts_free(size_t* counts) {
+    delete[] counts;
+}
+
+/* ── Chained section loops ───────────────────────────────────────────────── */
+
+// Endpoint-matching tolerance for loop chaining (mm).  Section edges that
+// share a B-rep vertex coincide to well below this; distinct boundary points
+// on real parts are orders of magnitude farther apart.
+static const double kSectionJoinTol = 1e-4;
+
+CgError cg_shape_section_loops_at_z(CgShapeId id, double z_value,
+                                     CgPoint3** out_points,
+                                     size_t** out_loop_counts,
+                                     size_t* out_n_loops) {
+    if (out_points)      *out_points      = nullptr;
+    if (out_loop_counts) *out_loop_counts = nullptr;
+    if (out_n_loops)     *out_n_loops     = 0;
+    if (id == CG_NULL_ID || !out_points || !out_loop_counts || !out_n_loops) {
+        set_last_error("cg_shape_section_loops_at_z: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    perf_counters::Scope perf(perf_counters::kSection);
+    try {
+        CgSlicerData slicer;
+        slicer.shape = registry_get_shape(id);
+        slicer_build_faces(slicer.shape, slicer.faces);
+
+        std::vector<CgPoint3> segs;
+        slicer_section_level(slicer, z_value, kSectionChordTol, segs);
+        if (segs.empty()) {
+            set_last_error("cg_shape_section_loops_at_z: no intersection");
+            return CG_ERR_NO_RESULT;
+        }
+
+        auto loops = chain_section_segments(segs, kSectionJoinTol);
+
+        size_t total = 0;
+        for (const auto& loop : loops) total += loop.size();
+
+        CgPoint3* points = new CgPoint3[total];
+        size_t*   counts = new size_t[loops.size()];
+        size_t offset = 0;
+        for (size_t i = 0; i < loops.size(); ++i) {
+            counts[i] = loops[i].size();
+            std::memcpy(points + offset, loops[i].data(),
+                        loops[i].size() * sizeof(CgPoint3));
+            offset += loops[i].size();
+        }
+
+        *out_points      = points;
+        *out_loop_counts = counts;
+        *out_n_loops     = loops.size();
+        perf.add_bytes(total * sizeof(CgPoint3) +
+                       loops.size() * sizeof(size_t));
+        return CG_OK;
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_shape_section_loops_at_z: invalid shape ID");
+        return CG_ERR_NULL_HANDLE;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Section exception: ") + ex.GetMessageString());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Section std::exception: ") + ex.what());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (...) {
+        set_last_error("Section: unknown exception");
+        return CG_ERR_OCCT_EXCEPTION;
+    }
+}
+
+CgError cg_slicer_section_loops_multi_z(CgSlicerId id,
+                                         const double* z_values,
+                                         size_t n_levels,
+                                         double chord_tol,
+                                         CgPoint3** out_points,
+                                         size_t** out_loop_counts,
+                                         size_t** out_level_loop_counts) {
+    if (out_points)            *out_points            = nullptr;
+    if (out_loop_counts)       *out_loop_counts       = nullptr;
+    if (out_level_loop_counts) *out_level_loop_counts = nullptr;
+    if (id == CG_NULL_ID || !z_values || !out_points || !out_loop_counts ||
+        !out_level_loop_counts) {
+        set_last_error("cg_slicer_section_loops_multi_z: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    if (n_levels == 0 || chord_tol <= 0.0) {
+        set_last_error("cg_slicer_section_loops_multi_z: invalid argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    auto slicer = slicer_store_get(id);
+    if (!slicer) {
+        set_last_error("cg_slicer_section_loops_multi_z: invalid slicer ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    perf_counters::Scope perf(perf_counters::kSection);
+    try {
+        // Section and chain each level in parallel; chaining happens in the
+        // worker, next to the segment data, so only finished loops cross the
+        // FFI.
+        std::vector<std::vector<std::vector<CgPoint3>>> per_level(n_levels);
+
+        std::atomic<size_t> cursor{0};
+        std::mutex          err_mutex;
+        std::string         first_error;
+
+        auto worker = [&]() {
+            try {
+                for (size_t i = cursor.fetch_add(1, std::memory_order_relaxed);
+                     i < n_levels;
+                     i = cursor.fetch_add(1, std::memory_order_relaxed)) {
+                    std::vector<CgPoint3> segs;
+                    slicer_section_level(*slicer, z_values[i], chord_tol, segs);
+                    if (!segs.empty()) {
+                        per_level[i] =
+                            chain_section_segments(segs, kSectionJoinTol);
+                    }
+                }
+            } catch (const Standard_Failure& ex) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty())
+                    first_error = std::string("OCCT exception in slice: ") +
+                                  ex.GetMessageString();
+            } catch (const std::exception& ex) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty()) first_error = ex.what();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(err_mutex);
+                if (first_error.empty()) first_error = "unknown exception in slice";
+            }
+        };
+
+        const size_t n_workers = std::min(worker_pool::effective(), n_levels);
+        if (n_workers > 1) worker_pool::note_batch(n_levels);
+        std::vector<std::thread> threads;
+        threads.reserve(n_workers - 1);
+        for (size_t w = 0; w + 1 < n_workers; ++w) threads.emplace_back(worker);
+        worker();
+        for (auto& t : threads) t.join();
+
+        if (!first_error.empty()) {
+            set_last_error(first_error);
+            return CG_ERR_OCCT_EXCEPTION;
+        }
+
+        size_t total_points = 0;
+        size_t total_loops  = 0;
+        for (const auto& loops : per_level) {
+            total_loops += loops.size();
+            for (const auto& loop : loops) total_points += loop.size();
+        }
+
+        CgPoint3* points      = new CgPoint3[total_points > 0 ? total_points : 1];
+        size_t*   loop_counts = new size_t[total_loops > 0 ? total_loops : 1];
+        size_t*   level_loops = new size_t[n_levels];
+        size_t p_off = 0, l_off = 0;
+        for (size_t i = 0; i < n_levels; ++i) {
+            level_loops[i] = per_level[i].size();
+            for (const auto& loop : per_level[i]) {
+                loop_counts[l_off++] = loop.size();
+                std::memcpy(points + p_off, loop.data(),
+                            loop.size() * sizeof(CgPoint3));
+                p_off += loop.size();
+            }
+        }
+
+        *out_points            = points;
+        *out_loop_counts       = loop_counts;
+        *out_level_loop_counts = level_loops;
+        perf.add_bytes(total_points * sizeof(CgPoint3) +
+                       (total_loops + n_levels) * sizeof(size_t));
+        return CG_OK;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Slice exception: ") + ex.GetMessageString());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Slice std::exception: ") + ex.what());
+        return CG_ERR_OCCT_EXCEPTION;
+    } catch (...) {
+        set_last_error("Slice: unknown exception");
+        return CG_ERR_OCCT_EXCEPTION;
+    }
+}
+
+/* ── Feature detection ───────────────────────────────────────────────────── */
+
+// Per-shape face-classification table.  One parallel sweep over the faces
+// records surface type, oriented axis/normal, origin, radius, angular and
+// axial extents, and area in structure-of-arrays form; the table is cached
+// until the shape is freed, so hole and planar-face detection are filtered
+// scans of resident arrays and re-detection after a parameter change never
+// touches OCCT geometry again.
+struct FaceClassTable {
+    std::vector<TopoDS_Face>   faces;
+    std::vector<CgSurfaceType> types;
+    std::vector<double>        axis;    // 3 per face: plane normal / cyl axis
+    std::vector<double>        origin;  // 3 per face: centroid / axis foot
+    std::vector<double>        radius;  // cylinders (0 otherwise)
+    std::vector<double>        area;    // mm²
+    std::vector<double>        span_u;  // cylinders: angular span (rad)
+    std::vector<double>        v0, v1;  // cylinders: extent along axis (mm)
+    std::vector<int>           concave; // cylinders: normal faces the axis
+
+    void resize(size_t n) {
+        faces.resize(n);
+        types.resize(n);
+        axis.resize(n * 3);
+        origin.resize(n * 3);
+        radius.resize(n);
+        area.resize(n);
+        span_u.resize(n);
+        v0.resize(n);
+        v1.resize(n);
+        concave.resize(n);
+    }
+};
+
+static std::shared_mutex g_face_table_mutex;
+static std::unordered_map<uint64_t, std::shared_ptr<const FaceClassTable>>
+    g_face_tables;
+
+static void face_table_invalidate(uint64_t id) {
+    std::unique_lock<std::shared_mutex> lock(g_face_table_mutex);
+    g_face_tables.erase(id);
+}
+
+// Fill row i of the table from one face.  Writes only slot i, so the sweep
+// runs rows in parallel without coordination.
+static void classify_face(const TopoDS_Face& face, size_t i,
+                          FaceClassTable& t) {
+    BRepAdaptor_Surface surf(face);
+    t.types[i] = surface_type_of(surf);
+
+    GProp_GProps props;
+    BRepGProp::SurfaceProperties(face, props);
+    t.area[i] = props.Mass();
+    const gp_Pnt centroid = props.CentreOfMass();
+
+    t.radius[i]  = 0.0;
+    t.span_u[i]  = 0.0;
+    t.v0[i]      = 0.0;
+    t.v1[i]      = 0.0;
+    t.concave[i] = 0;
+
+    const double face_sign =
+        (face.Orientation() == TopAbs_REVERSED) ? -1.0 : 1.0;
+
+    if (t.types[i] == CG_SURF_PLANE) {
+        const gp_Pln pln = surf.Plane();
+        // Natural parametric normal, then the face orientation on top of it.
+        const double sign =
+            face_sign * (pln.Position().Direct() ? 1.0 : -1.0);
+        const gp_Dir n = pln.Position().Direction();
+        t.axis[i * 3 + 0] = n.X() * sign;
+        t.axis[i * 3 + 1] = n.Y() * sign;
+        t.axis[i * 3 + 2] = n.Z() * sign;
+        t.origin[i * 3 + 0] = centroid.X();
+        t.origin[i * 3 + 1] = centroid.Y();
+        t.origin[i * 3 + 2] = centroid.Z();
+        return;
+    }
+
+    if (t.types[i] == CG_SURF_CYLINDER) {
+        const gp_Cylinder cyl = surf.Cylinder();
+        const gp_Dir a = cyl.Axis().Direction();
+        t.radius[i] = cyl.Radius();
+        t.axis[i * 3 + 0] = a.X();
+        t.axis[i * 3 + 1] = a.Y();
+        t.axis[i * 3 + 2] = a.Z();
+        const gp_Pnt loc = cyl.Location();
+        t.origin[i * 3 + 0] = loc.X();
+        t.origin[i * 3 + 1] = loc.Y();
+        t.origin[i * 3 + 2] = loc.Z();
+        double umin, umax, vmin, vmax;
+        BRepTools::UVBounds(face, umin, umax, vmin, vmax);
+        t.span_u[i] = umax - umin;
+        t.v0[i]     = vmin;
+        t.v1[i]     = vmax;
+        // The natural normal points away from the axis on a direct frame;
+        // after the face orientation, an inward normal marks a bore wall.
+        const double outward = cyl.Position().Direct() ? 1.0 : -1.0;
+        t.concave[i] = (face_sign * outward < 0.0) ? 1 : 0;
+        return;
+    }
+
+    // Everything else: type and area only.
+    t.axis[i * 3 + 0] = t.axis[i * 3 + 1] = t.axis[i * 3 + 2] = 0.0;
+    t.origin[i * 3 + 0] = centroid.X();
+    t.origin[i * 3 + 1] = centroid.Y();
+    t.origin[i * 3 + 2] = centroid.Z();
+}
+
+static std::shared_ptr<const FaceClassTable> face_table_for(uint64_t id) {
+    {
+        std::shared_lock<std::shared_mutex> lock(g_face_table_mutex);
+        auto it = g_face_tables.find(id);
+        if (it != g_face_tables.end()) return it->second;
+    }
+
+    const TopoDS_Shape& shape = registry_get_shape(id);  // throws out_of_range
+    std::vector<TopoDS_Face> faces;
+    for (TopExp_Explorer ex(shape, TopAbs_FACE); ex.More(); ex.Next())
+        faces.push_back(TopoDS::Face(ex.Current()));
+
+    auto table = std::make_shared<FaceClassTable>();
+    table->resize(faces.size());
+    worker_pool::parallel_for(faces.size(), 16, [&](size_t i) {
+        table->faces[i] = faces[i];
+        classify_face(faces[i], i, *table);
+    });
+
+    std::unique_lock<std::shared_mutex> lock(g_face_table_mutex);
+    // Keep the incumbent if a concurrent first scan raced us here.
+    auto inserted = g_face_tables.emplace(id, std::move(table));
+    return inserted.first->second;
+}
+
+size_t cg_shape_find_holes(CgShapeId id,
+                            double min_diameter, double max_diameter,
+                            CgHoleInfo** out_holes) {
+    if (out_holes) *out_holes = nullptr;
+    if (id == CG_NULL_ID || !out_holes) {
+        set_last_error("cg_shape_find_holes: null argument");
+        return 0;
+    }
+    if (min_diameter < 0.0 || max_diameter < min_diameter) {
+        set_last_error("cg_shape_find_holes: invalid diameter range");
+        return 0;
+    }
+    try {
+        auto table = face_table_for(id);
+
+        // Group concave cylinder walls by axis line and radius — STEP
+        // exporters routinely split a bore into two half-cylinders.  The
+        // line is keyed by its canonical direction and the foot of the
+        // perpendicular from the world origin.
+        struct Group {
+            gp_XYZ  foot;
+            gp_XYZ  dir;
+            double  radius;
+            double  span;
+            double  lo, hi;  // extent along dir, absolute
+        };
+        static const double kAxisDotTol = 1.0 - 1e-9;
+        static const double kCoaxTol    = 1e-4;  // mm
+        std::vector<Group> groups;
+
+        for (size_t i = 0; i < table->faces.size(); ++i) {
+            if (table->types[i] != CG_SURF_CYLINDER || !table->concave[i])
+                continue;
+            gp_XYZ dir(table->axis[i * 3], table->axis[i * 3 + 1],
+                       table->axis[i * 3 + 2]);
+            double lo = table->v0[i];
+            double hi = table->v1[i];
+            // Canonical direction sign so halves with flipped axes merge.
+            if (dir.Z() < 0.0 ||
+                (dir.Z() == 0.0 &&
+                 (dir.X() < 0.0 || (dir.X() == 0.0 && dir.Y() < 0.0)))) {
+                dir.Reverse();
+                const double tmp = lo;
+                lo = -hi;
+                hi = -tmp;
+            }
+            const gp_XYZ loc(table->origin[i * 3], table->origin[i * 3 + 1],
+                             table->origin[i * 3 + 2]);
+            const double along = loc.Dot(dir);
+            const gp_XYZ foot  = loc - dir * along;
+            lo += along;
+            hi += along;
+
+            bool merged = false;
+            for (Group& g : groups) {
+                if (g.dir.Dot(dir) < kAxisDotTol) continue;
+                if (std::fabs(g.radius - table->radius[i]) > kCoaxTol)
+                    continue;
+                if ((g.foot - foot).Modulus() > kCoaxTol) continue;
+                g.span += table->span_u[i];
+                g.lo = std::min(g.lo, lo);
+                g.hi = std::max(g.hi, hi);
+                merged = true;
+                break;
+            }
+            if (!merged)
+                groups.push_back({foot, dir, table->radius[i],
+                                  table->span_u[i], lo, hi});
+        }
+
+        // Through-hole test: the bore spans the whole shape along its axis.
+        const TopoDS_Shape& shape = registry_get_shape(id);
+        Bnd_Box box;
+        BRepBndLib::AddOptimal(shape, box);
+        double bx[2], by[2], bz[2];
+        box.Get(bx[0], by[0], bz[0], bx[1], by[1], bz[1]);
+
+        static const double kFullCircle  = 6.283185307179586 - 1e-3;
+        static const double kThroughTol  = 1e-3;  // mm
+        std::vector<CgHoleInfo> holes;
+        for (const Group& g : groups) {
+            const double diameter = 2.0 * g.radius;
+            if (g.span < kFullCircle) continue;
+            if (diameter < min_diameter || diameter > max_diameter) continue;
+
+            double smin = std::numeric_limits<double>::infinity();
+            double smax = -std::numeric_limits<double>::infinity();
+            for (int c = 0; c < 8; ++c) {
+                const gp_XYZ corner(bx[c & 1], by[(c >> 1) & 1],
+                                    bz[(c >> 2) & 1]);
+                const double s = corner.Dot(g.dir);
+                smin = std::min(smin, s);
+                smax = std::max(smax, s);
+            }
+            const bool through =
+                g.lo <= smin + kThroughTol && g.hi >= smax - kThroughTol;
+
+            // Report the centre at the upper end of the bore, axis pointing
+            // up and out of it.
+            gp_XYZ dir = g.dir;
+            double top = g.hi;
+            if (dir.Z() < 0.0) {  // cannot happen post-canonicalization
+                dir.Reverse();
+                top = -g.lo;
+            }
+            const gp_XYZ center = g.foot + dir * top;
+
+            CgHoleInfo h;
+            h.center     = CgPoint3{center.X(), center.Y(), center.Z()};
+            h.axis       = CgVec3{dir.X(), dir.Y(), dir.Z()};
+            h.diameter   = diameter;
+            h.depth      = g.hi - g.lo;
+            h.is_through = through ? 1 : 0;
+            holes.push_back(h);
+        }
+
+        if (holes.empty()) {
+            *out_holes = nullptr;
+            return 0;
+        }
+        CgHoleInfo* result = new CgHoleInfo[holes.size()];
+        std::memcpy(result, holes.data(), holes.size() * sizeof(CgHoleInfo));
+        *out_holes = result;
+        return holes.size();
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_shape_find_holes: invalid shape ID");
+        return 0;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Hole detection exception: ") +
+                       ex.GetMessageString());
+        return 0;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Hole detection std::exception: ") +
+                       ex.what());
+        return 0;
+    } catch (...) {
+        set_last_error("Hole detection: unknown exception");
+        return 0;
+    }
+}
+
+void cg_holes_free(CgHoleInfo* holes) {
+    delete[] holes;
+}
+
+size_t cg_shape_find_planar_faces(CgShapeId id, CgPlanarFaceInfo** out_faces) {
+    if (out_faces) *out_faces = nullptr;
+    if (id == CG_NULL_ID || !out_faces) {
+        set_last_error("cg_shape_find_planar_faces: null argument");
+        return 0;
+    }
+    try {
+        auto table = face_table_for(id);
+
+        std::vector<CgPlanarFaceInfo> infos;
+        for (size_t i = 0; i < table->faces.size(); ++i) {
+            if (table->types[i] != CG_SURF_PLANE) continue;
+            CgPlanarFaceInfo info;
+            // Fresh handle per call, like cg_shape_faces — the caller frees
+            // each with cg_face_free().
+            info.face_id  = registry_store_shape(table->faces[i]);
+            info.normal   = CgVec3{table->axis[i * 3], table->axis[i * 3 + 1],
+                                   table->axis[i * 3 + 2]};
+            info.area     = table->area[i];
+            info.z_height = table->origin[i * 3 + 2];
+            infos.push_back(info);
+        }
+
+        if (infos.empty()) {
+            *out_faces = nullptr;
+            return 0;
+        }
+        CgPlanarFaceInfo* result = new CgPlanarFaceInfo[infos.size()];
+        std::memcpy(result, infos.data(),
+                    infos.size() * sizeof(CgPlanarFaceInfo));
+        *out_faces = result;
+        return infos.size();
+    } catch (const std::out_of_range&) {
+        set_last_error("cg_shape_find_planar_faces: invalid shape ID");
+        return 0;
+    } catch (const Standard_Failure& ex) {
+        set_last_error(std::string("Planar face exception: ") +
+                       ex.GetMessageString());
+        return 0;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Planar face std::exception: ") +
+                       ex.what());
+        return 0;
+    } catch (...) {
+        set_last_error("Planar face: unknown exception");
+        return 0;
+    }
+}
+
+void cg_planar_faces_free(CgPlanarFaceInfo* faces) {
+    delete[] faces;
+}
+
+/* ── 2D polygon operations — implemented in cam_polygon.cpp ──────────────── */
+
 } // extern "C"
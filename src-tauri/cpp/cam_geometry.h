@@ -44,6 +44,56 @@ typedef enum {
 // The returned pointer is valid until the next call on this thread.
 const char* cg_last_error_message(void);
 
+/* ── Threading ───────────────────────────────────────────────────────────── */
+
+// Snapshot of the kernel's worker budget and usage (see cg_pool_stats).
+typedef struct {
+    size_t   configured_threads;  // budget set by cg_set_worker_threads (0 = auto)
+    size_t   effective_threads;   // workers a parallel section may use now
+    uint64_t parallel_batches;    // parallel sections that actually forked
+    uint64_t tasks_executed;      // work items run inside those sections
+} CgPoolStats;
+
+// Bound the number of worker threads all parallel kernel features
+// (tessellation assembly, healing, batch evaluation, BVH/heightmap/stock
+// queries, STL parsing — and OCCT's own mesher parallelism) may use.
+// n == 0 restores the default (hardware concurrency).  Set this to carve
+// the machine up between the kernel and the host application's own pool.
+CgError cg_set_worker_threads(size_t n);
+
+// Snapshot the worker budget and lifetime usage counters.
+CgPoolStats cg_pool_stats(void);
+
+/* ── Instrumentation ─────────────────────────────────────────────────────── */
+
+// Per-subsystem performance counter (see cg_perf_counters_snapshot).
+// The hot entry points (import, tessellation, sectioning, polygon offset,
+// polygon booleans, batch surface eval) are always instrumented; the
+// per-call cost is a clock read and a few relaxed atomic adds.
+typedef struct {
+    const char* name;      // static subsystem name, e.g. "tessellate"
+    uint64_t    calls;     // entry-point invocations
+    uint64_t    total_ns;  // cumulative wall time
+    uint64_t    max_ns;    // slowest single call
+    uint64_t    bytes;     // output bytes produced (mesh buffers, polygons)
+} CgPerfCounter;
+
+// Copy up to `capacity` counters into `out` and return the number written.
+// Pass out == NULL to query the number of subsystems.
+size_t cg_perf_counters_snapshot(CgPerfCounter* out, size_t capacity);
+
+// Zero all counters and discard any captured trace events.
+CgError cg_perf_reset(void);
+
+// Toggle trace capture.  While enabled, each instrumented call records one
+// event into a fixed-size buffer (~16k events; capture stops when full).
+// Off by default; the counters above are unaffected by this switch.
+CgError cg_perf_trace_enable(int enabled);
+
+// Write the captured events to `path` in the chrome trace-event JSON
+// format (viewable in chrome://tracing or Perfetto).
+CgError cg_perf_trace_dump(const char* path);
+
 /* ── Primitive types ─────────────────────────────────────────────────────── */
 
 typedef struct { double x, y, z; }                             CgPoint3;
@@ -62,6 +112,24 @@ typedef uint64_t CgCurveId;
 // The null / invalid handle value.
 #define CG_NULL_ID UINT64_C(0)
 
+// Storage precision of a mesh's vertex and normal buffers.
+// Indices are always uint32 regardless of precision.
+typedef enum {
+    CG_MESH_F64 = 0,  // doubles — full accuracy for toolpath consumers
+    CG_MESH_F32 = 1,  // floats — half the memory/bandwidth for render meshes
+} CgMeshPrecision;
+
+// When a tessellated mesh materializes its per-vertex normal buffer.
+// Toolpath sampling reads only vertices and indices, so the default defers
+// the normal build to the first normal access (cg_mesh_copy_normals* /
+// cg_mesh_normals_ptr*); a mesh whose normals are never read never pays for
+// them, in CPU or memory.  Viewport meshes that are uploaded right after
+// tessellation should force the eager build instead.
+typedef enum {
+    CG_NORMALS_LAZY  = 0,  // build on first normal access (default)
+    CG_NORMALS_EAGER = 1,  // build during tessellation
+} CgNormalMode;
+
 // Surface type classification returned by cg_face_surface_type().
 typedef enum {
     CG_SURF_PLANE    = 0,
@@ -89,12 +157,93 @@ CgShapeId cg_load_iges(const char* path);
 // Returns CG_NULL_ID on failure.
 CgMeshId cg_load_stl(const char* path);
 
+// As cg_load_stl, but with an explicit storage precision and optional
+// vertex welding (weld_tol as in cg_shape_tessellate_welded; 0 keeps the
+// file's unshared 3-vertices-per-triangle layout).  Binary STL files are
+// memory-mapped and their fixed-size records parsed in parallel straight
+// into the final mesh layout — on large scanned-stock files this is
+// bounded by disk bandwidth rather than one core; ASCII files take the
+// ordinary reader.  cg_load_stl(p) == cg_load_stl_ex(p, CG_MESH_F64, 0).
+CgMeshId cg_load_stl_ex(const char* path, CgMeshPrecision precision,
+                        double weld_tol);
+
 // Free a shape and remove it from the registry.
 void cg_shape_free(CgShapeId id);
 
+// Enable the binary shape cache.  After a successful STEP import, the healed
+// shape is persisted to <dir>/<content-hash>.bbrep in OCCT's binary BRep
+// format; later cg_load_step() calls whose source file hashes identically
+// load the sidecar directly, skipping the parse and heal passes.  The cache
+// key is a hash of the file CONTENTS, so a re-exported or edited STEP file
+// never matches a stale sidecar.  Pass NULL to disable caching.
+// The directory must already exist; cache write failures are silently
+// ignored (the import itself still succeeds).
+CgError cg_shape_cache_set_dir(const char* dir);
+
+/* ── Asynchronous import ─────────────────────────────────────────────────── */
+
+// Opaque handle to an in-flight import job.
+typedef uint64_t CgJobId;
+
+// Lifecycle of an import job.
+typedef enum {
+    CG_JOB_RUNNING   = 0,
+    CG_JOB_DONE      = 1,
+    CG_JOB_FAILED    = 2,
+    CG_JOB_CANCELLED = 3,
+} CgJobStatus;
+
+// Start a STEP import on a kernel-owned worker thread and return immediately.
+// The worker holds the global STEP mutex only for the schema-registry window
+// (read + transfer), so tessellation and slicing of already-loaded shapes
+// keep running while the import is in flight.  Uses the binary shape cache
+// when enabled (see cg_shape_cache_set_dir).
+// Returns CG_NULL_ID on failure (e.g. null path).
+CgJobId cg_load_step_async(const char* path);
+
+// Poll the job state.  Returns CG_JOB_FAILED for an unknown job ID.
+CgJobStatus cg_job_status(CgJobId id);
+
+// Coarse progress in [0, 1], advancing at phase boundaries
+// (read -> transfer -> heal -> store).  Returns 0 for an unknown job ID.
+double cg_job_progress(CgJobId id);
+
+// Request cancellation.  OCCT's reader calls are not interruptible, so the
+// request takes effect at the next phase boundary; a job that has already
+// completed stays CG_JOB_DONE.  Safe to call repeatedly.
+CgError cg_job_cancel(CgJobId id);
+
+// Return the imported shape of a CG_JOB_DONE job.  The caller owns the shape
+// (free with cg_shape_free); the job handle itself must still be freed with
+// cg_job_free.  Returns CG_NULL_ID (and sets the error string) for a job
+// that is running, failed, or was cancelled.
+CgShapeId cg_job_shape(CgJobId id);
+
+// Free the job handle.  If the job is still running this blocks until the
+// worker finishes; cancel first to make it return at the next phase
+// boundary.  A completed shape that was never taken via cg_job_shape() is
+// freed along with the job; a shape already returned stays owned by the
+// caller.
+void cg_job_free(CgJobId id);
+
 /* ── Shape healing ───────────────────────────────────────────────────────── */
 
+// How much fixing the healing pipeline applies.
+typedef enum {
+    CG_HEAL_NONE  = 0,  // trust the file — skip healing entirely
+    CG_HEAL_BASIC = 1,  // structural fixes only; skips the expensive
+                        // same-parameter recomputation
+    CG_HEAL_FULL  = 2,  // complete ShapeFix pipeline (default)
+} CgHealLevel;
+
+// Set the healing level used by cg_shape_heal() and by the import pipeline
+// (cg_load_step / cg_load_step_async).  Lets trusted files skip fixes that
+// dominate import time.  Returns CG_ERR_INVALID_ARG for an unknown level.
+CgError cg_shape_heal_set_level(CgHealLevel level);
+
 // Attempt to repair a shape (fix tolerances, sew shells, remove duplicates).
+// Compounds are exploded and their sub-shapes healed in parallel across a
+// worker pool, then re-assembled in the original order.
 // Returns a new handle to the healed shape.  Caller must free the original.
 // Returns CG_NULL_ID on failure.
 CgShapeId cg_shape_heal(CgShapeId id);
@@ -128,6 +277,59 @@ void cg_edge_free(CgEdgeId id);
 // Returns CG_NULL_ID on failure.
 CgMeshId cg_shape_tessellate(CgShapeId id, double chord_tol, double angle_tol);
 
+// As cg_shape_tessellate, but with an explicit storage precision.
+// CG_MESH_F32 assembles float32 vertex/normal buffers directly (no double
+// intermediate), halving mesh memory — intended for viewport meshes whose
+// only destination is a GPU upload.  cg_shape_tessellate(id, c, a) is
+// equivalent to cg_shape_tessellate_ex(id, c, a, CG_MESH_F64).
+CgMeshId cg_shape_tessellate_ex(CgShapeId id, double chord_tol,
+                                 double angle_tol, CgMeshPrecision precision);
+
+// As cg_shape_tessellate_ex, but welds vertices closer than weld_tol during
+// assembly.  Face tessellations share no nodes, so every B-rep edge otherwise
+// duplicates its vertices and normal smoothing stops at face seams; welding
+// merges the duplicates (and their accumulated normals) through a spatial
+// hash.  weld_tol == 0 disables welding (identical to cg_shape_tessellate_ex
+// — keep that for callers that need per-face vertex attribution).
+CgMeshId cg_shape_tessellate_welded(CgShapeId id, double chord_tol,
+                                    double angle_tol,
+                                    CgMeshPrecision precision,
+                                    double weld_tol);
+
+// As cg_shape_tessellate_welded, but with an explicit normal mode.  All the
+// entry points above default to CG_NORMALS_LAZY: the normal buffer does not
+// exist until the first normal access, which builds and caches it (parallel
+// under the worker budget).  Pass CG_NORMALS_EAGER for a viewport mesh whose
+// normals are uploaded immediately, so the build lands inside the
+// tessellation call.
+CgMeshId cg_shape_tessellate_welded_ex(CgShapeId id, double chord_tol,
+                                       double angle_tol,
+                                       CgMeshPrecision precision,
+                                       double weld_tol,
+                                       CgNormalMode normal_mode);
+
+/* Tessellation fragment cache.  Every tessellation entry point above caches
+ * the finished per-face mesh fragment, keyed by the face's underlying
+ * geometry, placement, and the (chord_tol, angle_tol) pair, in a
+ * memory-budgeted LRU.  Re-tessellating a shape — or a healed copy that kept
+ * most of its faces, or the same part at a second tolerance — re-meshes only
+ * the faces that are not already resident.  Default budget: 256 MiB. */
+
+// Set the fragment cache budget in bytes, evicting least-recently-used
+// entries if the cache is over the new budget.  0 disables caching.
+CgError cg_tess_cache_set_budget(size_t bytes);
+
+// Read cache occupancy and lifetime hit/miss counters (per-face probes).
+// Any out pointer may be NULL to skip that statistic.
+CgError cg_tess_cache_stats(size_t* out_entries, size_t* out_bytes,
+                            uint64_t* out_hits, uint64_t* out_misses);
+
+// Drop all cached fragments and reset the hit/miss counters.
+void cg_tess_cache_clear(void);
+
+// Return the storage precision of a mesh (CG_MESH_F64 for an invalid id).
+CgMeshPrecision cg_mesh_precision(CgMeshId id);
+
 // Return the number of vertices in the mesh (each vertex is 3 doubles).
 size_t cg_mesh_vertex_count(CgMeshId id);
 
@@ -149,9 +351,268 @@ CgError cg_mesh_copy_normals(CgMeshId id, double* out_normals);
 // Layout: [i0,i1,i2, i3,i4,i5, ...]
 CgError cg_mesh_copy_indices(CgMeshId id, uint32_t* out_indices);
 
+// Float32 variants of the copy accessors.  For a CG_MESH_F32 mesh these copy
+// the stored buffers directly; for a CG_MESH_F64 mesh the values are narrowed
+// during the copy.  (Conversely, the double accessors above widen when the
+// mesh is stored as float32.)
+CgError cg_mesh_copy_vertices_f32(CgMeshId id, float* out_vertices);
+CgError cg_mesh_copy_normals_f32(CgMeshId id, float* out_normals);
+
+/* ── Mesh decimation ─────────────────────────────────────────────────────── */
+
+// Build a decimated copy of a mesh by quadric-error-metric edge collapse.
+// target_ratio in (0, 1] is the fraction of triangles to keep; collapses
+// also stop early once the cheapest one would cost more than max_error
+// (squared distance; pass 0 for no error cap).  The source mesh is
+// untouched; the copy keeps its precision and gets freshly recomputed
+// normals.  Returns CG_NULL_ID on failure.
+CgMeshId cg_mesh_simplify(CgMeshId id, double target_ratio, double max_error);
+
+// Build n_levels decimated copies in one call, one per entry of
+// target_ratios (each in (0, 1]), filling out_meshes.  Levels are
+// independent — out_meshes[i] equals cg_mesh_simplify(id, target_ratios[i],
+// 0) — but they decimate concurrently, so a viewport LOD chain costs about
+// one decimation wall-clock.  On failure no handles are created and every
+// out_meshes entry is CG_NULL_ID.
+CgError cg_mesh_build_lods(CgMeshId id, const double* target_ratios,
+                           size_t n_levels, CgMeshId* out_meshes);
+
+/* ── Zero-copy mesh access ───────────────────────────────────────────────── */
+
+// Borrow-style access to the mesh buffers stored inside the kernel.  The
+// cg_mesh_copy_* functions above duplicate the entire mesh on the caller's
+// side; for large assemblies the caller can instead read (or GPU-upload)
+// directly from the kernel's interior storage via the *_ptr functions below.
+//
+// Pinning contract:
+//   - The returned pointers reference the mesh store's interior buffers.
+//     Meshes are immutable after creation, so the pointers are stable.
+//   - Without a map, a pointer is valid until cg_mesh_free(id).
+//   - cg_mesh_map(id) pins the buffers: after a successful map, the buffers
+//     (and any pointers obtained for id) stay valid even if cg_mesh_free(id)
+//     is called, until the matching cg_mesh_unmap(id).  Maps nest; the
+//     buffers are released when the last unmap and the free have both
+//     happened.
+
+// Pin the mesh buffers.  Returns CG_OK, or CG_ERR_NULL_HANDLE for a null or
+// unknown id.
+CgError cg_mesh_map(CgMeshId id);
+
+// Release one pin obtained from cg_mesh_map().
+// Returns CG_ERR_INVALID_ARG if the mesh is not currently mapped.
+CgError cg_mesh_unmap(CgMeshId id);
+
+// Borrowed pointer to the vertex buffer (cg_mesh_vertex_count(id) * 3 doubles,
+// layout [x0,y0,z0, x1,y1,z1, ...]).  Returns NULL for an invalid id, or for
+// a CG_MESH_F32 mesh (use cg_mesh_vertices_ptr_f32).
+const double* cg_mesh_vertices_ptr(CgMeshId id);
+
+// Borrowed pointer to the per-vertex normal buffer (same length/layout as the
+// vertex buffer).  Returns NULL for an invalid id or a CG_MESH_F32 mesh.
+// For a CG_NORMALS_LAZY mesh the first normal access builds the buffer; the
+// returned pointer is stable afterwards like the other accessors.
+const double* cg_mesh_normals_ptr(CgMeshId id);
+
+// Float32 variants of the borrowed-pointer accessors.  Return NULL for an
+// invalid id or a CG_MESH_F64 mesh — zero-copy access never converts.
+const float* cg_mesh_vertices_ptr_f32(CgMeshId id);
+const float* cg_mesh_normals_ptr_f32(CgMeshId id);
+
+// Borrowed pointer to the index buffer (cg_mesh_triangle_count(id) * 3
+// uint32s).  Returns NULL for an invalid id.
+const uint32_t* cg_mesh_indices_ptr(CgMeshId id);
+
 // Free a mesh and remove it from the registry.
+// If the mesh is currently mapped, the handle is released immediately but the
+// underlying buffers stay alive until the last cg_mesh_unmap() — see the
+// pinning contract above.
 void cg_mesh_free(CgMeshId id);
 
+/* ── Streaming mesh extraction ───────────────────────────────────────────── */
+
+// Opaque handle to an in-progress chunked extraction of one mesh.
+typedef uint64_t CgMeshStreamId;
+
+// Begin pulling a mesh out in self-contained chunks of at most
+// chunk_triangles triangles, so the renderer can upload and draw each chunk
+// as it arrives instead of blocking on one full-mesh copy.  Each chunk
+// carries its own compact vertex (and optional normal) buffer with indices
+// rebased into it, so every partial upload is a complete, drawable mesh —
+// chunks split only on whole-triangle boundaries.  The stream holds its own
+// reference to the mesh data and stays valid after cg_mesh_free(mesh_id).
+// Returns CG_NULL_ID on failure (null handle or chunk_triangles == 0).
+CgMeshStreamId cg_mesh_stream_begin(CgMeshId mesh_id, size_t chunk_triangles);
+
+// Produce the next chunk into caller-allocated buffers.
+//   out_vertices:    capacity chunk_triangles * 9 floats (3 per vertex).
+//   out_normals:     same capacity, or NULL if the renderer skips normals —
+//                    a lazy-normal mesh then never builds them.
+//   out_indices:     capacity chunk_triangles * 3 uint32s, chunk-local.
+//   out_n_vertices / out_n_triangles: sizes actually written.
+// Values narrow to float32 from a CG_MESH_F64 mesh, as the f32 copy
+// accessors do.  Returns CG_OK with *out_n_triangles == 0 once the mesh is
+// exhausted; the stream may then be freed.
+CgError cg_mesh_stream_next(CgMeshStreamId id, float* out_vertices,
+                             float* out_normals, uint32_t* out_indices,
+                             size_t* out_n_vertices, size_t* out_n_triangles);
+
+// Free a stream and remove it from the registry (at any point — the mesh
+// does not have to be exhausted).
+void cg_mesh_stream_free(CgMeshStreamId id);
+
+/* ── Geometry snapshot cache ─────────────────────────────────────────────── */
+
+/* A relocatable sidecar file holding the mesh store's flat buffers, so
+ * reopening a project restores its derived geometry without re-tessellating.
+ * cg_cache_load maps the file read-only and registers each mesh as a
+ * zero-copy view: count/copy/pointer access — and every consumer built on
+ * those accessors (BVH, heightmap, stock) — reads straight from the mapping,
+ * with pages faulted in on demand as the viewport touches them.  The mapping
+ * stays alive until the last view mesh (or pin on one) is freed. */
+
+// Serialize every live mesh into a snapshot at path (overwritten).  Lazy
+// normal buffers are materialized first, so loaded views never recompute
+// them.  Returns CG_ERR_FILE_NOT_FOUND when the file cannot be created.
+CgError cg_cache_save(const char* path);
+
+// Map a snapshot and register its meshes.  On success *out_meshes is a
+// cg_mesh_ids_free()-owned array of *out_count fresh mesh handles, in the
+// order they were saved (NULL when the snapshot is empty).  Returns
+// CG_ERR_PARSE_FAILED for a file that is not a valid snapshot.
+CgError cg_cache_load(const char* path, CgMeshId** out_meshes,
+                      size_t* out_count);
+
+// Free a handle array returned by cg_cache_load().
+void cg_mesh_ids_free(CgMeshId* ids);
+
+/* ── Mesh spatial index (BVH) ────────────────────────────────────────────── */
+
+// Opaque handle to a bounding-volume hierarchy built over one mesh.
+typedef uint64_t CgBvhId;
+
+// Result of one ray cast.  On a miss, t < 0 and triangle == UINT32_MAX.
+typedef struct {
+    double   t;         // hit distance in units of the ray direction's length
+    double   u, v;      // barycentric coordinates of the hit on the triangle
+    uint32_t triangle;  // index into the source mesh's triangle list
+} CgRayHit;
+
+// Result of one closest-point query.  distance < 0 only for an empty index.
+typedef struct {
+    CgPoint3 point;     // closest point on the mesh surface
+    double   distance;  // |query - point|
+    uint32_t triangle;  // index into the source mesh's triangle list
+} CgClosestPoint;
+
+// Build a persistent spatial index over the mesh for the batch queries
+// below.  The index copies the triangle data it needs, so it stays valid
+// after cg_mesh_free(mesh_id).  Building a 1M-triangle mesh takes on the
+// order of a second; the cutting simulation builds once per stock/part mesh
+// and then issues millions of queries against it.
+// Returns CG_NULL_ID on failure (null/unknown mesh, or empty mesh).
+CgBvhId cg_mesh_build_bvh(CgMeshId mesh_id);
+
+// Cast n_rays rays in one call, parallelized across cores.
+//   origins: flat [x,y,z, ...] array of n_rays ray origins
+//   dirs:    flat [x,y,z, ...] array of n_rays ray directions (any length;
+//            hit t values are in units of the direction's length)
+//   out_hits: caller-allocated array of n_rays results
+// Each ray reports its nearest intersection with t >= 0 (front- and
+// back-facing triangles both count).
+CgError cg_bvh_raycast_batch(CgBvhId id,
+                             const double* origins, const double* dirs,
+                             size_t n_rays, CgRayHit* out_hits);
+
+// Find the closest point on the mesh for each of n_points query points in
+// one call, parallelized across cores.
+//   points:      flat [x,y,z, ...] array of n_points query points
+//   out_results: caller-allocated array of n_points results
+CgError cg_bvh_closest_point_batch(CgBvhId id, const double* points,
+                                   size_t n_points,
+                                   CgClosestPoint* out_results);
+
+// Free a spatial index.  In-flight batch queries keep their reference; the
+// memory is released when the last one returns.
+void cg_bvh_free(CgBvhId id);
+
+/* ── Heightmap rasterization ─────────────────────────────────────────────── */
+
+// Rasterize the mesh into a max-Z heightmap over the XY window of `bounds`
+// (zmin/zmax are ignored), parallelized across cores by row bands.
+//   res_x, res_y: grid resolution; sample (ix, iy) is the cell CENTER at
+//                 (xmin + (ix+0.5)*dx, ymin + (iy+0.5)*dy).
+//   out_heights:  row-major float grid, x fastest: (*out_heights)[iy*res_x+ix].
+//                 Cells covered by no triangle hold -infinity.  Caller frees
+//                 via cg_heightmap_free().
+// Relief and 3D raster toolpaths consume this grid directly instead of
+// projecting points one at a time across the FFI.
+// Returns CG_ERR_NO_RESULT for an empty mesh.
+CgError cg_mesh_rasterize_heightmap(CgMeshId mesh_id, CgBbox bounds,
+                                    size_t res_x, size_t res_y,
+                                    float** out_heights);
+
+// Free a grid allocated by cg_mesh_rasterize_heightmap().
+void cg_heightmap_free(float* heights);
+
+/* ── Stock model (material-removal simulation) ───────────────────────────── */
+
+// Opaque handle to a Z-dexel stock grid: an XY grid of vertical material
+// spans that tool sweeps carve from above (the 3-axis stock model).
+typedef uint64_t CgStockId;
+
+// Milling tool cross-section for stock simulation.
+//   corner_radius 0            = flat endmill
+//   corner_radius diameter/2   = ball nose
+//   anything between           = bull nose
+typedef struct {
+    double diameter;      // cutting diameter (mm)
+    double corner_radius; // mm, in [0, diameter/2]
+} CgToolDef;
+
+// Create a full block of stock over `bounds`, dexel columns of
+// cell_size x cell_size mm.  Returns CG_NULL_ID on failure.
+CgStockId cg_stock_new(CgBbox bounds, double cell_size);
+
+// Create stock bounded above by the mesh (e.g. a casting or a previous
+// setup's result): the mesh is rasterized to a max-Z heightmap over the XY
+// window of `bounds` and each column filled from bounds.zmin up to it.
+// Columns the mesh does not cover are empty.
+CgStockId cg_stock_new_from_mesh(CgMeshId mesh_id, CgBbox bounds,
+                                 double cell_size);
+
+// Carve the tool along path_points in order, parallelized across dexel
+// column strips (the result is independent of the worker count).
+// Optional per-point outputs, each n_points entries, pass NULL to skip:
+//   out_removed_volume:    material volume removed at point i (mm^3)
+//   out_engagement_angle:  cutter engagement angle at point i, radians in
+//                          [0, 2*pi], sampled on the cutting-edge rim just
+//                          before that point's removal
+CgError cg_stock_subtract_sweep(CgStockId id, CgToolDef tool,
+                                const CgPoint3* path_points, size_t n_points,
+                                double* out_removed_volume,
+                                double* out_engagement_angle);
+
+// As cg_stock_subtract_sweep, but a dry run on a scratch copy: the stored
+// stock is left untouched.  Lets the feed optimizer evaluate a candidate
+// pass (including the sequential dependence between its points) before
+// committing it.
+CgError cg_stock_engagement(CgStockId id, CgToolDef tool,
+                            const CgPoint3* path_points, size_t n_points,
+                            double* out_removed_volume,
+                            double* out_engagement_angle);
+
+// Total remaining material volume in mm^3, or -1 for an invalid handle.
+double cg_stock_volume(CgStockId id);
+
+// Snapshot the stock's top surface as a row-major float heightmap (layout
+// as cg_mesh_rasterize_heightmap; an empty column reads the stock floor).
+// Caller frees via cg_heightmap_free().
+CgError cg_stock_heights(CgStockId id, float** out_heights,
+                         size_t* out_res_x, size_t* out_res_y);
+
+// Free a stock model.
+void cg_stock_free(CgStockId id);
+
 /* ── Surface evaluation ──────────────────────────────────────────────────── */
 
 // Return the surface type of a face.
@@ -172,10 +633,31 @@ CgVec3 cg_face_eval_du(CgFaceId id, double u, double v);
 // Evaluate the first partial derivative with respect to v at (u, v).
 CgVec3 cg_face_eval_dv(CgFaceId id, double u, double v);
 
+// Evaluate n samples of a face in one call.  uv_pairs holds n (u, v) pairs
+// interleaved; each non-NULL output array receives n entries.  Analytic
+// surfaces (planes, cylinders, cones) are evaluated with closed-form inner
+// loops and large batches are split across threads, so this is much faster
+// than n calls to the single-sample evaluators above.  Normals follow the
+// face orientation and are zero at degenerate parameters (e.g. a cone apex).
+CgError cg_face_eval_batch(CgFaceId id, const double* uv_pairs, size_t n,
+                           CgPoint3* out_points, CgVec3* out_normals,
+                           CgVec3* out_du, CgVec3* out_dv);
+
 // Project point onto the face; returns the nearest UV parameters.
 // out_dist: distance from point to surface (may be NULL).
 CgPoint2 cg_face_project_point(CgFaceId id, CgPoint3 point, double* out_dist);
 
+// Project n points onto the face in one call, writing the nearest UV
+// parameters to out_uvs (and distances to out_dists if non-NULL).  Each
+// point's search is seeded with the previous point's result — or with
+// seed_uvs[i] if seed_uvs (n interleaved (u, v) pairs) is non-NULL — so
+// projecting an ordered toolpath costs one warm Newton iteration per point
+// instead of a cold global search; the global search is the fallback when
+// an iteration diverges.
+CgError cg_face_project_points(CgFaceId id, const CgPoint3* points, size_t n,
+                               const double* seed_uvs, CgPoint2* out_uvs,
+                               double* out_dists);
+
 // For planar faces: return the plane normal and an on-plane origin point.
 // Returns CG_ERR_INVALID_ARG if the face is not planar.
 CgError cg_face_plane(CgFaceId id, CgVec3* out_normal, CgPoint3* out_origin);
@@ -205,11 +687,56 @@ double cg_edge_length(CgEdgeId id);
 int cg_edge_is_circle(CgEdgeId id, CgPoint3* out_center,
                        CgVec3* out_axis, double* out_radius);
 
+// Discretize an edge into a polyline whose chordal deviation from the curve
+// stays within chord_tol (mm).  Lines yield their two endpoints and circular
+// arcs use the exact analytic chord step; other curves are sampled adaptively
+// by curvature.  The first and last points coincide with the edge endpoints.
+//   out_points: *out_count vertices.  Caller frees via cg_section_free().
+//   out_params: curve parameter of each vertex, or NULL if not wanted.
+//               Caller frees via cg_params_free().
+CgError cg_edge_discretize(CgEdgeId id, double chord_tol,
+                            CgPoint3** out_points, double** out_params,
+                            size_t* out_count);
+
+// Discretize many edges in one call (parallel under the worker budget) —
+// one FFI round trip instead of one per sample for a 30k-edge trim job.
+//   out_points:      all edges' vertices concatenated, edges in input order.
+//                    Caller frees via cg_section_free().
+//   out_params:      matching curve parameters, or NULL if not wanted.
+//                    Caller frees via cg_params_free().
+//   out_edge_counts: n_edges per-edge vertex counts.  Caller frees via
+//                    cg_level_counts_free().
+CgError cg_edge_discretize_batch(const CgEdgeId* edges, size_t n_edges,
+                                  double chord_tol, CgPoint3** out_points,
+                                  double** out_params,
+                                  size_t** out_edge_counts);
+
+// Free a parameter array allocated by the discretization APIs.
+void cg_params_free(double* params);
+
 /* ── Geometric queries ───────────────────────────────────────────────────── */
 
-// Return the minimum distance between two shapes.
+// Return the minimum distance between two shapes, or -1 on error.
+// Each shape's acceleration structure (a BVH over a fixed-tolerance
+// tessellation) is built on the first distance query against it and cached
+// until the shape is freed, so repeat queries against the same pair cost
+// only the tree walk.  Distances are measured between the tessellations:
+// exact on planar geometry, within the 0.05 mm chord tolerance on curved
+// faces.  Returns 0 when the shapes touch or interpenetrate.
 double cg_shape_distance(CgShapeId a, CgShapeId b);
 
+// As cg_shape_distance, but evaluates one moving shape at many placements
+// against a fixed shape in a single call — the verify-stage clearance sweep.
+//   transforms:    n_transforms row-major 3×4 rigid transforms
+//                  [r00 r01 r02 tx  r10 r11 r12 ty  r20 r21 r22 tz]
+//                  applied to `moving` (12 doubles per placement)
+//   out_distances: one distance per placement (caller allocates)
+// Placements are evaluated in parallel under the worker budget.
+CgError cg_shape_distance_batch(CgShapeId fixed_shape, CgShapeId moving,
+                                 const double* transforms,
+                                 size_t n_transforms,
+                                 double* out_distances);
+
 // Intersect a shape with the horizontal plane Z = z_value.
 // On success, writes a flat array of CgPoint3 values forming polyline segments
 // (pairs: start, end, start, end, ...) into *out_points and the element count
@@ -221,6 +748,81 @@ CgError cg_shape_section_at_z(CgShapeId id, double z_value,
 // Free memory allocated by cg_shape_section_at_z().
 void cg_section_free(CgPoint3* points);
 
+/* ── Batched multi-plane sectioning ──────────────────────────────────────── */
+
+// Opaque handle to a persistent slicer built from one shape.
+typedef uint64_t CgSlicerId;
+
+// Build a slicer for the shape.  Precomputes the per-face Z-interval table
+// once, so that each subsequent slice only visits the faces the plane
+// actually crosses.  The slicer holds its own reference to the geometry and
+// stays valid after cg_shape_free(id).
+// Returns CG_NULL_ID on failure.
+CgSlicerId cg_slicer_new(CgShapeId id);
+
+// Free a slicer and remove it from the registry.
+void cg_slicer_free(CgSlicerId id);
+
+// Slice all planes Z = z_values[0..n_levels) in one call, in parallel across
+// cores.
+//   chord_tol:        maximum chord deviation when discretizing curved
+//                     section edges into polyline segments (mm).
+//   out_points:       all levels' segment pairs concatenated
+//                     (start, end, start, end, ... per level, levels in input
+//                     order).  Caller frees via cg_section_free().
+//   out_level_counts: array of n_levels element counts; level i occupies
+//                     (*out_level_counts)[i] CgPoint3 values.  A level that
+//                     does not intersect the shape has count 0.  Caller frees
+//                     via cg_level_counts_free().
+CgError cg_slicer_section_multi_z(CgSlicerId id,
+                                   const double* z_values, size_t n_levels,
+                                   double chord_tol,
+                                   CgPoint3** out_points,
+                                   size_t** out_level_counts);
+
+// Free a counts array allocated by the sectioning APIs.
+void cg_level_counts_free(size_t* counts);
+
+/* ── Chained section loops ───────────────────────────────────────────────── */
+
+// Loop variants of the sectioning calls: instead of the raw (start, end)
+// segment soup, the kernel chains segments into connected boundary loops
+// before crossing the FFI, using a spatial endpoint hash during assembly.
+//
+// Loop layout (shared by both calls):
+//   - A closed loop's first point is NOT repeated at the end; consumers treat
+//     loops as implicitly closed.  Closed loops are oriented counter-
+//     clockwise in XY.
+//   - Chains that cannot be closed (non-manifold input) are returned as open
+//     polylines, first point != last point.
+
+// Chain the section of shape id at Z = z_value.
+//   out_points:      all loops' vertices concatenated, loop by loop.
+//                    Caller frees via cg_section_free().
+//   out_loop_counts: per-loop vertex counts (*out_n_loops entries).  Caller
+//                    frees via cg_level_counts_free().
+//   out_n_loops:     number of loops.
+// Returns CG_ERR_NO_RESULT if there is no intersection.
+CgError cg_shape_section_loops_at_z(CgShapeId id, double z_value,
+                                     CgPoint3** out_points,
+                                     size_t** out_loop_counts,
+                                     size_t* out_n_loops);
+
+// Chain all levels of a batched slice in one call (parallel across cores).
+//   out_points:            all levels' loops concatenated, levels in input
+//                          order.  Caller frees via cg_section_free().
+//   out_loop_counts:       per-loop vertex counts, concatenated across
+//                          levels.  Caller frees via cg_level_counts_free().
+//   out_level_loop_counts: number of loops per level (n_levels entries).
+//                          Caller frees via cg_level_counts_free().
+CgError cg_slicer_section_loops_multi_z(CgSlicerId id,
+                                         const double* z_values,
+                                         size_t n_levels,
+                                         double chord_tol,
+                                         CgPoint3** out_points,
+                                         size_t** out_loop_counts,
+                                         size_t** out_level_loop_counts);
+
 /* ── Feature detection ───────────────────────────────────────────────────── */
 
 typedef struct {
@@ -239,8 +841,12 @@ typedef struct {
 } CgPlanarFaceInfo;
 
 // Detect cylindrical holes whose diameter falls in [min_diameter, max_diameter].
+// Bores split across seam faces are merged; is_through is set when the bore
+// spans the whole shape along its axis.  Both detection calls scan a cached
+// per-shape face-classification table built in parallel on first use, so
+// re-running with different filters is cheap.
 // Writes results into *out_holes (caller frees via cg_holes_free()).
-// Returns the number of holes found.
+// Returns the number of holes found; 0 with an error message on failure.
 size_t cg_shape_find_holes(CgShapeId id,
                             double min_diameter, double max_diameter,
                             CgHoleInfo** out_holes);
@@ -248,7 +854,9 @@ size_t cg_shape_find_holes(CgShapeId id,
 // Free the array allocated by cg_shape_find_holes().
 void cg_holes_free(CgHoleInfo* holes);
 
-// Detect planar (flat) faces in the shape.
+// Detect planar (flat) faces in the shape.  Each entry carries a fresh face
+// handle (free individually with cg_face_free()) and the outward-oriented
+// unit normal.
 // Writes results into *out_faces (caller frees via cg_planar_faces_free()).
 // Returns the number of planar faces found.
 size_t cg_shape_find_planar_faces(CgShapeId id, CgPlanarFaceInfo** out_faces);
@@ -273,6 +881,34 @@ CgError cg_poly_offset(const double* points, size_t point_count,
 // Free an array allocated by cg_poly_offset() or cg_poly_boolean().
 void cg_poly_free(double* points);
 
+// Compute the whole family of offsets delta, 2·delta, 3·delta, ... of one
+// polygon in a single call, reusing the offset engine state across steps.
+// This is the pocketing inner loop: pass a negative stepover to walk inward
+// until the polygon collapses.
+//   points / point_count: closed input polygon (flat [x,y, ...] pairs)
+//   stepover:       per-step offset distance in mm (sign as in cg_poly_offset:
+//                   positive = outward, negative = inward)
+//   max_steps:      stop after this many offset steps (0 = until collapse;
+//                   outward families, which never collapse, require a limit)
+//   arc_tolerance:  maximum deviation from true arc when rounding corners
+//   out_points:     all rings' vertices concatenated (flat [x,y, ...] pairs).
+//                   Caller frees via cg_poly_free().
+//   out_ring_counts: per-ring (x,y) pair counts.  A single step can produce
+//                   several rings when a pocket splits.  Caller frees via
+//                   cg_poly_counts_free().
+//   out_ring_deltas: the producing offset distance per ring, so callers can
+//                   group rings by step.  Caller frees via cg_poly_free().
+//   out_n_rings:    total number of rings across all steps.
+// Returns CG_ERR_NO_RESULT if even the first step collapses the polygon.
+CgError cg_poly_offset_family(const double* points, size_t point_count,
+                               double stepover, size_t max_steps,
+                               double arc_tolerance,
+                               double** out_points, size_t** out_ring_counts,
+                               double** out_ring_deltas, size_t* out_n_rings);
+
+// Free a ring-count array allocated by cg_poly_offset_family().
+void cg_poly_counts_free(size_t* counts);
+
 // Boolean operations on 2D polygon sets.
 typedef enum {
     CG_BOOL_UNION        = 0,
@@ -285,11 +921,65 @@ typedef enum {
 //   b_points / b_count: second polygon
 //   op:                 union, difference, or intersection
 //   out_points / out_count: result polygon (caller frees via cg_poly_free)
+// When the result has several rings, the largest one is returned (as in
+// cg_poly_offset); use cg_poly_boolean_multi() to get them all.
+// Returns CG_ERR_NO_RESULT if the result is empty.
 CgError cg_poly_boolean(const double* a_points, size_t a_count,
                          const double* b_points, size_t b_count,
                          CgBoolOp op,
                          double** out_points, size_t* out_count);
 
+// Boolean operation between two SETS of rings in one call.
+// Each side is a flat [x,y, ...] array plus per-ring (x,y) pair counts; hole
+// rings are wound opposite to their outer ring (non-zero fill rule), so
+// polygons with holes pass as multiple rings.
+//   subj_points / subj_counts / n_subj: subject ring set
+//   clip_points / clip_counts / n_clip: clip ring set (may be empty for
+//                                       a pure union of the subjects)
+//   out_points:      all result rings concatenated (free via cg_poly_free)
+//   out_ring_counts: per-ring pair counts (free via cg_poly_counts_free)
+//   out_n_rings:     number of result rings
+// Unlike cg_poly_boolean, an empty result is not an error: returns CG_OK
+// with *out_n_rings == 0 (e.g. rest material fully cleared).
+CgError cg_poly_boolean_multi(const double* subj_points,
+                               const size_t* subj_counts, size_t n_subj,
+                               const double* clip_points,
+                               const size_t* clip_counts, size_t n_clip,
+                               CgBoolOp op,
+                               double** out_points, size_t** out_ring_counts,
+                               size_t* out_n_rings);
+
+/* ── Persistent clipper engine ───────────────────────────────────────────── */
+
+// Opaque handle to a persistent 2D boolean engine.
+typedef uint64_t CgClipperId;
+
+// Create an empty clipper engine.  Subject and clip rings accumulate across
+// calls and survive cg_clipper_execute(), so an incremental union — e.g. the
+// growing set of tool footprints in rest-material computation — can be built
+// by adding each new footprint instead of re-feeding the whole set per pass.
+// Returns CG_NULL_ID on failure.
+CgClipperId cg_clipper_new(void);
+
+// Add subject rings to the engine (same flat-array + per-ring counts layout
+// and hole convention as cg_poly_boolean_multi).
+CgError cg_clipper_add_subject(CgClipperId id, const double* points,
+                                const size_t* ring_counts, size_t n_rings);
+
+// Add clip rings to the engine.
+CgError cg_clipper_add_clip(CgClipperId id, const double* points,
+                             const size_t* ring_counts, size_t n_rings);
+
+// Run op over everything added so far.  Inputs are preserved, so this can be
+// called again after adding more rings.  Output layout and ownership match
+// cg_poly_boolean_multi; an empty result returns CG_OK with 0 rings.
+CgError cg_clipper_execute(CgClipperId id, CgBoolOp op,
+                            double** out_points, size_t** out_ring_counts,
+                            size_t* out_n_rings);
+
+// Free a clipper engine.
+void cg_clipper_free(CgClipperId id);
+
 #ifdef __cplusplus
 }
 #endif
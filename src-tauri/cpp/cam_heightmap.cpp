@@ -0,0 +1,92 @@
+// cam_heightmap.cpp
+//
+// C API wrapper around the max-Z heightmap rasterizer (heightmap.h).
+//
+// Like cam_bvh.cpp, this file reads mesh data only through the public
+// cg_mesh_* accessors (with a map/unmap pin around the rasterization), so
+// it has no OCCT dependency and links into the no-OCCT test builds.
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "cam_error.h"
+#include "cam_geometry.h"
+#include "worker_pool.h"
+#include "heightmap.h"
+
+extern "C" {
+
+CgError cg_mesh_rasterize_heightmap(CgMeshId mesh_id, CgBbox bounds,
+                                    size_t res_x, size_t res_y,
+                                    float** out_heights) {
+    if (!out_heights) {
+        set_last_error("cg_mesh_rasterize_heightmap: null output argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    *out_heights = nullptr;
+    if (res_x == 0 || res_y == 0) {
+        set_last_error("cg_mesh_rasterize_heightmap: zero resolution");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (!(bounds.xmax > bounds.xmin) || !(bounds.ymax > bounds.ymin)) {
+        set_last_error("cg_mesh_rasterize_heightmap: empty XY bounds");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (res_y > std::numeric_limits<size_t>::max() / res_x) {
+        set_last_error("cg_mesh_rasterize_heightmap: grid size overflows");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (mesh_id == CG_NULL_ID) {
+        set_last_error("cg_mesh_rasterize_heightmap: null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    if (cg_mesh_map(mesh_id) != CG_OK) {
+        set_last_error("cg_mesh_rasterize_heightmap: unknown mesh ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    try {
+        const size_t n_tris = cg_mesh_triangle_count(mesh_id);
+        const uint32_t* indices = cg_mesh_indices_ptr(mesh_id);
+        if (n_tris == 0 || !indices) {
+            cg_mesh_unmap(mesh_id);
+            set_last_error("cg_mesh_rasterize_heightmap: empty mesh");
+            return CG_ERR_NO_RESULT;
+        }
+
+        auto grid = std::make_unique<float[]>(res_x * res_y);
+        if (cg_mesh_precision(mesh_id) == CG_MESH_F32)
+            heightmap::rasterize_max_z(cg_mesh_vertices_ptr_f32(mesh_id),
+                                       indices, n_tris,
+                                       bounds.xmin, bounds.ymin,
+                                       bounds.xmax, bounds.ymax,
+                                       res_x, res_y, grid.get(),
+                                       worker_pool::effective());
+        else
+            heightmap::rasterize_max_z(cg_mesh_vertices_ptr(mesh_id),
+                                       indices, n_tris,
+                                       bounds.xmin, bounds.ymin,
+                                       bounds.xmax, bounds.ymax,
+                                       res_x, res_y, grid.get(),
+                                       worker_pool::effective());
+        cg_mesh_unmap(mesh_id);
+
+        *out_heights = grid.release();
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        cg_mesh_unmap(mesh_id);
+        set_last_error(std::string("cg_mesh_rasterize_heightmap: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        cg_mesh_unmap(mesh_id);
+        set_last_error("cg_mesh_rasterize_heightmap: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
+}
+
+void cg_heightmap_free(float* heights) {
+    delete[] heights;
+}
+
+} // extern "C"
@@ -0,0 +1,77 @@
+// cam_perf.cpp
+//
+// C API for the kernel performance counters (perf_counters.h).  Kept in its
+// own translation unit (rather than cam_geometry.cpp) so that no-OCCT
+// modules and their standalone test binaries can link the instrumentation
+// surface without pulling in the OCCT-backed kernel.
+
+#include <cstdio>
+#include <string>
+
+#include "cam_error.h"
+#include "cam_geometry.h"
+#include "perf_counters.h"
+
+extern "C" {
+
+size_t cg_perf_counters_snapshot(CgPerfCounter* out, size_t capacity) {
+    if (!out) return perf_counters::kSubsystemCount;
+    const size_t n = capacity < perf_counters::kSubsystemCount
+                         ? capacity
+                         : size_t{perf_counters::kSubsystemCount};
+    for (size_t i = 0; i < n; ++i) {
+        const auto sys = static_cast<perf_counters::Subsystem>(i);
+        const perf_counters::Counter& c = perf_counters::g_counters[i];
+        out[i].name     = perf_counters::name_of(sys);
+        out[i].calls    = c.calls.load(std::memory_order_relaxed);
+        out[i].total_ns = c.total_ns.load(std::memory_order_relaxed);
+        out[i].max_ns   = c.max_ns.load(std::memory_order_relaxed);
+        out[i].bytes    = c.bytes.load(std::memory_order_relaxed);
+    }
+    return n;
+}
+
+CgError cg_perf_reset(void) {
+    perf_counters::reset();
+    return CG_OK;
+}
+
+CgError cg_perf_trace_enable(int enabled) {
+    perf_counters::g_trace_enabled.store(enabled != 0,
+                                         std::memory_order_relaxed);
+    return CG_OK;
+}
+
+CgError cg_perf_trace_dump(const char* path) {
+    if (!path) {
+        set_last_error("cg_perf_trace_dump: null path");
+        return CG_ERR_INVALID_ARG;
+    }
+    FILE* f = std::fopen(path, "w");
+    if (!f) {
+        set_last_error(std::string("cg_perf_trace_dump: cannot open '") +
+                       path + "'");
+        return CG_ERR_FILE_NOT_FOUND;
+    }
+    std::fputs("{\"traceEvents\":[", f);
+    const size_t n = perf_counters::trace_event_count();
+    for (size_t i = 0; i < n; ++i) {
+        const perf_counters::TraceEvent& ev = perf_counters::g_trace[i];
+        std::fprintf(f,
+                     "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+                     "\"tid\":%llu,\"ts\":%llu,\"dur\":%llu}",
+                     i == 0 ? "" : ",", perf_counters::name_of(ev.sys),
+                     static_cast<unsigned long long>(ev.tid),
+                     static_cast<unsigned long long>(ev.start_us),
+                     static_cast<unsigned long long>(ev.dur_us));
+    }
+    std::fputs("]}\n", f);
+    if (std::fclose(f) != 0) {
+        set_last_error(std::string("cg_perf_trace_dump: write failed for '") +
+                       path + "'");
+        return CG_ERR_NO_RESULT;
+    }
+    return CG_OK;
+}
+
+} // extern "C"
@@ -0,0 +1,490 @@
+// cam_polygon.cpp
+//
+// 2D polygon operations (Clipper2) for the plain-C geometry kernel API.
+//
+// Lives in its own translation unit with no OCCT dependency so it can be
+// compiled and tested standalone (same pattern as section_chaining.cpp).
+//
+// Conventions:
+//   - Coordinates cross the FFI as doubles in mm and are scaled to Clipper2's
+//     int64 lattice by kClipperScale (1e6 → 1 nm resolution), well below any
+//     machining tolerance.
+//   - Offset corners are rounded (JoinType::Round), matching what an endmill
+//     actually produces; arc_tolerance controls the rounding chord error.
+//   - Single-result functions return the largest-area output polygon when an
+//     operation splits the input (documented in cam_geometry.h); the family
+//     and multi-polygon APIs return everything.
+
+#include <clipper2/clipper.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cam_error.h"
+#include "cam_geometry.h"
+#include "perf_counters.h"
+
+namespace {
+
+using namespace Clipper2Lib;
+
+// mm → int64 lattice scale.
+constexpr double kClipperScale = 1e6;
+
+Path64 to_path64(const double* points, size_t point_count) {
+    Path64 path;
+    path.reserve(point_count);
+    for (size_t i = 0; i < point_count; ++i) {
+        path.push_back(Point64(
+            static_cast<int64_t>(std::llround(points[i * 2 + 0] * kClipperScale)),
+            static_cast<int64_t>(std::llround(points[i * 2 + 1] * kClipperScale))));
+    }
+    return path;
+}
+
+// Allocate and fill a flat [x,y, ...] array from one path.
+// Caller frees via cg_poly_free().
+double* from_path64(const Path64& path) {
+    double* out = new double[path.size() * 2];
+    for (size_t i = 0; i < path.size(); ++i) {
+        out[i * 2 + 0] = static_cast<double>(path[i].x) / kClipperScale;
+        out[i * 2 + 1] = static_cast<double>(path[i].y) / kClipperScale;
+    }
+    return out;
+}
+
+// Index of the largest-|area| path in paths (paths must be non-empty).
+size_t largest_path_index(const Paths64& paths) {
+    size_t best = 0;
+    double best_area = 0.0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        const double a = std::abs(Area(paths[i]));
+        if (a > best_area) {
+            best_area = a;
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Convert a flat [x,y, ...] array with per-ring pair counts to Paths64.
+Paths64 to_paths64(const double* points, const size_t* ring_counts,
+                   size_t n_rings) {
+    Paths64 paths;
+    paths.reserve(n_rings);
+    size_t offset_pairs = 0;
+    for (size_t i = 0; i < n_rings; ++i) {
+        paths.push_back(to_path64(points + offset_pairs * 2, ring_counts[i]));
+        offset_pairs += ring_counts[i];
+    }
+    return paths;
+}
+
+// Emit a ring set as the flat-array + per-ring counts triple used by the
+// multi-ring APIs.  An empty set yields null arrays and 0 rings.
+void emit_paths(const Paths64& paths, double** out_points,
+                size_t** out_ring_counts, size_t* out_n_rings) {
+    if (paths.empty()) return;  // outputs already nulled by the caller
+    size_t total_pairs = 0;
+    for (const Path64& path : paths) total_pairs += path.size();
+
+    double* flat   = new double[total_pairs * 2];
+    size_t* counts = new size_t[paths.size()];
+    size_t offset_pairs = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        counts[i] = paths[i].size();
+        for (size_t j = 0; j < paths[i].size(); ++j) {
+            flat[(offset_pairs + j) * 2 + 0] =
+                static_cast<double>(paths[i][j].x) / kClipperScale;
+            flat[(offset_pairs + j) * 2 + 1] =
+                static_cast<double>(paths[i][j].y) / kClipperScale;
+        }
+        offset_pairs += paths[i].size();
+    }
+    *out_points      = flat;
+    *out_ring_counts = counts;
+    *out_n_rings     = paths.size();
+}
+
+bool to_clip_type(CgBoolOp op, ClipType& out) {
+    switch (op) {
+        case CG_BOOL_UNION:        out = ClipType::Union;        return true;
+        case CG_BOOL_DIFFERENCE:   out = ClipType::Difference;   return true;
+        case CG_BOOL_INTERSECTION: out = ClipType::Intersection; return true;
+    }
+    return false;
+}
+
+// ── Persistent clipper engine store ─────────────────────────────────────────
+// Same store pattern as the mesh and slicer stores in cam_geometry.cpp.
+// Unlike those, the Clipper64 engine is mutated by add/execute calls, so each
+// entry carries its own mutex.
+
+struct CgClipperData {
+    std::mutex mutex;
+    Clipper64  engine;
+};
+
+std::shared_mutex                                           g_clipper_mutex;
+std::unordered_map<uint64_t, std::shared_ptr<CgClipperData>> g_clipper_store;
+std::atomic<uint64_t>                                       g_clipper_next_id{1};
+
+std::shared_ptr<CgClipperData> clipper_store_get(uint64_t id) {
+    std::shared_lock<std::shared_mutex> lock(g_clipper_mutex);
+    auto it = g_clipper_store.find(id);
+    if (it == g_clipper_store.end()) return nullptr;
+    return it->second;
+}
+
+// Shared body of cg_clipper_add_subject / cg_clipper_add_clip.
+CgError clipper_add_paths(const char* fn, CgClipperId id, const double* points,
+                          const size_t* ring_counts, size_t n_rings,
+                          bool as_subject) {
+    if (id == CG_NULL_ID) {
+        set_last_error(std::string(fn) + ": null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    if (!points || !ring_counts || n_rings == 0) {
+        set_last_error(std::string(fn) + ": null argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    auto data = clipper_store_get(id);
+    if (!data) {
+        set_last_error(std::string(fn) + ": invalid clipper ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    try {
+        Paths64 paths = to_paths64(points, ring_counts, n_rings);
+        std::lock_guard<std::mutex> lock(data->mutex);
+        if (as_subject) data->engine.AddSubject(paths);
+        else            data->engine.AddClip(paths);
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string(fn) + " std::exception: " + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error(std::string(fn) + ": unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
+}
+
+}  // namespace
+
+extern "C" {
+
+CgError cg_poly_offset(const double* points, size_t point_count,
+                        double delta, double arc_tolerance,
+                        double** out_points, size_t* out_count) {
+    if (out_points) *out_points = nullptr;
+    if (out_count)  *out_count  = 0;
+    if (!points || !out_points || !out_count) {
+        set_last_error("cg_poly_offset: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    if (point_count < 3) {
+        set_last_error("cg_poly_offset: polygon needs at least 3 points");
+        return CG_ERR_INVALID_ARG;
+    }
+    perf_counters::Scope perf(perf_counters::kOffset);
+    try {
+        ClipperOffset offset(/*miter_limit=*/2.0,
+                             arc_tolerance * kClipperScale);
+        offset.AddPath(to_path64(points, point_count),
+                       JoinType::Round, EndType::Polygon);
+
+        Paths64 solution;
+        offset.Execute(delta * kClipperScale, solution);
+        if (solution.empty()) {
+            set_last_error("cg_poly_offset: offset collapsed the polygon");
+            return CG_ERR_NO_RESULT;
+        }
+
+        // Single-polygon contract: return the largest result when the offset
+        // splits the input.
+        const Path64& result = solution[largest_path_index(solution)];
+        *out_points = from_path64(result);
+        *out_count  = result.size();
+        perf.add_bytes(result.size() * 2 * sizeof(double));
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Offset std::exception: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("Offset: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
+}
+
+void cg_poly_free(double* points) {
+    delete[] points;
+}
+
+void cg_poly_counts_free(size_t* counts) {
+    delete[] counts;
+}
+
+CgError cg_poly_offset_family(const double* points, size_t point_count,
+                               double stepover, size_t max_steps,
+                               double arc_tolerance,
+                               double** out_points, size_t** out_ring_counts,
+                               double** out_ring_deltas, size_t* out_n_rings) {
+    if (out_points)      *out_points      = nullptr;
+    if (out_ring_counts) *out_ring_counts = nullptr;
+    if (out_ring_deltas) *out_ring_deltas = nullptr;
+    if (out_n_rings)     *out_n_rings     = 0;
+    if (!points || !out_points || !out_ring_counts || !out_ring_deltas ||
+        !out_n_rings) {
+        set_last_error("cg_poly_offset_family: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    if (point_count < 3 || stepover == 0.0) {
+        set_last_error("cg_poly_offset_family: invalid argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    if (stepover > 0.0 && max_steps == 0) {
+        // An outward family never collapses — an unbounded walk would never
+        // terminate.
+        set_last_error("cg_poly_offset_family: outward family needs max_steps");
+        return CG_ERR_INVALID_ARG;
+    }
+    perf_counters::Scope perf(perf_counters::kOffset);
+    try {
+        // Ingest the polygon once; the offset engine keeps its group state
+        // across Execute calls, so each step only pays for the offset itself.
+        ClipperOffset offset(/*miter_limit=*/2.0,
+                             arc_tolerance * kClipperScale);
+        offset.AddPath(to_path64(points, point_count),
+                       JoinType::Round, EndType::Polygon);
+
+        std::vector<Path64> rings;
+        std::vector<double> ring_deltas;
+        for (size_t step = 1; max_steps == 0 || step <= max_steps; ++step) {
+            const double delta = stepover * static_cast<double>(step);
+            Paths64 solution;
+            offset.Execute(delta * kClipperScale, solution);
+            if (solution.empty()) break;  // family collapsed
+            for (Path64& path : solution) {
+                rings.push_back(std::move(path));
+                ring_deltas.push_back(delta);
+            }
+        }
+
+        if (rings.empty()) {
+            set_last_error("cg_poly_offset_family: first step collapsed the polygon");
+            return CG_ERR_NO_RESULT;
+        }
+
+        size_t total_pairs = 0;
+        for (const Path64& ring : rings) total_pairs += ring.size();
+
+        double* flat   = new double[total_pairs * 2];
+        size_t* counts = new size_t[rings.size()];
+        double* deltas = new double[rings.size()];
+        size_t offset_pairs = 0;
+        for (size_t i = 0; i < rings.size(); ++i) {
+            counts[i] = rings[i].size();
+            deltas[i] = ring_deltas[i];
+            for (size_t j = 0; j < rings[i].size(); ++j) {
+                flat[(offset_pairs + j) * 2 + 0] =
+                    static_cast<double>(rings[i][j].x) / kClipperScale;
+                flat[(offset_pairs + j) * 2 + 1] =
+                    static_cast<double>(rings[i][j].y) / kClipperScale;
+            }
+            offset_pairs += rings[i].size();
+        }
+
+        *out_points      = flat;
+        *out_ring_counts = counts;
+        *out_ring_deltas = deltas;
+        *out_n_rings     = rings.size();
+        perf.add_bytes(total_pairs * 2 * sizeof(double) +
+                       rings.size() * (sizeof(size_t) + sizeof(double)));
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Offset family std::exception: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("Offset family: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
+}
+
+CgError cg_poly_boolean(const double* a_points, size_t a_count,
+                         const double* b_points, size_t b_count,
+                         CgBoolOp op,
+                         double** out_points, size_t* out_count) {
+    if (out_points) *out_points = nullptr;
+    if (out_count)  *out_count  = 0;
+    if (!a_points || !b_points || !out_points || !out_count) {
+        set_last_error("cg_poly_boolean: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    if (a_count < 3 || b_count < 3) {
+        set_last_error("cg_poly_boolean: polygon needs at least 3 points");
+        return CG_ERR_INVALID_ARG;
+    }
+    ClipType clip_type;
+    if (!to_clip_type(op, clip_type)) {
+        set_last_error("cg_poly_boolean: invalid operation");
+        return CG_ERR_INVALID_ARG;
+    }
+    perf_counters::Scope perf(perf_counters::kBoolean);
+    try {
+        Paths64 subject{to_path64(a_points, a_count)};
+        Paths64 clip{to_path64(b_points, b_count)};
+        Paths64 solution =
+            BooleanOp(clip_type, FillRule::NonZero, subject, clip);
+        if (solution.empty()) {
+            set_last_error("cg_poly_boolean: empty result");
+            return CG_ERR_NO_RESULT;
+        }
+        // Single-polygon contract: return the largest result ring.
+        const Path64& result = solution[largest_path_index(solution)];
+        *out_points = from_path64(result);
+        *out_count  = result.size();
+        perf.add_bytes(result.size() * 2 * sizeof(double));
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Boolean std::exception: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("Boolean: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
+}
+
+CgError cg_poly_boolean_multi(const double* subj_points,
+                               const size_t* subj_counts, size_t n_subj,
+                               const double* clip_points,
+                               const size_t* clip_counts, size_t n_clip,
+                               CgBoolOp op,
+                               double** out_points, size_t** out_ring_counts,
+                               size_t* out_n_rings) {
+    if (out_points)      *out_points      = nullptr;
+    if (out_ring_counts) *out_ring_counts = nullptr;
+    if (out_n_rings)     *out_n_rings     = 0;
+    if (!subj_points || !subj_counts || !out_points || !out_ring_counts ||
+        !out_n_rings) {
+        set_last_error("cg_poly_boolean_multi: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    if (n_subj == 0 || (n_clip > 0 && (!clip_points || !clip_counts))) {
+        set_last_error("cg_poly_boolean_multi: invalid argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    ClipType clip_type;
+    if (!to_clip_type(op, clip_type)) {
+        set_last_error("cg_poly_boolean_multi: invalid operation");
+        return CG_ERR_INVALID_ARG;
+    }
+    perf_counters::Scope perf(perf_counters::kBoolean);
+    try {
+        Paths64 subjects = to_paths64(subj_points, subj_counts, n_subj);
+        Paths64 clips;
+        if (n_clip > 0) clips = to_paths64(clip_points, clip_counts, n_clip);
+        Paths64 solution =
+            BooleanOp(clip_type, FillRule::NonZero, subjects, clips);
+        // Empty result is valid here (e.g. difference that removes everything).
+        emit_paths(solution, out_points, out_ring_counts, out_n_rings);
+        size_t total_pairs = 0;
+        for (const Path64& path : solution) total_pairs += path.size();
+        perf.add_bytes(total_pairs * 2 * sizeof(double) +
+                       solution.size() * sizeof(size_t));
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Boolean multi std::exception: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("Boolean multi: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
+}
+
+CgClipperId cg_clipper_new(void) {
+    try {
+        uint64_t id = g_clipper_next_id.fetch_add(1, std::memory_order_relaxed);
+        auto data = std::make_shared<CgClipperData>();
+        std::unique_lock<std::shared_mutex> lock(g_clipper_mutex);
+        g_clipper_store.emplace(id, std::move(data));
+        return id;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_clipper_new std::exception: ") + ex.what());
+        return CG_NULL_ID;
+    }
+}
+
+CgError cg_clipper_add_subject(CgClipperId id, const double* points,
+                                const size_t* ring_counts, size_t n_rings) {
+    return clipper_add_paths("cg_clipper_add_subject", id, points, ring_counts,
+                             n_rings, /*as_subject=*/true);
+}
+
+CgError cg_clipper_add_clip(CgClipperId id, const double* points,
+                             const size_t* ring_counts, size_t n_rings) {
+    return clipper_add_paths("cg_clipper_add_clip", id, points, ring_counts,
+                             n_rings, /*as_subject=*/false);
+}
+
+CgError cg_clipper_execute(CgClipperId id, CgBoolOp op,
+                            double** out_points, size_t** out_ring_counts,
+                            size_t* out_n_rings) {
+    if (out_points)      *out_points      = nullptr;
+    if (out_ring_counts) *out_ring_counts = nullptr;
+    if (out_n_rings)     *out_n_rings     = 0;
+    if (id == CG_NULL_ID) {
+        set_last_error("cg_clipper_execute: null handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    if (!out_points || !out_ring_counts || !out_n_rings) {
+        set_last_error("cg_clipper_execute: null argument");
+        return CG_ERR_NULL_HANDLE;
+    }
+    ClipType clip_type;
+    if (!to_clip_type(op, clip_type)) {
+        set_last_error("cg_clipper_execute: invalid operation");
+        return CG_ERR_INVALID_ARG;
+    }
+    auto data = clipper_store_get(id);
+    if (!data) {
+        set_last_error("cg_clipper_execute: invalid clipper ID");
+        return CG_ERR_NULL_HANDLE;
+    }
+    perf_counters::Scope perf(perf_counters::kBoolean);
+    try {
+        Paths64 solution;
+        std::lock_guard<std::mutex> lock(data->mutex);
+        // Execute() preserves the added paths (CleanUp, not Clear), so the
+        // accumulated subject set survives for the next incremental pass.
+        if (!data->engine.Execute(clip_type, FillRule::NonZero, solution)) {
+            set_last_error("cg_clipper_execute: clipping failed");
+            return CG_ERR_NO_RESULT;
+        }
+        emit_paths(solution, out_points, out_ring_counts, out_n_rings);
+        size_t total_pairs = 0;
+        for (const Path64& path : solution) total_pairs += path.size();
+        perf.add_bytes(total_pairs * 2 * sizeof(double) +
+                       solution.size() * sizeof(size_t));
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("Clipper execute std::exception: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("Clipper execute: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
+}
+
+void cg_clipper_free(CgClipperId id) {
+    if (id == CG_NULL_ID) return;
+    std::unique_lock<std::shared_mutex> lock(g_clipper_mutex);
+    g_clipper_store.erase(id);
+}
+
+} // extern "C"
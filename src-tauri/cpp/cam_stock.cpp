@@ -0,0 +1,251 @@
+// cam_stock.cpp
+//
+// C API wrapper around the Z-dexel stock model (dexel.h).
+//
+// Store shape follows the persistent clipper engine in cam_polygon.cpp:
+// entries are mutable, so each carries its own mutex and the file-local
+// map hands out shared_ptrs under a shared_mutex.  Like cam_bvh.cpp and
+// cam_heightmap.cpp this file reads mesh data only through the public
+// cg_mesh_* accessors, so it has no OCCT dependency and links into the
+// no-OCCT test builds.
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cam_error.h"
+#include "cam_geometry.h"
+#include "worker_pool.h"
+#include "dexel.h"
+
+namespace {
+
+struct CgStockData {
+    std::mutex mutex;  // serializes sweeps and reads on one stock
+    DexelStock grid;
+};
+
+} // namespace
+
+static std::shared_mutex g_stock_mutex;
+static std::unordered_map<uint64_t, std::shared_ptr<CgStockData>> g_stock_store;
+static std::atomic<uint64_t> g_stock_next_id{1};
+
+static std::shared_ptr<CgStockData> stock_store_get(uint64_t id) {
+    std::shared_lock<std::shared_mutex> lock(g_stock_mutex);
+    auto it = g_stock_store.find(id);
+    if (it == g_stock_store.end()) return nullptr;
+    return it->second;
+}
+
+static uint64_t stock_store_put(std::shared_ptr<CgStockData> stock) {
+    uint64_t id = g_stock_next_id.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock<std::shared_mutex> lock(g_stock_mutex);
+    g_stock_store.emplace(id, std::move(stock));
+    return id;
+}
+
+static bool validate_stock_args(const char* fn, const CgBbox& bounds,
+                                double cell_size) {
+    if (cell_size <= 0.0) {
+        set_last_error(std::string(fn) + ": cell_size must be positive");
+        return false;
+    }
+    if (!(bounds.xmax > bounds.xmin) || !(bounds.ymax > bounds.ymin) ||
+        !(bounds.zmax > bounds.zmin)) {
+        set_last_error(std::string(fn) + ": empty bounds");
+        return false;
+    }
+    return true;
+}
+
+static bool validate_tool(const char* fn, const CgToolDef& tool,
+                          DexelStock::Tool& out) {
+    const double radius = tool.diameter / 2.0;
+    if (radius <= 0.0) {
+        set_last_error(std::string(fn) + ": tool diameter must be positive");
+        return false;
+    }
+    if (tool.corner_radius < 0.0 || tool.corner_radius > radius) {
+        set_last_error(std::string(fn) +
+                       ": corner_radius must be in [0, diameter/2]");
+        return false;
+    }
+    out.radius        = radius;
+    out.corner_radius = tool.corner_radius;
+    return true;
+}
+
+extern "C" {
+
+CgStockId cg_stock_new(CgBbox bounds, double cell_size) {
+    if (!validate_stock_args("cg_stock_new", bounds, cell_size))
+        return CG_NULL_ID;
+    try {
+        auto stock = std::make_shared<CgStockData>();
+        stock->grid.build_block(bounds.xmin, bounds.ymin, bounds.zmin,
+                                bounds.xmax, bounds.ymax, bounds.zmax,
+                                cell_size);
+        return stock_store_put(std::move(stock));
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_stock_new: ") + ex.what());
+        return CG_NULL_ID;
+    } catch (...) {
+        set_last_error("cg_stock_new: unknown exception");
+        return CG_NULL_ID;
+    }
+}
+
+CgStockId cg_stock_new_from_mesh(CgMeshId mesh_id, CgBbox bounds,
+                                 double cell_size) {
+    if (!validate_stock_args("cg_stock_new_from_mesh", bounds, cell_size))
+        return CG_NULL_ID;
+    try {
+        // Same cell layout the dexel grid itself will use.
+        const size_t res_x =
+            size_t(std::ceil((bounds.xmax - bounds.xmin) / cell_size));
+        const size_t res_y =
+            size_t(std::ceil((bounds.ymax - bounds.ymin) / cell_size));
+        float* heights = nullptr;
+        if (cg_mesh_rasterize_heightmap(mesh_id, bounds, res_x, res_y,
+                                        &heights) != CG_OK)
+            return CG_NULL_ID;  // error string already set
+
+        auto stock = std::make_shared<CgStockData>();
+        stock->grid.build_from_heights(bounds.xmin, bounds.ymin, bounds.zmin,
+                                       bounds.xmax, bounds.ymax, cell_size,
+                                       heights);
+        cg_heightmap_free(heights);
+        return stock_store_put(std::move(stock));
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_stock_new_from_mesh: ") + ex.what());
+        return CG_NULL_ID;
+    } catch (...) {
+        set_last_error("cg_stock_new_from_mesh: unknown exception");
+        return CG_NULL_ID;
+    }
+}
+
+CgError cg_stock_subtract_sweep(CgStockId id, CgToolDef tool,
+                                const CgPoint3* path_points, size_t n_points,
+                                double* out_removed_volume,
+                                double* out_engagement_angle) {
+    if (!path_points) {
+        set_last_error("cg_stock_subtract_sweep: null path_points");
+        return CG_ERR_INVALID_ARG;
+    }
+    DexelStock::Tool dtool;
+    if (!validate_tool("cg_stock_subtract_sweep", tool, dtool))
+        return CG_ERR_INVALID_ARG;
+    auto stock = stock_store_get(id);
+    if (!stock) {
+        set_last_error("cg_stock_subtract_sweep: invalid stock handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    try {
+        std::lock_guard<std::mutex> lock(stock->mutex);
+        stock->grid.subtract_sweep(dtool, &path_points[0].x, n_points,
+                                   out_removed_volume, out_engagement_angle,
+                                   worker_pool::effective());
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_stock_subtract_sweep: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("cg_stock_subtract_sweep: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
+}
+
+CgError cg_stock_engagement(CgStockId id, CgToolDef tool,
+                            const CgPoint3* path_points, size_t n_points,
+                            double* out_removed_volume,
+                            double* out_engagement_angle) {
+    if (!path_points) {
+        set_last_error("cg_stock_engagement: null path_points");
+        return CG_ERR_INVALID_ARG;
+    }
+    DexelStock::Tool dtool;
+    if (!validate_tool("cg_stock_engagement", tool, dtool))
+        return CG_ERR_INVALID_ARG;
+    auto stock = stock_store_get(id);
+    if (!stock) {
+        set_last_error("cg_stock_engagement: invalid stock handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    try {
+        // Dry run: sweep a copy so the stored stock is untouched.
+        DexelStock scratch;
+        {
+            std::lock_guard<std::mutex> lock(stock->mutex);
+            scratch = stock->grid;
+        }
+        scratch.subtract_sweep(dtool, &path_points[0].x, n_points,
+                               out_removed_volume, out_engagement_angle,
+                               worker_pool::effective());
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_stock_engagement: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("cg_stock_engagement: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
+}
+
+double cg_stock_volume(CgStockId id) {
+    auto stock = stock_store_get(id);
+    if (!stock) {
+        set_last_error("cg_stock_volume: invalid stock handle");
+        return -1.0;
+    }
+    std::lock_guard<std::mutex> lock(stock->mutex);
+    return stock->grid.volume();
+}
+
+CgError cg_stock_heights(CgStockId id, float** out_heights,
+                         size_t* out_res_x, size_t* out_res_y) {
+    if (!out_heights || !out_res_x || !out_res_y) {
+        set_last_error("cg_stock_heights: null output argument");
+        return CG_ERR_INVALID_ARG;
+    }
+    *out_heights = nullptr;
+    *out_res_x   = 0;
+    *out_res_y   = 0;
+    auto stock = stock_store_get(id);
+    if (!stock) {
+        set_last_error("cg_stock_heights: invalid stock handle");
+        return CG_ERR_NULL_HANDLE;
+    }
+    try {
+        std::lock_guard<std::mutex> lock(stock->mutex);
+        const std::vector<double>& tops = stock->grid.tops();
+        auto grid = std::make_unique<float[]>(tops.size());
+        for (size_t i = 0; i < tops.size(); ++i)
+            grid[i] = float(tops[i]);
+        *out_heights = grid.release();
+        *out_res_x   = stock->grid.res_x();
+        *out_res_y   = stock->grid.res_y();
+        return CG_OK;
+    } catch (const std::exception& ex) {
+        set_last_error(std::string("cg_stock_heights: ") + ex.what());
+        return CG_ERR_NO_RESULT;
+    } catch (...) {
+        set_last_error("cg_stock_heights: unknown exception");
+        return CG_ERR_NO_RESULT;
+    }
+}
+
+void cg_stock_free(CgStockId id) {
+    if (id == CG_NULL_ID) return;
+    std::unique_lock<std::shared_mutex> lock(g_stock_mutex);
+    g_stock_store.erase(id);
+}
+
+} // extern "C"
@@ -0,0 +1,34 @@
+// cam_threads.cpp
+//
+// C API for the kernel-wide worker budget (worker_pool.h).  Kept in its own
+// translation unit (rather than cam_geometry.cpp) so that no-OCCT modules
+// and their standalone test binaries can link the thread controls without
+// pulling in the OCCT-backed kernel.
+
+#include "cam_error.h"
+#include "cam_geometry.h"
+#include "worker_pool.h"
+
+extern "C" {
+
+CgError cg_set_worker_threads(size_t n) {
+    // An absurd budget is a unit mix-up on the caller's side, not a wish.
+    if (n > 4096) {
+        set_last_error("cg_set_worker_threads: thread count out of range");
+        return CG_ERR_INVALID_ARG;
+    }
+    worker_pool::set_budget(n);
+    return CG_OK;
+}
+
+CgPoolStats cg_pool_stats(void) {
+    CgPoolStats s;
+    s.configured_threads = worker_pool::configured();
+    s.effective_threads  = worker_pool::effective();
+    s.parallel_batches =
+        worker_pool::g_batches.load(std::memory_order_relaxed);
+    s.tasks_executed = worker_pool::g_tasks.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // extern "C"
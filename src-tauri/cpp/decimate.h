@@ -0,0 +1,365 @@
+// decimate.h
+//
+// Quadric-error-metric mesh decimation (Garland & Heckbert style edge
+// collapse) for the viewport LOD chain.  The toolpath engine keeps the full
+// tessellation; the renderer asks for progressively coarser copies instead
+// of re-tessellating with a looser chord tolerance.
+//
+// This header has no dependency on OCCT so it can be compiled and tested
+// independently (same pattern as bvh.h and mesh_weld.h).  The C API wrappers
+// (cg_mesh_simplify / cg_mesh_build_lods) live in cam_geometry.cpp because
+// they create entries in the file-local mesh store.
+//
+// Design:
+//   - Every vertex accumulates the quadric of its incident triangle planes
+//     (area weighted).  An edge collapse costs v^T (Q0 + Q1) v at the
+//     position minimizing the quadric — found by solving the 3x3 system, or
+//     falling back to the midpoint/endpoints when it is singular.
+//   - Candidate collapses sit in a min-heap with lazy invalidation: each
+//     vertex carries a version stamp, and popped entries whose stamps are
+//     stale are discarded.  Collapsing a vertex re-pushes its surviving
+//     edges.
+//   - Boundary edges (one incident triangle) get a strong perpendicular
+//     constraint plane so open mesh rims keep their shape.
+//   - A collapse that would flip a surviving triangle's normal is rejected;
+//     the neighbourhood usually becomes collapsible again after nearby
+//     collapses re-queue it.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace decimate {
+
+namespace detail {
+
+// Symmetric 4x4 quadric, upper triangle stored row major.
+struct Quadric {
+    double m[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    void add_plane(double a, double b, double c, double d, double w) {
+        m[0] += w * a * a; m[1] += w * a * b; m[2] += w * a * c; m[3] += w * a * d;
+        m[4] += w * b * b; m[5] += w * b * c; m[6] += w * b * d;
+        m[7] += w * c * c; m[8] += w * c * d;
+        m[9] += w * d * d;
+    }
+
+    void add(const Quadric& q) {
+        for (int i = 0; i < 10; ++i) m[i] += q.m[i];
+    }
+
+    double eval(double x, double y, double z) const {
+        return m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x
+             + m[4] * y * y + 2 * m[5] * y * z + 2 * m[6] * y
+             + m[7] * z * z + 2 * m[8] * z
+             + m[9];
+    }
+
+    // Solve for the position minimizing the quadric.  Returns false when
+    // the 3x3 system is (near) singular.
+    bool optimal(double& x, double& y, double& z) const {
+        const double a = m[0], b = m[1], c = m[2];
+        const double e = m[4], f = m[5], h = m[7];
+        const double det = a * (e * h - f * f) - b * (b * h - f * c)
+                         + c * (b * f - e * c);
+        if (std::fabs(det) < 1e-12) return false;
+        const double rx = -m[3], ry = -m[6], rz = -m[8];
+        x = (rx * (e * h - f * f) - b * (ry * h - f * rz)
+             + c * (ry * f - e * rz)) / det;
+        y = (a * (ry * h - rz * f) - rx * (b * h - f * c)
+             + c * (b * rz - ry * c)) / det;
+        z = (a * (e * rz - ry * f) - b * (b * rz - ry * c)
+             + rx * (b * f - e * c)) / det;
+        return true;
+    }
+};
+
+inline uint64_t edge_key(uint32_t a, uint32_t b) {
+    if (a > b) std::swap(a, b);
+    return (uint64_t(a) << 32) | b;
+}
+
+struct Candidate {
+    double   cost;
+    double   pos[3];
+    uint32_t v0, v1;
+    uint32_t stamp0, stamp1;
+    bool operator>(const Candidate& o) const { return cost > o.cost; }
+};
+
+} // namespace detail
+
+// Collapse edges until at most target_triangles remain or the cheapest
+// collapse would cost more than max_error.  vertices/indices are rewritten
+// in place and compacted; attribute buffers do not survive (recompute
+// normals afterwards with recompute_normals()).  Returns the final
+// triangle count.
+template <typename Real>
+size_t simplify(std::vector<Real>&     vertices,
+                std::vector<uint32_t>& indices,
+                size_t                 target_triangles,
+                double max_error = std::numeric_limits<double>::infinity()) {
+    using namespace detail;
+
+    const size_t n_verts = vertices.size() / 3;
+    const size_t n_tris  = indices.size() / 3;
+    if (n_verts == 0 || n_tris <= target_triangles) return n_tris;
+
+    // Working copies in double precision.
+    std::vector<std::array<double, 3>> pos(n_verts);
+    for (size_t i = 0; i < n_verts; ++i)
+        pos[i] = {double(vertices[i * 3]), double(vertices[i * 3 + 1]),
+                  double(vertices[i * 3 + 2])};
+
+    std::vector<std::array<uint32_t, 3>> tris(n_tris);
+    std::vector<bool> tri_live(n_tris, true);
+    for (size_t t = 0; t < n_tris; ++t)
+        tris[t] = {indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2]};
+
+    std::vector<std::vector<uint32_t>> vert_tris(n_verts);
+    for (size_t t = 0; t < n_tris; ++t)
+        for (uint32_t v : tris[t]) vert_tris[v].push_back(uint32_t(t));
+
+    // Per-vertex quadrics from incident triangle planes (area weighted:
+    // the unnormalized cross product carries the area factor).
+    auto tri_plane = [&](size_t t, double out[4], double& area2) {
+        const auto& a = pos[tris[t][0]];
+        const auto& b = pos[tris[t][1]];
+        const auto& c = pos[tris[t][2]];
+        const double e1[3] = {b[0]-a[0], b[1]-a[1], b[2]-a[2]};
+        const double e2[3] = {c[0]-a[0], c[1]-a[1], c[2]-a[2]};
+        out[0] = e1[1]*e2[2] - e1[2]*e2[1];
+        out[1] = e1[2]*e2[0] - e1[0]*e2[2];
+        out[2] = e1[0]*e2[1] - e1[1]*e2[0];
+        area2  = std::sqrt(out[0]*out[0] + out[1]*out[1] + out[2]*out[2]);
+        if (area2 > 1e-20) {
+            out[0] /= area2; out[1] /= area2; out[2] /= area2;
+        }
+        out[3] = -(out[0]*a[0] + out[1]*a[1] + out[2]*a[2]);
+    };
+
+    std::vector<Quadric> quadric(n_verts);
+    std::unordered_map<uint64_t, int> edge_tris;  // occurrence count per edge
+    edge_tris.reserve(n_tris * 3);
+    for (size_t t = 0; t < n_tris; ++t) {
+        double p[4], area2;
+        tri_plane(t, p, area2);
+        if (area2 <= 1e-20) { tri_live[t] = false; continue; }
+        for (uint32_t v : tris[t])
+            quadric[v].add_plane(p[0], p[1], p[2], p[3], area2);
+        for (int e = 0; e < 3; ++e)
+            ++edge_tris[edge_key(tris[t][e], tris[t][(e + 1) % 3])];
+    }
+
+    // Boundary constraint: a heavy plane through the edge, perpendicular
+    // to the lone incident triangle.
+    constexpr double kBoundaryWeight = 1000.0;
+    for (size_t t = 0; t < n_tris; ++t) {
+        if (!tri_live[t]) continue;
+        double p[4], area2;
+        for (int e = 0; e < 3; ++e) {
+            const uint32_t va = tris[t][e], vb = tris[t][(e + 1) % 3];
+            if (edge_tris[edge_key(va, vb)] != 1) continue;
+            tri_plane(t, p, area2);
+            const double ex = pos[vb][0]-pos[va][0], ey = pos[vb][1]-pos[va][1],
+                         ez = pos[vb][2]-pos[va][2];
+            double nx = ey*p[2] - ez*p[1];
+            double ny = ez*p[0] - ex*p[2];
+            double nz = ex*p[1] - ey*p[0];
+            const double len = std::sqrt(nx*nx + ny*ny + nz*nz);
+            if (len < 1e-20) continue;
+            nx /= len; ny /= len; nz /= len;
+            const double d = -(nx*pos[va][0] + ny*pos[va][1] + nz*pos[va][2]);
+            const double w = kBoundaryWeight * (ex*ex + ey*ey + ez*ez);
+            quadric[va].add_plane(nx, ny, nz, d, w);
+            quadric[vb].add_plane(nx, ny, nz, d, w);
+        }
+    }
+
+    std::vector<uint32_t> stamp(n_verts, 0);
+    std::vector<bool>     alive(n_verts, true);
+    std::priority_queue<Candidate, std::vector<Candidate>,
+                        std::greater<Candidate>> heap;
+
+    auto push_edge = [&](uint32_t v0, uint32_t v1) {
+        Quadric q = quadric[v0];
+        q.add(quadric[v1]);
+        Candidate c;
+        if (!q.optimal(c.pos[0], c.pos[1], c.pos[2])) {
+            // Singular: best of midpoint and the two endpoints.
+            const double cand[3][3] = {
+                {0.5 * (pos[v0][0] + pos[v1][0]),
+                 0.5 * (pos[v0][1] + pos[v1][1]),
+                 0.5 * (pos[v0][2] + pos[v1][2])},
+                {pos[v0][0], pos[v0][1], pos[v0][2]},
+                {pos[v1][0], pos[v1][1], pos[v1][2]}};
+            double best = std::numeric_limits<double>::infinity();
+            for (const auto& p : cand) {
+                const double e = q.eval(p[0], p[1], p[2]);
+                if (e < best) {
+                    best = e;
+                    c.pos[0] = p[0]; c.pos[1] = p[1]; c.pos[2] = p[2];
+                }
+            }
+        }
+        c.cost   = std::max(0.0, q.eval(c.pos[0], c.pos[1], c.pos[2]));
+        c.v0     = v0;
+        c.v1     = v1;
+        c.stamp0 = stamp[v0];
+        c.stamp1 = stamp[v1];
+        heap.push(c);
+    };
+
+    for (const auto& kv : edge_tris) {
+        const uint32_t a = uint32_t(kv.first >> 32);
+        const uint32_t b = uint32_t(kv.first & 0xffffffffu);
+        push_edge(a, b);
+    }
+
+    size_t live_tris = 0;
+    for (bool l : tri_live) live_tris += l;
+
+    // Would moving v0/v1 to new_pos flip any surviving triangle?
+    auto flips = [&](uint32_t vm, uint32_t vo, const double* np) {
+        for (uint32_t t : vert_tris[vm]) {
+            if (!tri_live[t]) continue;
+            const auto& tr = tris[t];
+            if (tr[0] == vo || tr[1] == vo || tr[2] == vo) continue; // dies
+            double a[3], b[3], c[3], a2[3], b2[3], c2[3];
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = tr[k];
+                double* dst  = (k == 0) ? a  : (k == 1) ? b  : c;
+                double* dst2 = (k == 0) ? a2 : (k == 1) ? b2 : c2;
+                for (int d = 0; d < 3; ++d) {
+                    dst[d]  = pos[v][d];
+                    dst2[d] = (v == vm) ? np[d] : pos[v][d];
+                }
+            }
+            auto cross_z = [](const double* p, const double* q,
+                              const double* r, double* out) {
+                const double e1[3] = {q[0]-p[0], q[1]-p[1], q[2]-p[2]};
+                const double e2[3] = {r[0]-p[0], r[1]-p[1], r[2]-p[2]};
+                out[0] = e1[1]*e2[2] - e1[2]*e2[1];
+                out[1] = e1[2]*e2[0] - e1[0]*e2[2];
+                out[2] = e1[0]*e2[1] - e1[1]*e2[0];
+            };
+            double n1[3], n2[3];
+            cross_z(a, b, c, n1);
+            cross_z(a2, b2, c2, n2);
+            if (n1[0]*n2[0] + n1[1]*n2[1] + n1[2]*n2[2] <= 0.0) return true;
+        }
+        return false;
+    };
+
+    while (live_tris > target_triangles && !heap.empty()) {
+        Candidate c = heap.top();
+        heap.pop();
+        if (!alive[c.v0] || !alive[c.v1]) continue;
+        if (stamp[c.v0] != c.stamp0 || stamp[c.v1] != c.stamp1) continue;
+        if (c.cost > max_error) break;
+        if (flips(c.v0, c.v1, c.pos) || flips(c.v1, c.v0, c.pos)) continue;
+
+        // Collapse v1 into v0 at the optimal position.
+        pos[c.v0] = {c.pos[0], c.pos[1], c.pos[2]};
+        quadric[c.v0].add(quadric[c.v1]);
+        alive[c.v1] = false;
+        ++stamp[c.v0];
+
+        for (uint32_t t : vert_tris[c.v1]) {
+            if (!tri_live[t]) continue;
+            auto& tr = tris[t];
+            if (tr[0] == c.v0 || tr[1] == c.v0 || tr[2] == c.v0) {
+                tri_live[t] = false;  // shared triangle degenerates
+                --live_tris;
+                continue;
+            }
+            for (auto& v : tr)
+                if (v == c.v1) v = c.v0;
+            vert_tris[c.v0].push_back(t);
+        }
+        vert_tris[c.v1].clear();
+        vert_tris[c.v1].shrink_to_fit();
+
+        // Re-queue the surviving edges around the merged vertex.
+        std::unordered_set<uint32_t> neighbours;
+        for (uint32_t t : vert_tris[c.v0]) {
+            if (!tri_live[t]) continue;
+            for (uint32_t v : tris[t])
+                if (v != c.v0 && alive[v]) neighbours.insert(v);
+        }
+        for (uint32_t v : neighbours) push_edge(c.v0, v);
+    }
+
+    // Compact: drop dead vertices and triangles.
+    std::vector<uint32_t> remap(n_verts, UINT32_MAX);
+    std::vector<Real> out_verts;
+    out_verts.reserve(vertices.size());
+    for (size_t t = 0; t < n_tris; ++t) {
+        if (!tri_live[t]) continue;
+        for (uint32_t v : tris[t])
+            if (remap[v] == UINT32_MAX) {
+                remap[v] = uint32_t(out_verts.size() / 3);
+                out_verts.insert(out_verts.end(),
+                                 {Real(pos[v][0]), Real(pos[v][1]),
+                                  Real(pos[v][2])});
+            }
+    }
+    size_t out_i = 0;
+    for (size_t t = 0; t < n_tris; ++t) {
+        if (!tri_live[t]) continue;
+        indices[out_i + 0] = remap[tris[t][0]];
+        indices[out_i + 1] = remap[tris[t][1]];
+        indices[out_i + 2] = remap[tris[t][2]];
+        out_i += 3;
+    }
+    indices.resize(out_i);
+    vertices.swap(out_verts);
+    return out_i / 3;
+}
+
+// Rebuild area-weighted, normalized vertex normals from scratch (decimation
+// invalidates the stored ones).
+template <typename Real>
+void recompute_normals(const std::vector<Real>&     vertices,
+                       const std::vector<uint32_t>& indices,
+                       std::vector<Real>&           normals) {
+    normals.assign(vertices.size(), Real(0));
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const uint32_t ia = indices[t], ib = indices[t + 1], ic = indices[t + 2];
+        const double ax = vertices[ia*3], ay = vertices[ia*3+1], az = vertices[ia*3+2];
+        const double e1x = vertices[ib*3]   - ax;
+        const double e1y = vertices[ib*3+1] - ay;
+        const double e1z = vertices[ib*3+2] - az;
+        const double e2x = vertices[ic*3]   - ax;
+        const double e2y = vertices[ic*3+1] - ay;
+        const double e2z = vertices[ic*3+2] - az;
+        const double nx = e1y*e2z - e1z*e2y;
+        const double ny = e1z*e2x - e1x*e2z;
+        const double nz = e1x*e2y - e1y*e2x;
+        for (uint32_t v : {ia, ib, ic}) {
+            normals[v*3+0] += Real(nx);
+            normals[v*3+1] += Real(ny);
+            normals[v*3+2] += Real(nz);
+        }
+    }
+    const size_t nv = normals.size() / 3;
+    for (size_t i = 0; i < nv; ++i) {
+        const double x = normals[i*3], y = normals[i*3+1], z = normals[i*3+2];
+        const double len = std::sqrt(x*x + y*y + z*z);
+        if (len > 1e-12) {
+            normals[i*3+0] = Real(x / len);
+            normals[i*3+1] = Real(y / len);
+            normals[i*3+2] = Real(z / len);
+        }
+    }
+}
+
+} // namespace decimate
@@ -0,0 +1,263 @@
+// dexel.h
+//
+// Z-dexel stock model for material-removal simulation: a regular XY grid of
+// vertical material spans that a tool sweep carves from above.  The
+// closed-loop feed optimizer reads back per-point removed volume and
+// engagement angle to know how hard the cutter is working at every toolpath
+// point.
+//
+// This header has no dependency on OCCT so it can be compiled and tested
+// independently (same pattern as bvh.h and heightmap.h).  The C API wrapper
+// lives in cam_stock.cpp.
+//
+// Design:
+//   - One span per column: column (ix, iy) holds material from the common
+//     floor z_min up to top_[iy * res_x + ix].  This is the 3-axis model —
+//     the cutter always approaches from +Z, so removal only lowers tops and
+//     never splits a span.  (Undercutting 5-axis sweeps would need a span
+//     list per column; out of scope for this kernel.)
+//   - Tool shape is radius + corner radius: 0 = flat endmill, diameter/2 =
+//     ball nose, anything between = bull nose.  profile(r) gives the height
+//     of the cutting surface above the tip at radial distance r.
+//   - subtract_sweep() parallelizes across COLUMN STRIPS: the grid is cut
+//     into vertical strips and each worker owns some strips for the whole
+//     sweep, processing the path points in order within them.  A column is
+//     only ever touched by its owner, so there are no atomics on the grid
+//     and the result is independent of the worker count; per-point removal
+//     and engagement tallies are reduced across workers afterwards in a
+//     fixed order, keeping them deterministic too.
+//   - Engagement angle is estimated per point by sampling the cutting-edge
+//     rim at kRimSamples angles BEFORE that point's removal: the fraction
+//     of rim samples still buried in material, scaled to 2*pi.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+class DexelStock {
+public:
+    static constexpr int kRimSamples = 64;
+
+    struct Tool {
+        double radius        = 0.0;  // cutting radius (diameter / 2)
+        double corner_radius = 0.0;  // 0 flat .. radius ball
+    };
+
+    DexelStock() = default;
+
+    // Full block of material over [xmin, xmax) x [ymin, ymax), columns of
+    // cell_size x cell_size, floor z_min, tops at z_max.
+    void build_block(double xmin, double ymin, double zmin,
+                     double xmax, double ymax, double zmax,
+                     double cell_size) {
+        init_grid(xmin, ymin, zmin, xmax, ymax, cell_size);
+        std::fill(top_.begin(), top_.end(), zmax);
+    }
+
+    // Material bounded above by a heightmap (layout as heightmap.h: row
+    // major, x fastest, -infinity = no material).  Heights below the floor
+    // clamp to the floor (empty column).
+    void build_from_heights(double xmin, double ymin, double zmin,
+                            double xmax, double ymax, double cell_size,
+                            const float* heights) {
+        init_grid(xmin, ymin, zmin, xmax, ymax, cell_size);
+        for (size_t i = 0; i < top_.size(); ++i) {
+            const double h = double(heights[i]);
+            top_[i] = std::isfinite(h) ? std::max(zmin_, h) : zmin_;
+        }
+    }
+
+    bool   empty() const { return top_.empty(); }
+    size_t res_x() const { return res_x_; }
+    size_t res_y() const { return res_y_; }
+    double cell_size() const { return cell_; }
+    const std::vector<double>& tops() const { return top_; }
+
+    // Total remaining material volume.
+    double volume() const {
+        double v = 0.0;
+        for (double t : top_) v += t - zmin_;
+        return v * cell_ * cell_;
+    }
+
+    // Carve the tool along path points in order.  Optional per-point
+    // outputs (pass nullptr to skip):
+    //   out_removed[i]    — material volume removed at point i
+    //   out_engagement[i] — engagement angle in radians [0, 2*pi], sampled
+    //                       before point i's removal
+    // n_workers == 0 means hardware concurrency.
+    void subtract_sweep(const Tool& tool,
+                        const double* points_xyz, size_t n_points,
+                        double* out_removed, double* out_engagement,
+                        size_t n_workers = 0) {
+        if (out_removed) std::fill(out_removed, out_removed + n_points, 0.0);
+        if (out_engagement)
+            std::fill(out_engagement, out_engagement + n_points, 0.0);
+        if (top_.empty() || n_points == 0 || tool.radius <= 0.0) return;
+
+        if (n_workers == 0) {
+            const unsigned hw = std::thread::hardware_concurrency();
+            n_workers = hw ? hw : 1;
+        }
+
+        // Vertical strips of columns; each strip is owned by one worker for
+        // the whole sweep.  Narrow strips interleave ownership along X so a
+        // path that stays in one grid region still spreads across workers.
+        const size_t strip_w  = std::max<size_t>(8, cell_to_span(tool.radius));
+        const size_t n_strips = (res_x_ + strip_w - 1) / strip_w;
+        n_workers = std::min(n_workers, n_strips);
+
+        const double cell_area = cell_ * cell_;
+        // Sample the rim half a cell inside the cutting radius so the
+        // samples land in columns the cutter actually sweeps — at exactly
+        // R they would fall in the untouched columns just outside and a
+        // repeated pass would still read as engaged.
+        const double rim_r =
+            std::max(0.5 * tool.radius, tool.radius - 0.5 * cell_);
+        const double rim_z_off = profile(tool, rim_r);
+
+        std::vector<std::vector<double>>   removed(n_workers);
+        std::vector<std::vector<uint32_t>> engaged(n_workers);
+
+        std::atomic<size_t> next_strip{0};
+        auto worker = [&](size_t w) {
+            std::vector<double>&   rem = removed[w];
+            std::vector<uint32_t>& eng = engaged[w];
+            if (out_removed) rem.assign(n_points, 0.0);
+            if (out_engagement) eng.assign(n_points, 0);
+
+            for (size_t s = next_strip.fetch_add(1, std::memory_order_relaxed);
+                 s < n_strips;
+                 s = next_strip.fetch_add(1, std::memory_order_relaxed)) {
+                const size_t sx0 = s * strip_w;
+                const size_t sx1 = std::min(res_x_, sx0 + strip_w);
+                sweep_strip(tool, points_xyz, n_points, sx0, sx1, cell_area,
+                            rim_r, rim_z_off,
+                            out_removed ? rem.data() : nullptr,
+                            out_engagement ? eng.data() : nullptr);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(n_workers - 1);
+        for (size_t w = 1; w < n_workers; ++w)
+            threads.emplace_back(worker, w);
+        worker(0);
+        for (auto& t : threads) t.join();
+
+        // Fixed-order reduction keeps the outputs deterministic.
+        for (size_t w = 0; w < n_workers; ++w) {
+            if (out_removed && !removed[w].empty())
+                for (size_t i = 0; i < n_points; ++i)
+                    out_removed[i] += removed[w][i];
+            if (out_engagement && !engaged[w].empty())
+                for (size_t i = 0; i < n_points; ++i)
+                    out_engagement[i] += engaged[w][i];
+        }
+        if (out_engagement)
+            for (size_t i = 0; i < n_points; ++i)
+                out_engagement[i] *= 2.0 * kPi / kRimSamples;
+    }
+
+private:
+    static constexpr double kPi = 3.14159265358979323846;
+
+    size_t res_x_ = 0, res_y_ = 0;
+    double xmin_ = 0, ymin_ = 0, zmin_ = 0, cell_ = 0;
+    std::vector<double> top_;
+
+    void init_grid(double xmin, double ymin, double zmin,
+                   double xmax, double ymax, double cell_size) {
+        xmin_  = xmin;
+        ymin_  = ymin;
+        zmin_  = zmin;
+        cell_  = cell_size;
+        res_x_ = size_t(std::ceil((xmax - xmin) / cell_size));
+        res_y_ = size_t(std::ceil((ymax - ymin) / cell_size));
+        top_.assign(res_x_ * res_y_, zmin);
+    }
+
+    size_t cell_to_span(double dist) const {
+        return size_t(std::ceil(dist / cell_)) + 1;
+    }
+
+    // Height of the cutting surface above the tool tip at radial distance r.
+    static double profile(const Tool& tool, double r) {
+        const double flat_r = tool.radius - tool.corner_radius;
+        if (r <= flat_r) return 0.0;
+        const double d  = r - flat_r;
+        const double c  = tool.corner_radius;
+        const double s2 = c * c - d * d;
+        return c - std::sqrt(std::max(0.0, s2));
+    }
+
+    // Run the whole sweep over columns ix in [sx0, sx1).
+    void sweep_strip(const Tool& tool, const double* pts, size_t n_points,
+                     size_t sx0, size_t sx1, double cell_area,
+                     double rim_r, double rim_z_off,
+                     double* rem, uint32_t* eng) {
+        const double R = tool.radius;
+        for (size_t i = 0; i < n_points; ++i) {
+            const double cx = pts[i * 3 + 0];
+            const double cy = pts[i * 3 + 1];
+            const double cz = pts[i * 3 + 2];
+
+            // Engagement first: rim samples still buried before this cut.
+            if (eng) {
+                const double rim_z = cz + rim_z_off;
+                for (int sAngle = 0; sAngle < kRimSamples; ++sAngle) {
+                    const double a  = 2.0 * kPi * sAngle / kRimSamples;
+                    const double px = cx + rim_r * std::cos(a);
+                    if (px < xmin_) continue;
+                    const size_t ix = size_t((px - xmin_) / cell_);
+                    if (ix < sx0 || ix >= sx1) continue;
+                    const double py = cy + rim_r * std::sin(a);
+                    if (py < ymin_) continue;
+                    const size_t iy = size_t((py - ymin_) / cell_);
+                    if (iy >= res_y_) continue;
+                    if (top_[iy * res_x_ + ix] > rim_z + 1e-9) ++eng[i];
+                }
+            }
+
+            // Footprint columns inside this strip.
+            const double fx0 = (cx - R - xmin_) / cell_ - 0.5;
+            const double fx1 = (cx + R - xmin_) / cell_ - 0.5;
+            if (fx1 < double(sx0) || fx0 > double(sx1 - 1)) continue;
+            const size_t ix0 =
+                std::max(sx0, size_t(std::max(0.0, std::ceil(fx0))));
+            const size_t ix1 =
+                std::min(sx1 - 1, size_t(std::max(0.0, fx1)));
+
+            const double fy0 = (cy - R - ymin_) / cell_ - 0.5;
+            const double fy1 = (cy + R - ymin_) / cell_ - 0.5;
+            if (fy1 < 0.0 || fy0 > double(res_y_ - 1)) continue;
+            const size_t iy0 = size_t(std::max(0.0, std::ceil(fy0)));
+            const size_t iy1 =
+                std::min(res_y_ - 1, size_t(std::max(0.0, fy1)));
+            if (ix0 > ix1) continue;
+
+            for (size_t iy = iy0; iy <= iy1; ++iy) {
+                const double py = ymin_ + (double(iy) + 0.5) * cell_ - cy;
+                double* row = &top_[iy * res_x_];
+                for (size_t ix = ix0; ix <= ix1; ++ix) {
+                    const double px =
+                        xmin_ + (double(ix) + 0.5) * cell_ - cx;
+                    const double r = std::sqrt(px * px + py * py);
+                    if (r > R) continue;
+                    const double cut_z =
+                        std::max(zmin_, cz + profile(tool, r));
+                    if (row[ix] > cut_z) {
+                        if (rem) rem[i] += (row[ix] - cut_z) * cell_area;
+                        row[ix] = cut_z;
+                    }
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,115 @@
+// geom_cache.h
+//
+// Relocatable binary snapshot of the kernel's derived geometry.  Reopening a
+// project re-derives every mesh from the B-rep — tessellate, weld, normals —
+// which dwarfs the actual file parse once the shape cache hits.  The snapshot
+// sidecar written by cg_cache_save stores the mesh store's flat buffers in a
+// layout that can be memory-mapped and served as-is: cg_cache_load maps the
+// file read-only and registers each mesh as a zero-copy view, so the reopen
+// cost is one mmap and pages fault in as the viewport touches them.
+//
+// This header has no dependency on OCCT so it can be compiled and tested
+// independently (same pattern as stl_import.h and mesh_weld.h).
+// cg_cache_save / cg_cache_load in cam_geometry.cpp drive it.
+//
+// File layout (little-endian, as is every platform this kernel ships on):
+//   FileHeader                          (16 bytes)
+//   MeshRecord[n_meshes]                (48 bytes each)
+//   payload sections: per mesh, vertices then normals then indices, each
+//   starting on a kAlign boundary.
+//
+// Records carry absolute byte offsets rather than implied packing, so a
+// future writer can reorder, deduplicate, or append new section kinds
+// (BVHs, feature tables) without invalidating this reader.  Section
+// offsets are kAlign-aligned and the mapping base is page-aligned, so
+// every section pointer is correctly aligned for its element type.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace geom_cache {
+
+constexpr char     kMagic[8] = {'C', 'G', 'C', 'A', 'C', 'H', 'E', '1'};
+constexpr uint32_t kVersion  = 1;
+constexpr size_t   kAlign    = 64;  // section alignment (covers f64, one cache line)
+
+struct FileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t n_meshes;
+};
+static_assert(sizeof(FileHeader) == 16, "FileHeader layout is the file format");
+
+struct MeshRecord {
+    uint32_t precision;        // CgMeshPrecision value, round-tripped verbatim
+    uint32_t scalar_bytes;     // 8 (f64) or 4 (f32): vertex/normal element size
+    uint64_t n_vertices;       // xyz triples in each of vertices / normals
+    uint64_t n_indices;        // index scalars (3 per triangle)
+    uint64_t vertices_offset;  // absolute byte offsets, kAlign-aligned
+    uint64_t normals_offset;
+    uint64_t indices_offset;
+};
+static_assert(sizeof(MeshRecord) == 48, "MeshRecord layout is the file format");
+
+inline size_t align_up(size_t v) { return (v + kAlign - 1) & ~(kAlign - 1); }
+
+// Fill the offset fields of records whose counts and scalar sizes are
+// already set.  Returns the total file size.
+inline size_t plan_offsets(std::vector<MeshRecord>& records) {
+    size_t off = sizeof(FileHeader) + records.size() * sizeof(MeshRecord);
+    for (MeshRecord& r : records) {
+        const size_t vertex_bytes = size_t(r.n_vertices) * 3 * r.scalar_bytes;
+        off = align_up(off);
+        r.vertices_offset = off;
+        off += vertex_bytes;
+        off = align_up(off);
+        r.normals_offset = off;
+        off += vertex_bytes;
+        off = align_up(off);
+        r.indices_offset = off;
+        off += size_t(r.n_indices) * sizeof(uint32_t);
+    }
+    return off;
+}
+
+// Validate a mapped snapshot and copy out its records.  Rejects bad magic or
+// version, truncated headers or payloads, misaligned offsets, and counts
+// whose payload would overflow the arithmetic.  out_records is only
+// meaningful when true is returned.
+inline bool validate(const uint8_t* data, size_t size,
+                     std::vector<MeshRecord>& out_records) {
+    out_records.clear();
+    if (!data || size < sizeof(FileHeader)) return false;
+    FileHeader hdr;
+    std::memcpy(&hdr, data, sizeof(hdr));
+    if (std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) != 0) return false;
+    if (hdr.version != kVersion) return false;
+    const size_t n = hdr.n_meshes;
+    if (n > (size - sizeof(FileHeader)) / sizeof(MeshRecord)) return false;
+    out_records.resize(n);
+    std::memcpy(out_records.data(), data + sizeof(FileHeader),
+                n * sizeof(MeshRecord));
+    for (const MeshRecord& r : out_records) {
+        if (r.scalar_bytes != 4 && r.scalar_bytes != 8) return false;
+        // No payload can exceed the file; bounding the counts by `size`
+        // first also rules out overflow in the byte-size products below.
+        if (r.n_vertices > size / (3 * r.scalar_bytes)) return false;
+        if (r.n_indices > size / sizeof(uint32_t)) return false;
+        const uint64_t vertex_bytes = r.n_vertices * 3 * r.scalar_bytes;
+        const uint64_t index_bytes  = r.n_indices * sizeof(uint32_t);
+        const uint64_t sections[3][2] = {{r.vertices_offset, vertex_bytes},
+                                         {r.normals_offset, vertex_bytes},
+                                         {r.indices_offset, index_bytes}};
+        for (const auto& s : sections) {
+            if (s[0] % kAlign != 0) return false;
+            if (s[0] > size || s[1] > size - s[0]) return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace geom_cache
@@ -10,7 +10,11 @@
 //   - IDs start at 1.  0 is always the null handle (CG_NULL_ID).
 //   - A single atomic counter generates IDs for both shapes and meshes,
 //     guaranteeing that every handle in the system is globally unique.
-//   - std::shared_mutex provides concurrent read / exclusive write access.
+//   - Storage is sharded: each shard owns its own std::shared_mutex and maps,
+//     and an ID maps to shard (id & (kShardCount - 1)).  Sequential IDs land
+//     on different shards, so parallel readers hammering distinct handles
+//     take distinct locks instead of ping-ponging one reader count between
+//     cores.  Shards are cache-line aligned to avoid false sharing.
 //   - ShapeT must be copy-constructible (TopoDS_Shape satisfies this via
 //     OCCT's internal ref-counting).
 //   - MeshT must be copy-constructible (opencascade::handle<T> is a
@@ -28,6 +32,11 @@
 template <typename ShapeT, typename MeshT>
 class HandleRegistryBase {
 public:
+    // Number of independent lock domains.  Power of two so shard selection is
+    // a mask; 16 keeps per-shard contention negligible even for 32 workers
+    // while the per-registry footprint stays small.
+    static constexpr size_t kShardCount = 16;
+
     HandleRegistryBase() : next_id_(1) {}
 
     // Non-copyable, non-movable (singleton semantics).
@@ -41,16 +50,18 @@ public:
     // Copy shape into the registry and return its ID.  Thread-safe.
     uint64_t store_shape(const ShapeT& shape) {
         uint64_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
-        std::unique_lock<std::shared_mutex> lock(mutex_);
-        shapes_.emplace(id, shape);
+        Shard& shard = shard_for(id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.shapes.emplace(id, shape);
         return id;
     }
 
     // Copy mesh into the registry and return its ID.  Thread-safe.
     uint64_t store_mesh(const MeshT& mesh) {
         uint64_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
-        std::unique_lock<std::shared_mutex> lock(mutex_);
-        meshes_.emplace(id, mesh);
+        Shard& shard = shard_for(id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.meshes.emplace(id, mesh);
         return id;
     }
 
@@ -65,9 +76,10 @@ public:
     // not hold this reference across a concurrent free_shape() call on the
     // same id.  Rust ownership guarantees this in practice.
     const ShapeT& get_shape(uint64_t id) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        auto it = shapes_.find(id);
-        if (it == shapes_.end())
+        const Shard& shard = shard_for(id);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.shapes.find(id);
+        if (it == shard.shapes.end())
             throw std::out_of_range("HandleRegistry: invalid shape ID");
         return it->second;
     }
@@ -75,9 +87,10 @@ public:
     // Return a const reference to the stored mesh handle.
     // Throws std::out_of_range if id is not present.
     const MeshT& get_mesh(uint64_t id) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        auto it = meshes_.find(id);
-        if (it == meshes_.end())
+        const Shard& shard = shard_for(id);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.meshes.find(id);
+        if (it == shard.meshes.end())
             throw std::out_of_range("HandleRegistry: invalid mesh ID");
         return it->second;
     }
@@ -88,14 +101,16 @@ public:
 
     // Remove shape from registry.  Returns true if removed, false if not found.
     bool free_shape(uint64_t id) {
-        std::unique_lock<std::shared_mutex> lock(mutex_);
-        return shapes_.erase(id) > 0;
+        Shard& shard = shard_for(id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.shapes.erase(id) > 0;
     }
 
     // Remove mesh from registry.  Returns true if removed, false if not found.
     bool free_mesh(uint64_t id) {
-        std::unique_lock<std::shared_mutex> lock(mutex_);
-        return meshes_.erase(id) > 0;
+        Shard& shard = shard_for(id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.meshes.erase(id) > 0;
     }
 
     // ---------------------------------------------------------------------------
@@ -103,18 +118,35 @@ public:
     // ---------------------------------------------------------------------------
 
     size_t shape_count() const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        return shapes_.size();
+        size_t total = 0;
+        for (const Shard& shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            total += shard.shapes.size();
+        }
+        return total;
     }
 
     size_t mesh_count() const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        return meshes_.size();
+        size_t total = 0;
+        for (const Shard& shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            total += shard.meshes.size();
+        }
+        return total;
     }
 
 private:
-    mutable std::shared_mutex                 mutex_;
-    std::atomic<uint64_t>                     next_id_;
-    std::unordered_map<uint64_t, ShapeT>      shapes_;
-    std::unordered_map<uint64_t, MeshT>       meshes_;
+    // One lock domain.  alignas(64) keeps each shard's mutex on its own cache
+    // line so reader-count updates in one shard never invalidate another's.
+    struct alignas(64) Shard {
+        mutable std::shared_mutex            mutex;
+        std::unordered_map<uint64_t, ShapeT> shapes;
+        std::unordered_map<uint64_t, MeshT>  meshes;
+    };
+
+    Shard&       shard_for(uint64_t id)       { return shards_[id & (kShardCount - 1)]; }
+    const Shard& shard_for(uint64_t id) const { return shards_[id & (kShardCount - 1)]; }
+
+    std::atomic<uint64_t> next_id_;
+    Shard                 shards_[kShardCount];
 };
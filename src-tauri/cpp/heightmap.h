@@ -0,0 +1,185 @@
+// heightmap.h
+//
+// Max-Z heightmap rasterization of a triangle soup, for relief machining
+// and 3D raster finishing: the toolpath engine asks for a regular Z-grid of
+// the part once, instead of projecting grid points one by one through the
+// FFI.
+//
+// This header has no dependency on OCCT so it can be compiled and tested
+// independently (same pattern as bvh.h).  The C API wrapper lives in
+// cam_heightmap.cpp.
+//
+// Design:
+//   - Samples are cell centers: sample (ix, iy) lies at
+//     (xmin + (ix + 0.5) * dx, ymin + (iy + 0.5) * dy).  The output is
+//     row-major with x fastest: out[iy * res_x + ix].
+//   - Cells covered by no triangle are set to -infinity, which stays
+//     totally ordered under the max accumulation and is an unambiguous
+//     "no data" marker for consumers.
+//   - Parallelization is by horizontal bands of rows.  Triangles are binned
+//     to the bands their XY bounds touch in one sequential pass, then each
+//     band is rasterized by one worker writing its own rows — disjoint
+//     output, no atomics, no per-cell locking.
+//   - Triangles with (near-)zero XY area — vertical walls — are skipped;
+//     their silhouette cannot change a max-Z sample except on a zero-width
+//     line of cell centers.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace heightmap {
+
+// Rasterize n_triangles triangles into a max-Z grid over the XY window
+// [xmin, xmax) x [ymin, ymax).  `indices` is 3 uint32 per triangle into
+// `vertices` (3 VertexT per vertex; float or double).  `out` must hold
+// res_x * res_y floats.  n_workers == 0 means hardware concurrency.
+template <typename VertexT>
+void rasterize_max_z(const VertexT* vertices, const uint32_t* indices,
+                     size_t n_triangles,
+                     double xmin, double ymin, double xmax, double ymax,
+                     size_t res_x, size_t res_y, float* out,
+                     size_t n_workers = 0) {
+    const float kNoData = -std::numeric_limits<float>::infinity();
+    std::fill(out, out + res_x * res_y, kNoData);
+    if (n_triangles == 0 || res_x == 0 || res_y == 0) return;
+
+    const double dx = (xmax - xmin) / double(res_x);
+    const double dy = (ymax - ymin) / double(res_y);
+    if (dx <= 0.0 || dy <= 0.0) return;
+
+    if (n_workers == 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        n_workers = hw ? hw : 1;
+    }
+
+    // A few bands per worker so an uneven triangle distribution still
+    // balances; never more bands than rows.
+    const size_t n_bands = std::max<size_t>(
+        1, std::min(res_y, n_workers * 4));
+    const size_t rows_per_band = (res_y + n_bands - 1) / n_bands;
+
+    // Bin triangle indices to the bands their Y extent touches.
+    // counting pass + fill pass keeps the bins contiguous.
+    auto band_range = [&](size_t t, size_t& b0, size_t& b1) -> bool {
+        double tymin = std::numeric_limits<double>::infinity();
+        double tymax = -std::numeric_limits<double>::infinity();
+        for (int c = 0; c < 3; ++c) {
+            const double y =
+                double(vertices[size_t(indices[t * 3 + c]) * 3 + 1]);
+            tymin = std::min(tymin, y);
+            tymax = std::max(tymax, y);
+        }
+        // Convert to the sample rows the triangle can cover, then to bands.
+        const double r0 = (tymin - ymin) / dy - 0.5;
+        const double r1 = (tymax - ymin) / dy - 0.5;
+        if (r1 < 0.0 || r0 > double(res_y - 1)) return false;
+        const size_t row0 = size_t(std::max(0.0, std::ceil(r0)));
+        const size_t row1 = std::min(res_y - 1, size_t(std::max(0.0, r1)));
+        if (row0 > row1) return false;
+        b0 = row0 / rows_per_band;
+        b1 = row1 / rows_per_band;
+        return true;
+    };
+
+    std::vector<size_t> bin_starts(n_bands + 1, 0);
+    for (size_t t = 0; t < n_triangles; ++t) {
+        size_t b0, b1;
+        if (band_range(t, b0, b1))
+            for (size_t b = b0; b <= b1; ++b) ++bin_starts[b + 1];
+    }
+    for (size_t b = 0; b < n_bands; ++b) bin_starts[b + 1] += bin_starts[b];
+    std::vector<uint32_t> bins(bin_starts[n_bands]);
+    {
+        std::vector<size_t> cursor(bin_starts.begin(), bin_starts.end() - 1);
+        for (size_t t = 0; t < n_triangles; ++t) {
+            size_t b0, b1;
+            if (band_range(t, b0, b1))
+                for (size_t b = b0; b <= b1; ++b)
+                    bins[cursor[b]++] = uint32_t(t);
+        }
+    }
+
+    // Rasterize one triangle into rows [row_begin, row_end) of out.
+    auto raster_triangle = [&](size_t t, size_t row_begin, size_t row_end) {
+        double vx[3], vy[3], vz[3];
+        for (int c = 0; c < 3; ++c) {
+            const VertexT* v = vertices + size_t(indices[t * 3 + c]) * 3;
+            vx[c] = double(v[0]);
+            vy[c] = double(v[1]);
+            vz[c] = double(v[2]);
+        }
+        const double area = (vx[1] - vx[0]) * (vy[2] - vy[0]) -
+                            (vx[2] - vx[0]) * (vy[1] - vy[0]);
+        const double abs_area = std::fabs(area);
+        if (abs_area < 1e-14) return;  // vertical or degenerate in XY
+        const double inv_area = 1.0 / area;
+
+        const double txmin = std::min({vx[0], vx[1], vx[2]});
+        const double txmax = std::max({vx[0], vx[1], vx[2]});
+        const double tymin = std::min({vy[0], vy[1], vy[2]});
+        const double tymax = std::max({vy[0], vy[1], vy[2]});
+
+        const double c0 = (txmin - xmin) / dx - 0.5;
+        const double c1 = (txmax - xmin) / dx - 0.5;
+        if (c1 < 0.0 || c0 > double(res_x - 1)) return;
+        const size_t ix0 = size_t(std::max(0.0, std::ceil(c0)));
+        const size_t ix1 = std::min(res_x - 1, size_t(std::max(0.0, c1)));
+
+        const double r0 = (tymin - ymin) / dy - 0.5;
+        const double r1 = (tymax - ymin) / dy - 0.5;
+        size_t iy0 = size_t(std::max(0.0, std::ceil(r0)));
+        size_t iy1 = std::min(res_y - 1, size_t(std::max(0.0, r1)));
+        iy0 = std::max(iy0, row_begin);
+        iy1 = std::min(iy1, row_end - 1);
+        if (ix0 > ix1 || iy0 > iy1) return;
+
+        // Inclusive edge test: the weights are normalized barycentrics, so a
+        // small absolute tolerance lets cell centers on shared edges land in
+        // at least one of the adjoining triangles.
+        const double eps = 1e-9;
+        for (size_t iy = iy0; iy <= iy1; ++iy) {
+            const double py = ymin + (double(iy) + 0.5) * dy;
+            float* row = out + iy * res_x;
+            for (size_t ix = ix0; ix <= ix1; ++ix) {
+                const double px = xmin + (double(ix) + 0.5) * dx;
+                const double w0 = ((vx[1] - px) * (vy[2] - py) -
+                                   (vx[2] - px) * (vy[1] - py)) * inv_area;
+                const double w1 = ((vx[2] - px) * (vy[0] - py) -
+                                   (vx[0] - px) * (vy[2] - py)) * inv_area;
+                const double w2 = 1.0 - w0 - w1;
+                if (w0 < -eps || w1 < -eps || w2 < -eps) continue;
+                const float z =
+                    float(w0 * vz[0] + w1 * vz[1] + w2 * vz[2]);
+                if (z > row[ix]) row[ix] = z;
+            }
+        }
+    };
+
+    std::atomic<size_t> next_band{0};
+    auto worker = [&]() {
+        for (size_t b = next_band.fetch_add(1, std::memory_order_relaxed);
+             b < n_bands;
+             b = next_band.fetch_add(1, std::memory_order_relaxed)) {
+            const size_t row_begin = b * rows_per_band;
+            const size_t row_end   = std::min(res_y, row_begin + rows_per_band);
+            for (size_t i = bin_starts[b]; i < bin_starts[b + 1]; ++i)
+                raster_triangle(bins[i], row_begin, row_end);
+        }
+    };
+
+    const size_t spawn = std::min(n_workers, n_bands);
+    std::vector<std::thread> threads;
+    threads.reserve(spawn > 0 ? spawn - 1 : 0);
+    for (size_t w = 0; w + 1 < spawn; ++w) threads.emplace_back(worker);
+    worker();  // the calling thread participates
+    for (auto& t : threads) t.join();
+}
+
+} // namespace heightmap
@@ -0,0 +1,138 @@
+// mesh_weld.h
+//
+// Vertex welding for assembled triangle meshes.  cg_shape_tessellate
+// concatenates each face's node table verbatim, so every shared B-rep edge
+// shows up twice in the vertex buffer and normal smoothing stops at face
+// seams.  weld() collapses vertices closer than a tolerance through a
+// quantized spatial hash, summing their accumulated (area-weighted, not yet
+// normalized) normals so the seam shades smoothly, and remaps the index
+// buffer in place.
+//
+// This header has no dependency on OCCT so it can be compiled and tested
+// independently (same pattern as bvh.h and heightmap.h).
+//
+// Design:
+//   - Vertices are binned by floor(coord / tolerance); a vertex only welds
+//     to candidates in its own and the 26 neighbouring cells, so lookups
+//     stay O(1) for sane tolerances.  Within a candidate cell the true
+//     Euclidean distance decides, so the quantization never over-merges.
+//   - The first vertex of a weld group keeps its position (no averaging):
+//     coordinates that came from the same B-rep vertex are bit-identical
+//     anyway, and snapping avoids drift when tolerances are generous.
+//   - Triangles that collapse to fewer than three distinct vertices after
+//     welding are dropped.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace mesh_weld {
+
+namespace detail {
+
+inline uint64_t cell_key(int64_t cx, int64_t cy, int64_t cz) {
+    // Mix the three cell coordinates into one hash key (large odd constants,
+    // same spirit as boost::hash_combine).
+    uint64_t h = uint64_t(cx) * 0x9e3779b97f4a7c15ULL;
+    h ^= uint64_t(cy) * 0xc2b2ae3d27d4eb4fULL + (h << 6) + (h >> 2);
+    h ^= uint64_t(cz) * 0x165667b19e3779f9ULL + (h << 6) + (h >> 2);
+    return h;
+}
+
+} // namespace detail
+
+// Weld coincident vertices in place.  vertices/normals are flat xyz triples;
+// indices reference vertices.  Normals are summed per weld group (call this
+// BEFORE normalizing them).  An empty normals vector is allowed — a mesh
+// whose normals are built lazily after welding passes positions and indices
+// only — and stays empty.  tolerance must be > 0.  Returns the new vertex
+// count; the buffers are shrunk accordingly.
+template <typename Real>
+size_t weld(std::vector<Real>&     vertices,
+            std::vector<Real>&     normals,
+            std::vector<uint32_t>& indices,
+            double                 tolerance) {
+    const size_t n_in = vertices.size() / 3;
+    if (n_in == 0) return 0;
+    const bool has_normals = !normals.empty();
+
+    const double inv_cell = 1.0 / tolerance;
+    const double tol_sq   = tolerance * tolerance;
+
+    // cell -> indices into the OUTPUT vertex list.
+    std::unordered_map<uint64_t, std::vector<uint32_t>> grid;
+    grid.reserve(n_in);
+
+    std::vector<uint32_t> remap(n_in);
+    std::vector<Real>     out_verts;
+    std::vector<Real>     out_norms;
+    out_verts.reserve(vertices.size());
+    out_norms.reserve(normals.size());
+
+    for (size_t i = 0; i < n_in; ++i) {
+        const double x = double(vertices[i * 3 + 0]);
+        const double y = double(vertices[i * 3 + 1]);
+        const double z = double(vertices[i * 3 + 2]);
+        const int64_t cx = int64_t(std::floor(x * inv_cell));
+        const int64_t cy = int64_t(std::floor(y * inv_cell));
+        const int64_t cz = int64_t(std::floor(z * inv_cell));
+
+        uint32_t target = UINT32_MAX;
+        for (int64_t dx = -1; dx <= 1 && target == UINT32_MAX; ++dx)
+            for (int64_t dy = -1; dy <= 1 && target == UINT32_MAX; ++dy)
+                for (int64_t dz = -1; dz <= 1; ++dz) {
+                    auto it = grid.find(
+                        detail::cell_key(cx + dx, cy + dy, cz + dz));
+                    if (it == grid.end()) continue;
+                    for (uint32_t cand : it->second) {
+                        const double ex = double(out_verts[cand * 3 + 0]) - x;
+                        const double ey = double(out_verts[cand * 3 + 1]) - y;
+                        const double ez = double(out_verts[cand * 3 + 2]) - z;
+                        if (ex * ex + ey * ey + ez * ez <= tol_sq) {
+                            target = cand;
+                            break;
+                        }
+                    }
+                    if (target != UINT32_MAX) break;
+                }
+
+        if (target == UINT32_MAX) {
+            target = uint32_t(out_verts.size() / 3);
+            out_verts.insert(out_verts.end(), vertices.begin() + i * 3,
+                             vertices.begin() + i * 3 + 3);
+            if (has_normals)
+                out_norms.insert(out_norms.end(), {Real(0), Real(0), Real(0)});
+            grid[detail::cell_key(cx, cy, cz)].push_back(target);
+        }
+        remap[i] = target;
+        if (has_normals) {
+            out_norms[target * 3 + 0] += normals[i * 3 + 0];
+            out_norms[target * 3 + 1] += normals[i * 3 + 1];
+            out_norms[target * 3 + 2] += normals[i * 3 + 2];
+        }
+    }
+
+    // Remap indices, dropping triangles that welding degenerated.
+    size_t out_i = 0;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const uint32_t a = remap[indices[t + 0]];
+        const uint32_t b = remap[indices[t + 1]];
+        const uint32_t c = remap[indices[t + 2]];
+        if (a == b || b == c || a == c) continue;
+        indices[out_i + 0] = a;
+        indices[out_i + 1] = b;
+        indices[out_i + 2] = c;
+        out_i += 3;
+    }
+    indices.resize(out_i);
+
+    vertices.swap(out_verts);
+    normals.swap(out_norms);
+    return vertices.size() / 3;
+}
+
+} // namespace mesh_weld
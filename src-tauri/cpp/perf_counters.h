@@ -0,0 +1,166 @@
+// perf_counters.h
+//
+// Lightweight performance counters for the kernel's hot entry points, plus
+// an optional chrome-trace event capture.
+//
+// Each instrumented entry point opens a Scope on one of a fixed set of
+// subsystems; the destructor folds the call into that subsystem's counter
+// (call count, cumulative and max wall time, bytes produced) with relaxed
+// atomic adds — no locks, no allocation, a few nanoseconds per call — so
+// the counters stay enabled in production builds.  When tracing is turned
+// on, each Scope additionally appends one complete ("ph":"X") event to a
+// fixed-capacity ring that cam_perf.cpp serializes in the chrome
+// trace-event JSON format (load it in chrome://tracing or Perfetto).
+//
+// Header-only and OCCT-free so the standalone tests and the no-OCCT
+// modules (cam_polygon.cpp) can use it directly.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace perf_counters {
+
+// Instrumented subsystems.  Keep name_of() in step with this list.
+enum Subsystem : size_t {
+    kImport = 0,   // STEP/IGES/STL file loading
+    kTessellate,   // shape -> mesh, including welding and normals
+    kSection,      // planar sections and loop chaining
+    kOffset,       // 2D polygon offsetting
+    kBoolean,      // 2D polygon booleans
+    kEval,         // batch surface evaluation and projection
+    kSubsystemCount
+};
+
+inline const char* name_of(Subsystem s) {
+    switch (s) {
+        case kImport:     return "import";
+        case kTessellate: return "tessellate";
+        case kSection:    return "section";
+        case kOffset:     return "offset";
+        case kBoolean:    return "boolean";
+        case kEval:       return "eval";
+        default:          return "?";
+    }
+}
+
+struct Counter {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+inline std::array<Counter, kSubsystemCount> g_counters;
+
+// ---------------------------------------------------------------------------
+// Trace capture
+// ---------------------------------------------------------------------------
+
+struct TraceEvent {
+    Subsystem sys;
+    uint64_t  start_us;  // microseconds since the first Scope in the process
+    uint64_t  dur_us;
+    uint64_t  tid;       // small per-thread tag, stable for a thread's life
+};
+
+// Ring size: ~16k events (512 KiB).  Once full, further events are dropped
+// rather than wrapping, so a dump is always the FIRST events after enable —
+// the useful ones when chasing a slow job from its start.
+inline constexpr size_t kTraceCapacity = size_t{1} << 14;
+
+inline std::array<TraceEvent, kTraceCapacity> g_trace;
+inline std::atomic<size_t> g_trace_cursor{0};
+inline std::atomic<bool>   g_trace_enabled{false};
+
+inline size_t trace_event_count() {
+    const size_t n = g_trace_cursor.load(std::memory_order_relaxed);
+    return n < kTraceCapacity ? n : kTraceCapacity;
+}
+
+// Process-local time origin so trace timestamps are small and comparable
+// across threads.  First caller wins; steady_clock so it never jumps.
+inline std::chrono::steady_clock::time_point epoch() {
+    static const auto t0 = std::chrono::steady_clock::now();
+    return t0;
+}
+
+inline uint64_t thread_tag() {
+    static std::atomic<uint64_t> next{1};
+    thread_local const uint64_t tag =
+        next.fetch_add(1, std::memory_order_relaxed);
+    return tag;
+}
+
+// ---------------------------------------------------------------------------
+// Scope — RAII timer placed at the top of an instrumented entry point
+// ---------------------------------------------------------------------------
+
+class Scope {
+public:
+    explicit Scope(Subsystem sys)
+        : sys_(sys), start_(std::chrono::steady_clock::now()) {
+        (void)epoch(); // pin the time origin no later than the first scope
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    // Attribute output bytes (mesh buffers, result polygons) to this call.
+    void add_bytes(uint64_t n) { bytes_ += n; }
+
+    ~Scope() {
+        const auto end = std::chrono::steady_clock::now();
+        const uint64_t ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_)
+                .count());
+
+        Counter& c = g_counters[sys_];
+        c.calls.fetch_add(1, std::memory_order_relaxed);
+        c.total_ns.fetch_add(ns, std::memory_order_relaxed);
+        c.bytes.fetch_add(bytes_, std::memory_order_relaxed);
+        uint64_t prev = c.max_ns.load(std::memory_order_relaxed);
+        while (ns > prev &&
+               !c.max_ns.compare_exchange_weak(prev, ns,
+                                               std::memory_order_relaxed)) {
+        }
+
+        if (g_trace_enabled.load(std::memory_order_relaxed)) {
+            const size_t idx =
+                g_trace_cursor.fetch_add(1, std::memory_order_relaxed);
+            if (idx < kTraceCapacity) {
+                TraceEvent& ev = g_trace[idx];
+                ev.sys = sys_;
+                ev.start_us = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        start_ - epoch())
+                        .count());
+                ev.dur_us = ns / 1000;
+                ev.tid    = thread_tag();
+            }
+        }
+    }
+
+private:
+    Subsystem sys_;
+    std::chrono::steady_clock::time_point start_;
+    uint64_t bytes_ = 0;
+};
+
+// Zero all counters and discard any captured trace events.  Concurrent
+// scopes may land adds on either side of the reset; that is acceptable for
+// a diagnostics surface.
+inline void reset() {
+    for (Counter& c : g_counters) {
+        c.calls.store(0, std::memory_order_relaxed);
+        c.total_ns.store(0, std::memory_order_relaxed);
+        c.max_ns.store(0, std::memory_order_relaxed);
+        c.bytes.store(0, std::memory_order_relaxed);
+    }
+    g_trace_cursor.store(0, std::memory_order_relaxed);
+}
+
+} // namespace perf_counters
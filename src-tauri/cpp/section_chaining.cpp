@@ -0,0 +1,151 @@
+// section_chaining.cpp
+//
+// Implementation of segment-to-loop chaining for section output.
+//
+// Algorithm:
+//   1. Every segment endpoint is inserted into a spatial hash keyed by its
+//      quantized (x, y) cell (cell size = tol).
+//   2. Starting from each unused segment, the chain is extended forward by
+//      looking up the current tail point in the hash (checking the 3×3 cell
+//      neighbourhood, since two points within tol can straddle a cell
+//      boundary) and consuming the matching segment.
+//   3. If the chain does not close, it is also extended backward from the
+//      head, so open chains are recovered in full rather than split at the
+//      arbitrary starting segment.
+//   4. Closed loops are normalized to counter-clockwise winding.
+
+#include "section_chaining.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+namespace {
+
+// Quantized cell key for the spatial hash.
+uint64_t cell_key(int64_t qx, int64_t qy) {
+    // Mix the two 32-bit-ish lattice coordinates into one key.
+    return static_cast<uint64_t>(qx) * UINT64_C(0x9E3779B97F4A7C15) ^
+           static_cast<uint64_t>(qy);
+}
+
+// One endpoint record: segment index and which end (0 = start, 1 = end).
+struct Endpoint {
+    uint32_t seg;
+    uint32_t end;
+};
+
+double dist2_xy(const CgPoint3& a, const CgPoint3& b) {
+    const double dx = a.x - b.x;
+    const double dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+}  // namespace
+
+double polygon_signed_area_xy(const std::vector<CgPoint3>& points) {
+    double area2 = 0.0;
+    const size_t n = points.size();
+    for (size_t i = 0; i < n; ++i) {
+        const CgPoint3& a = points[i];
+        const CgPoint3& b = points[(i + 1) % n];
+        area2 += a.x * b.y - b.x * a.y;
+    }
+    return area2 / 2.0;
+}
+
+std::vector<std::vector<CgPoint3>> chain_section_segments(
+    const std::vector<CgPoint3>& segment_points, double tol)
+{
+    std::vector<std::vector<CgPoint3>> loops;
+    const size_t n_segs = segment_points.size() / 2;
+    if (n_segs == 0) return loops;
+    if (tol <= 0.0) tol = 1e-9;
+
+    auto seg_point = [&](uint32_t seg, uint32_t end) -> const CgPoint3& {
+        return segment_points[seg * 2 + end];
+    };
+
+    // Build the endpoint hash.
+    std::unordered_map<uint64_t, std::vector<Endpoint>> hash;
+    hash.reserve(n_segs * 2);
+    auto quantize = [tol](double v) -> int64_t {
+        return static_cast<int64_t>(std::llround(v / tol));
+    };
+    for (uint32_t s = 0; s < n_segs; ++s) {
+        for (uint32_t e = 0; e < 2; ++e) {
+            const CgPoint3& p = seg_point(s, e);
+            hash[cell_key(quantize(p.x), quantize(p.y))].push_back(Endpoint{s, e});
+        }
+    }
+
+    std::vector<bool> used(n_segs, false);
+    const double tol2 = tol * tol;
+
+    // Find an unused segment with an endpoint within tol of p.
+    // Returns true and fills `found`; the matched endpoint is the one that
+    // touches p (the chain continues from the segment's other end).
+    auto find_match = [&](const CgPoint3& p, Endpoint& found) -> bool {
+        const int64_t qx = quantize(p.x);
+        const int64_t qy = quantize(p.y);
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            for (int64_t dy = -1; dy <= 1; ++dy) {
+                auto it = hash.find(cell_key(qx + dx, qy + dy));
+                if (it == hash.end()) continue;
+                for (const Endpoint& ep : it->second) {
+                    if (used[ep.seg]) continue;
+                    if (dist2_xy(seg_point(ep.seg, ep.end), p) <= tol2) {
+                        found = ep;
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    };
+
+    for (uint32_t start = 0; start < n_segs; ++start) {
+        if (used[start]) continue;
+        used[start] = true;
+
+        std::vector<CgPoint3> chain;
+        chain.push_back(seg_point(start, 0));
+        chain.push_back(seg_point(start, 1));
+
+        // Extend forward from the tail.
+        bool closed = false;
+        Endpoint match;
+        while (find_match(chain.back(), match)) {
+            used[match.seg] = true;
+            const CgPoint3& next = seg_point(match.seg, 1 - match.end);
+            if (dist2_xy(next, chain.front()) <= tol2) {
+                closed = true;
+                break;  // back at the head — loop complete, don't repeat it
+            }
+            chain.push_back(next);
+        }
+
+        // If open, extend backward from the head.
+        if (!closed) {
+            while (find_match(chain.front(), match)) {
+                used[match.seg] = true;
+                const CgPoint3& prev = seg_point(match.seg, 1 - match.end);
+                if (dist2_xy(prev, chain.back()) <= tol2) {
+                    closed = true;
+                    break;
+                }
+                chain.insert(chain.begin(), prev);
+            }
+        }
+
+        // Normalize closed loops to counter-clockwise winding.
+        if (closed && chain.size() >= 3 && polygon_signed_area_xy(chain) < 0.0) {
+            std::reverse(chain.begin(), chain.end());
+        }
+
+        loops.push_back(std::move(chain));
+    }
+
+    return loops;
+}
@@ -0,0 +1,35 @@
+// section_chaining.h
+//
+// Chain unordered section segments into connected boundary loops.
+//
+// This module has no dependency on OCCT so it can be compiled and tested
+// independently (same pattern as handle_registry_base.h).  It is consumed by
+// the sectioning functions in cam_geometry.cpp, which feed it the raw
+// (start, end) segment soup produced by slicing and hand the chained loops
+// across the FFI.
+
+#pragma once
+
+#include <vector>
+
+#include "cam_geometry.h"
+
+// Chain unordered (start, end) segment pairs into connected polylines.
+//
+//   segment_points: flat array of segment endpoints
+//                   (pairs: start, end, start, end, ...)
+//   tol:            endpoint-matching tolerance.  Endpoints within tol of
+//                   each other are considered coincident; matching uses a
+//                   quantized spatial hash, so chaining is O(n) rather than
+//                   the O(n²) all-pairs search.
+//
+// Returns one vector of points per chain.  A closed loop is emitted without
+// repeating its first point and is oriented counter-clockwise in XY
+// (positive signed area).  Chains that cannot be closed (non-manifold or
+// clipped input) are returned as-is, first point != last point.
+std::vector<std::vector<CgPoint3>> chain_section_segments(
+    const std::vector<CgPoint3>& segment_points, double tol);
+
+// Signed area of a polygon in the XY plane (shoelace formula).
+// Positive for counter-clockwise winding.  Exposed for tests.
+double polygon_signed_area_xy(const std::vector<CgPoint3>& points);
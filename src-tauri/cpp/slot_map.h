@@ -0,0 +1,178 @@
+// slot_map.h
+//
+// Generation-tagged slot arena for dense, monotonically allocated handle IDs.
+//
+// This header has no dependency on OCCT so it can be compiled and tested
+// independently (same pattern as handle_registry_base.h).  The mesh store in
+// cam_geometry.cpp uses it today; it is the opt-in storage policy for other
+// registries whose IDs are dense enough to benefit.
+//
+// Design:
+//   - An ID packs [generation:32 | slot+1:32].  Slot 0 maps to ID low bits 1,
+//     so a valid ID is never CG_NULL_ID (0).
+//   - Live slots hold an odd generation; erasing bumps it to even, so a stale
+//     ID fails the generation compare and lookups return null instead of
+//     aliasing a recycled slot (use-after-free detection).  Generations wrap
+//     after 2^31 reuses of one slot, which is beyond any realistic session.
+//   - Storage grows in fixed chunks published through atomic pointers, so the
+//     read path is wait-free: index the chunk, compare the generation — no
+//     hash, no lock, no refcount.  Writers (insert/erase) serialize on one
+//     mutex, which is fine because stores and frees are rare next to reads.
+//   - Payloads are shared_ptr<T> so an erased entry can outlive the slot when
+//     a caller still holds it (the mesh pin table relies on this).
+//
+// Safety invariant (enforced by the Rust wrapper layer, as with
+// HandleRegistryBase): the caller must not use an ID concurrently with the
+// erase() of that same ID.  Lookups of other IDs during an erase are safe.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class SlotMap {
+public:
+    // 1024 slots per chunk, up to 4096 chunks: 4M concurrently live entries.
+    static constexpr size_t kChunkSize = 1024;
+    static constexpr size_t kMaxChunks = 4096;
+
+    SlotMap() = default;
+
+    // Non-copyable, non-movable (singleton semantics).
+    SlotMap(const SlotMap&)            = delete;
+    SlotMap& operator=(const SlotMap&) = delete;
+
+    ~SlotMap() {
+        for (size_t i = 0; i < kMaxChunks; ++i)
+            delete[] chunks_[i].load(std::memory_order_relaxed);
+    }
+
+    // Store a value and return its ID.  Thread-safe.
+    // Throws std::length_error if the arena is full.
+    uint64_t insert(std::shared_ptr<T> value) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        uint32_t slot;
+        if (!free_list_.empty()) {
+            slot = free_list_.back();
+            free_list_.pop_back();
+        } else {
+            if (next_slot_ >= kChunkSize * kMaxChunks)
+                throw std::length_error("SlotMap: capacity exceeded");
+            slot = next_slot_++;
+            const size_t chunk = slot / kChunkSize;
+            if (!chunks_[chunk].load(std::memory_order_relaxed))
+                chunks_[chunk].store(new Slot[kChunkSize],
+                                     std::memory_order_release);
+        }
+        Slot& s = slot_ref(slot);
+        const uint32_t gen =
+            s.generation.load(std::memory_order_relaxed) + 1;  // even -> odd
+        s.value = std::move(value);
+        // Publish the value before the generation so a reader that matches
+        // the generation is guaranteed to see the payload.
+        s.generation.store(gen, std::memory_order_release);
+        return make_id(slot, gen);
+    }
+
+    // Borrow the value without touching the refcount.  Wait-free.
+    // Returns nullptr for CG_NULL_ID, a stale generation, or an unknown slot.
+    T* get(uint64_t id) const {
+        const Slot* s = find_slot(id);
+        return s ? s->value.get() : nullptr;
+    }
+
+    // Copy the shared_ptr (for callers that need to extend the lifetime,
+    // e.g. pinning).  Wait-free; returns nullptr when id is invalid.
+    std::shared_ptr<T> get_shared(uint64_t id) const {
+        const Slot* s = find_slot(id);
+        return s ? s->value : nullptr;
+    }
+
+    // Remove the entry and return its value (nullptr if id was invalid).
+    // The slot is recycled with a new generation, so the stale ID stays dead.
+    std::shared_ptr<T> erase(uint64_t id) {
+        const uint32_t slot = slot_index(id);
+        const uint32_t gen  = static_cast<uint32_t>(id >> 32);
+        if (id == 0 || slot >= kChunkSize * kMaxChunks) return nullptr;
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        Slot* chunk = chunks_[slot / kChunkSize].load(std::memory_order_acquire);
+        if (!chunk) return nullptr;
+        Slot& s = chunk[slot % kChunkSize];
+        if (s.generation.load(std::memory_order_relaxed) != gen) return nullptr;
+        // Invalidate first (odd -> even) so lookups miss before the payload
+        // disappears, then release the slot's reference.
+        s.generation.store(gen + 1, std::memory_order_release);
+        std::shared_ptr<T> out = std::move(s.value);
+        s.value.reset();
+        free_list_.push_back(slot);
+        return out;
+    }
+
+    // Number of live entries (primarily for tests).
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        return next_slot_ - free_list_.size();
+    }
+
+    // Collect every live entry as (id, value), in slot order.  Takes the
+    // write lock so the scan cannot interleave with an insert or erase;
+    // lookups of individual IDs stay wait-free throughout.
+    std::vector<std::pair<uint64_t, std::shared_ptr<T>>> snapshot() const {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        std::vector<std::pair<uint64_t, std::shared_ptr<T>>> out;
+        for (uint32_t slot = 0; slot < next_slot_; ++slot) {
+            const Slot* chunk =
+                chunks_[slot / kChunkSize].load(std::memory_order_acquire);
+            if (!chunk) continue;
+            const Slot& s = chunk[slot % kChunkSize];
+            const uint32_t gen = s.generation.load(std::memory_order_relaxed);
+            if (gen & 1u) out.emplace_back(make_id(slot, gen), s.value);
+        }
+        return out;
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> generation{0};  // odd = live, even = empty
+        std::shared_ptr<T>    value;
+    };
+
+    static uint32_t slot_index(uint64_t id) {
+        return static_cast<uint32_t>(id & 0xffffffffu) - 1;
+    }
+
+    static uint64_t make_id(uint32_t slot, uint32_t gen) {
+        return (static_cast<uint64_t>(gen) << 32) |
+               (static_cast<uint64_t>(slot) + 1);
+    }
+
+    Slot& slot_ref(uint32_t slot) {
+        return chunks_[slot / kChunkSize]
+            .load(std::memory_order_relaxed)[slot % kChunkSize];
+    }
+
+    // Shared body of get()/get_shared(): resolve id to its live slot.
+    const Slot* find_slot(uint64_t id) const {
+        if (id == 0) return nullptr;
+        const uint32_t slot = slot_index(id);
+        const uint32_t gen  = static_cast<uint32_t>(id >> 32);
+        if (slot >= kChunkSize * kMaxChunks || (gen & 1u) == 0) return nullptr;
+        const Slot* chunk =
+            chunks_[slot / kChunkSize].load(std::memory_order_acquire);
+        if (!chunk) return nullptr;
+        const Slot& s = chunk[slot % kChunkSize];
+        if (s.generation.load(std::memory_order_acquire) != gen) return nullptr;
+        return &s;
+    }
+
+    mutable std::mutex     write_mutex_;
+    std::atomic<Slot*>     chunks_[kMaxChunks] = {};
+    uint32_t               next_slot_ = 0;
+    std::vector<uint32_t>  free_list_;
+};
@@ -0,0 +1,208 @@
+// stl_import.h
+//
+// Memory-mapped binary STL parsing.  RWStl::ReadFile is single-threaded and
+// builds an intermediate Poly_Triangulation (~3x the file size in RAM); on
+// scanned-stock STLs in the hundreds of megabytes that is the import time.
+// The fast path here maps the file read-only, validates the 84-byte binary
+// header, and parses the fixed-size 50-byte triangle records in parallel
+// chunks directly into the flat CgMeshData buffer layout.
+//
+// This header has no dependency on OCCT so it can be compiled and tested
+// independently (same pattern as bvh.h and mesh_weld.h).  cg_load_stl in
+// cam_geometry.cpp drives it and falls back to RWStl for ASCII files.
+//
+// Layout notes:
+//   - A binary STL is an 80-byte comment header, a uint32 triangle count,
+//     then count records of 50 bytes: float3 normal, 3x float3 vertex,
+//     uint16 attribute.  Records are unaligned; all values little-endian
+//     (as is every platform this kernel ships on).
+//   - Vertices are emitted unshared (3 per triangle, exactly as stored);
+//     normals are recomputed per triangle from the winding (the file normal
+//     is frequently garbage) and left unnormalized so an optional
+//     mesh_weld::weld() pass can merge seam duplicates before the caller
+//     normalizes.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace stl_import {
+
+constexpr size_t kHeaderSize = 84;  // 80-byte comment + uint32 count
+constexpr size_t kRecordSize = 50;  // float3 normal + 3x float3 + uint16
+
+// Read-only memory map of a whole file.  Unmapped on destruction.
+class FileMapping {
+public:
+    FileMapping() = default;
+    ~FileMapping() { close(); }
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    bool open(const char* path) {
+        close();
+#ifdef _WIN32
+        file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(file_, &sz) || sz.QuadPart <= 0) {
+            close();
+            return false;
+        }
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0,
+                                      nullptr);
+        if (!mapping_) {
+            close();
+            return false;
+        }
+        data_ = static_cast<const uint8_t*>(
+            MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (!data_) {
+            close();
+            return false;
+        }
+        size_ = size_t(sz.QuadPart);
+#else
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE,
+                       fd, 0);
+        ::close(fd);  // the mapping keeps its own reference
+        if (p == MAP_FAILED) return false;
+        data_ = static_cast<const uint8_t*>(p);
+        size_ = size_t(st.st_size);
+#endif
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t         size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t         size_ = 0;
+#ifdef _WIN32
+    HANDLE file_    = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+// Validate a binary STL header against the file size.  Returns true and the
+// triangle count when the declared count exactly accounts for the bytes —
+// which also rejects ASCII files ("solid ...") without any text heuristics.
+inline bool binary_triangle_count(const uint8_t* data, size_t size,
+                                  uint32_t& out_count) {
+    if (!data || size < kHeaderSize) return false;
+    uint32_t n;
+    std::memcpy(&n, data + 80, sizeof n);
+    if (n == 0) return false;
+    if (size != kHeaderSize + size_t(n) * kRecordSize) return false;
+    out_count = n;
+    return true;
+}
+
+// Parse n_triangles records into the flat buffers: 9 vertex scalars and one
+// accumulated (unnormalized) normal per vertex, indices 0..3n-1.  Workers
+// pull record chunks from an atomic cursor; every chunk writes a disjoint
+// slice, so the result is byte-identical for any worker count.
+// n_workers == 0 means hardware concurrency.
+template <typename Real>
+void parse_binary(const uint8_t* data, uint32_t n_triangles,
+                  std::vector<Real>&     vertices,
+                  std::vector<Real>&     normals,
+                  std::vector<uint32_t>& indices,
+                  size_t n_workers = 0) {
+    const size_t n = n_triangles;
+    vertices.resize(n * 9);
+    normals.resize(n * 9);
+    indices.resize(n * 3);
+
+    auto parse_range = [&](size_t begin, size_t end) {
+        const uint8_t* rec = data + kHeaderSize + begin * kRecordSize;
+        for (size_t t = begin; t < end; ++t, rec += kRecordSize) {
+            float v[9];
+            std::memcpy(v, rec + 12, sizeof v);  // skip the stored normal
+            double p[9];
+            for (int k = 0; k < 9; ++k) {
+                p[k] = double(v[k]);
+                vertices[t * 9 + k] = Real(v[k]);
+            }
+            // Area-weighted normal from the winding, shared by the three
+            // (unwelded) corners.
+            const double e1x = p[3] - p[0], e1y = p[4] - p[1], e1z = p[5] - p[2];
+            const double e2x = p[6] - p[0], e2y = p[7] - p[1], e2z = p[8] - p[2];
+            const Real nx = Real(e1y * e2z - e1z * e2y);
+            const Real ny = Real(e1z * e2x - e1x * e2z);
+            const Real nz = Real(e1x * e2y - e1y * e2x);
+            for (int c = 0; c < 3; ++c) {
+                normals[t * 9 + c * 3 + 0] = nx;
+                normals[t * 9 + c * 3 + 1] = ny;
+                normals[t * 9 + c * 3 + 2] = nz;
+            }
+            indices[t * 3 + 0] = uint32_t(t * 3 + 0);
+            indices[t * 3 + 1] = uint32_t(t * 3 + 1);
+            indices[t * 3 + 2] = uint32_t(t * 3 + 2);
+        }
+    };
+
+    if (n_workers == 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        n_workers = hw ? hw : 1;
+    }
+    constexpr size_t kChunk = 4096;
+    if (n_workers <= 1 || n <= kChunk) {
+        parse_range(0, n);
+        return;
+    }
+
+    std::atomic<size_t> cursor{0};
+    auto worker = [&]() {
+        for (size_t begin = cursor.fetch_add(kChunk, std::memory_order_relaxed);
+             begin < n;
+             begin = cursor.fetch_add(kChunk, std::memory_order_relaxed)) {
+            parse_range(begin, std::min(n, begin + kChunk));
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(n_workers - 1);
+    for (size_t w = 1; w < n_workers; ++w) threads.emplace_back(worker);
+    worker();
+    for (auto& t : threads) t.join();
+}
+
+} // namespace stl_import
@@ -0,0 +1,300 @@
+// bench_geometry.cpp
+//
+// Synthetic-workload benchmarks for the geometry kernel C API, built as the
+// `bench_geometry` CMake target (enable with -DBUILD_BENCH=ON).
+//
+// Each benchmark generates a parameterized workload (procedural STEP
+// compounds at several face counts, dense binary STL files, polygons of
+// growing vertex counts), times the public entry point over a few
+// repetitions, and emits one JSON object per line on stdout:
+//
+//   {"bench":"cg_shape_tessellate","param":"faces=600","iters":5,
+//    "avg_ms":12.345,"best_ms":11.901,"throughput":812345.6,
+//    "throughput_unit":"tris/s"}
+//
+// Lines starting with '{' are the machine-readable record; redirect stdout
+// to a file and diff/plot runs across commits.  Wall time only — pair with
+// cg_perf_counters_snapshot() when a subsystem-level breakdown is needed.
+//
+// Usage:
+//   bench_geometry           # full run
+//   bench_geometry --quick   # smallest size of each workload, 2 iterations
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRep_Builder.hxx>
+#include <IFSelect_ReturnStatus.hxx>
+#include <STEPControl_Writer.hxx>
+#include <TopoDS_Compound.hxx>
+#include <gp_Pnt.hxx>
+
+#include "cam_geometry.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+bool g_quick = false;
+
+// ---------------------------------------------------------------------------
+// Harness
+// ---------------------------------------------------------------------------
+
+// Run `fn` `iters` times and emit one JSON result line.  `items` is the
+// per-iteration work volume used for the throughput figure.
+template <typename Fn>
+void run_bench(const char* name, const std::string& param, size_t items,
+               const char* unit, Fn&& fn) {
+    const int iters = g_quick ? 2 : 5;
+    double total_ms = 0.0;
+    double best_ms  = 1e300;
+    for (int i = 0; i < iters; ++i) {
+        const auto t0 = Clock::now();
+        fn();
+        const auto t1 = Clock::now();
+        const double ms =
+            std::chrono::duration<double, std::milli>(t1 - t0).count();
+        total_ms += ms;
+        best_ms = std::min(best_ms, ms);
+    }
+    const double avg_ms = total_ms / iters;
+    const double throughput =
+        avg_ms > 0.0 ? static_cast<double>(items) / (avg_ms / 1000.0) : 0.0;
+    std::printf("{\"bench\":\"%s\",\"param\":\"%s\",\"iters\":%d,"
+                "\"avg_ms\":%.3f,\"best_ms\":%.3f,\"throughput\":%.1f,"
+                "\"throughput_unit\":\"%s\"}\n",
+                name, param.c_str(), iters, avg_ms, best_ms, throughput, unit);
+    std::fflush(stdout);
+}
+
+std::string temp_path(const char* leaf) {
+    const char* tmp = std::getenv("TMPDIR");
+    return std::string(tmp && tmp[0] ? tmp : "/tmp") + "/" + leaf;
+}
+
+// ---------------------------------------------------------------------------
+// Workload generators
+// ---------------------------------------------------------------------------
+
+// Write a STEP file containing a k×k grid of unit boxes (6·k² faces) so the
+// tessellation and import benches scale in face count without fixtures.
+bool write_box_grid_step(const std::string& path, size_t k) {
+    BRep_Builder    builder;
+    TopoDS_Compound compound;
+    builder.MakeCompound(compound);
+    for (size_t i = 0; i < k; ++i) {
+        for (size_t j = 0; j < k; ++j) {
+            BRepPrimAPI_MakeBox box(gp_Pnt(i * 2.0, j * 2.0, 0.0),
+                                    1.0, 1.0, 1.0);
+            builder.Add(compound, box.Shape());
+        }
+    }
+    STEPControl_Writer writer;
+    if (writer.Transfer(compound, STEPControl_AsIs) != IFSelect_RetDone)
+        return false;
+    return writer.Write(path.c_str()) == IFSelect_RetDone;
+}
+
+// Write a binary STL of a (n×n)-cell heightfield (2·n² triangles).
+bool write_heightfield_stl(const std::string& path, size_t n) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    char header[80] = "bench_geometry synthetic heightfield";
+    out.write(header, sizeof(header));
+    const uint32_t n_tris = static_cast<uint32_t>(2 * n * n);
+    out.write(reinterpret_cast<const char*>(&n_tris), 4);
+
+    auto height = [n](size_t i, size_t j) {
+        return static_cast<float>(
+            std::sin(i * 6.28 / n) * std::cos(j * 6.28 / n));
+    };
+    auto write_tri = [&](float ax, float ay, float az, float bx, float by,
+                         float bz, float cx, float cy, float cz) {
+        const float record[12] = {0, 0, 1, ax, ay, az, bx, by, bz, cx, cy, cz};
+        out.write(reinterpret_cast<const char*>(record), 48);
+        const uint16_t attr = 0;
+        out.write(reinterpret_cast<const char*>(&attr), 2);
+    };
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const float x0 = static_cast<float>(i), x1 = x0 + 1.0f;
+            const float y0 = static_cast<float>(j), y1 = y0 + 1.0f;
+            write_tri(x0, y0, height(i, j), x1, y0, height(i + 1, j),
+                      x1, y1, height(i + 1, j + 1));
+            write_tri(x0, y0, height(i, j), x1, y1, height(i + 1, j + 1),
+                      x0, y1, height(i, j + 1));
+        }
+    }
+    return out.good();
+}
+
+// Regular n-gon of radius r centered on (cx, cy) as flat [x,y, ...] pairs.
+std::vector<double> make_ngon(size_t n, double r, double cx, double cy) {
+    std::vector<double> pts(n * 2);
+    for (size_t i = 0; i < n; ++i) {
+        const double a = 6.283185307179586 * static_cast<double>(i) / n;
+        pts[i * 2 + 0] = cx + r * std::cos(a);
+        pts[i * 2 + 1] = cy + r * std::sin(a);
+    }
+    return pts;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+void bench_tessellate() {
+    const std::vector<size_t> grid = g_quick ? std::vector<size_t>{2}
+                                             : std::vector<size_t>{1, 5, 10};
+    for (size_t k : grid) {
+        const std::string step = temp_path("bench_geometry_grid.step");
+        if (!write_box_grid_step(step, k)) {
+            std::fprintf(stderr, "bench: STEP write failed for k=%zu\n", k);
+            continue;
+        }
+
+        // Import once per size (timed as its own bench), then time
+        // tessellation of the resident shape.
+        CgShapeId shape = CG_NULL_ID;
+        run_bench("cg_load_step", "faces=" + std::to_string(6 * k * k), 1,
+                  "imports/s", [&]() {
+                      if (shape != CG_NULL_ID) cg_shape_free(shape);
+                      shape = cg_load_step(step.c_str());
+                  });
+        std::remove(step.c_str());
+        if (shape == CG_NULL_ID) {
+            std::fprintf(stderr, "bench: import failed: %s\n",
+                         cg_last_error_message());
+            continue;
+        }
+
+        CgMeshId probe = cg_shape_tessellate(shape, 0.01, 0.3);
+        const size_t tris = cg_mesh_triangle_count(probe);
+        cg_mesh_free(probe);
+
+        run_bench("cg_shape_tessellate",
+                  "faces=" + std::to_string(6 * k * k), tris, "tris/s",
+                  [&]() {
+                      CgMeshId m = cg_shape_tessellate(shape, 0.01, 0.3);
+                      cg_mesh_free(m);
+                  });
+        cg_shape_free(shape);
+    }
+}
+
+void bench_load_stl() {
+    const std::vector<size_t> grid = g_quick ? std::vector<size_t>{50}
+                                             : std::vector<size_t>{100, 320};
+    for (size_t n : grid) {
+        const std::string stl = temp_path("bench_geometry_field.stl");
+        if (!write_heightfield_stl(stl, n)) {
+            std::fprintf(stderr, "bench: STL write failed for n=%zu\n", n);
+            continue;
+        }
+        const size_t tris = 2 * n * n;
+        run_bench("cg_load_stl", "tris=" + std::to_string(tris), tris,
+                  "tris/s", [&]() {
+                      CgMeshId m = cg_load_stl(stl.c_str());
+                      cg_mesh_free(m);
+                  });
+        run_bench("cg_load_stl_ex_welded", "tris=" + std::to_string(tris),
+                  tris, "tris/s", [&]() {
+                      CgMeshId m = cg_load_stl_ex(stl.c_str(), CG_MESH_F32,
+                                                  1e-6);
+                      cg_mesh_free(m);
+                  });
+        std::remove(stl.c_str());
+    }
+}
+
+void bench_polygons() {
+    const std::vector<size_t> sizes = g_quick
+                                          ? std::vector<size_t>{1000}
+                                          : std::vector<size_t>{1000, 10000,
+                                                                100000};
+    for (size_t n : sizes) {
+        const std::vector<double> a = make_ngon(n, 100.0, 0.0, 0.0);
+        const std::vector<double> b = make_ngon(n, 100.0, 60.0, 0.0);
+
+        run_bench("cg_poly_offset", "verts=" + std::to_string(n), n,
+                  "verts/s", [&]() {
+                      double* out   = nullptr;
+                      size_t  count = 0;
+                      cg_poly_offset(a.data(), n, -1.0, 0.05, &out, &count);
+                      cg_poly_free(out);
+                  });
+
+        run_bench("cg_poly_boolean", "verts=" + std::to_string(n), 2 * n,
+                  "verts/s", [&]() {
+                      double* out   = nullptr;
+                      size_t  count = 0;
+                      cg_poly_boolean(a.data(), n, b.data(), n,
+                                      CG_BOOL_INTERSECTION, &out, &count);
+                      cg_poly_free(out);
+                  });
+    }
+}
+
+// Registry under concurrent load: reader threads hammer bounding-box and
+// mesh-count lookups against live handles while the main thread churns
+// create/free, the access pattern the sharded registry is built for.
+void bench_registry_concurrent() {
+    const std::string step = temp_path("bench_geometry_reg.step");
+    if (!write_box_grid_step(step, 2)) return;
+    CgShapeId shape = cg_load_step(step.c_str());
+    std::remove(step.c_str());
+    if (shape == CG_NULL_ID) return;
+    CgMeshId mesh = cg_shape_tessellate(shape, 0.1, 0.5);
+
+    const size_t n_threads = std::max<size_t>(
+        2, std::thread::hardware_concurrency());
+    const size_t lookups_per_thread = g_quick ? 20000 : 200000;
+
+    run_bench("registry_lookups",
+              "threads=" + std::to_string(n_threads),
+              n_threads * lookups_per_thread, "lookups/s", [&]() {
+                  std::vector<std::thread> threads;
+                  threads.reserve(n_threads);
+                  for (size_t t = 0; t < n_threads; ++t) {
+                      threads.emplace_back([&]() {
+                          for (size_t i = 0; i < lookups_per_thread; ++i) {
+                              cg_shape_bounding_box(shape);
+                              cg_mesh_triangle_count(mesh);
+                          }
+                      });
+                  }
+                  for (auto& th : threads) th.join();
+              });
+
+    cg_mesh_free(mesh);
+    cg_shape_free(shape);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) g_quick = true;
+    }
+
+    std::fprintf(stderr, "bench_geometry (%s run)\n",
+                 g_quick ? "quick" : "full");
+
+    bench_tessellate();
+    bench_load_stl();
+    bench_polygons();
+    bench_registry_concurrent();
+
+    return 0;
+}
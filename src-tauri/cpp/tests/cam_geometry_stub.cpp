@@ -14,18 +14,16 @@
 #include <cstring>
 #include <string>
 
-static thread_local std::string g_stub_last_error;
+#include "../cam_error.h"
 
+// The error channel (and cg_last_error_message) comes from cam_error.h, so
+// the stub shares state with the real no-OCCT modules linked alongside it.
 static void set_error(const char* msg) {
-    g_stub_last_error = msg ? msg : "";
+    set_last_error(msg);
 }
 
 extern "C" {
 
-const char* cg_last_error_message(void) {
-    return g_stub_last_error.c_str();
-}
-
 CgShapeId cg_load_step(const char* path) {
     if (!path) { set_error("cg_load_step: null path"); return CG_NULL_ID; }
     set_error("OCCT not available in stub");
@@ -39,9 +37,45 @@ CgMeshId  cg_load_stl(const char* path) {
     set_error("OCCT not available in stub");
     return CG_NULL_ID;
 }
+CgMeshId cg_load_stl_ex(const char* path, CgMeshPrecision p, double weld_tol) {
+    if (p != CG_MESH_F64 && p != CG_MESH_F32) {
+        set_error("cg_load_stl: invalid precision"); return CG_NULL_ID;
+    }
+    if (weld_tol < 0.0) {
+        set_error("cg_load_stl: invalid weld tolerance"); return CG_NULL_ID;
+    }
+    return cg_load_stl(path);
+}
 void cg_shape_free(CgShapeId /*id*/) {}
 
-CgShapeId cg_shape_heal(CgShapeId /*id*/) {
+CgError cg_shape_cache_set_dir(const char* /*dir*/) { return CG_OK; }
+
+CgJobId cg_load_step_async(const char* path) {
+    if (!path) { set_error("cg_load_step_async: null path"); return CG_NULL_ID; }
+    set_error("OCCT not available in stub");
+    return CG_NULL_ID;
+}
+CgJobStatus cg_job_status(CgJobId /*id*/) {
+    set_error("cg_job_status: invalid job ID"); return CG_JOB_FAILED;
+}
+double cg_job_progress(CgJobId /*id*/) { return 0.0; }
+CgError cg_job_cancel(CgJobId /*id*/) {
+    set_error("cg_job_cancel: invalid job ID"); return CG_ERR_NULL_HANDLE;
+}
+CgShapeId cg_job_shape(CgJobId /*id*/) {
+    set_error("cg_job_shape: invalid job ID"); return CG_NULL_ID;
+}
+void cg_job_free(CgJobId /*id*/) {}
+
+CgError cg_shape_heal_set_level(CgHealLevel level) {
+    if (level != CG_HEAL_NONE && level != CG_HEAL_BASIC && level != CG_HEAL_FULL) {
+        set_error("cg_shape_heal_set_level: invalid level");
+        return CG_ERR_INVALID_ARG;
+    }
+    return CG_OK;
+}
+CgShapeId cg_shape_heal(CgShapeId id) {
+    if (id == CG_NULL_ID) { set_error("cg_shape_heal: null handle"); return CG_NULL_ID; }
     set_error("not implemented"); return CG_NULL_ID;
 }
 
@@ -64,6 +98,68 @@ CgMeshId cg_shape_tessellate(CgShapeId id, double /*c*/, double /*a*/) {
     set_error("not implemented");
     return CG_NULL_ID;
 }
+CgMeshId cg_shape_tessellate_ex(CgShapeId id, double c, double a, CgMeshPrecision p) {
+    if (p != CG_MESH_F64 && p != CG_MESH_F32) {
+        set_error("cg_shape_tessellate: invalid precision"); return CG_NULL_ID;
+    }
+    return cg_shape_tessellate(id, c, a);
+}
+CgMeshId cg_shape_tessellate_welded(CgShapeId id, double c, double a,
+                                    CgMeshPrecision p, double weld_tol) {
+    if (weld_tol < 0.0) {
+        set_error("cg_shape_tessellate: invalid weld tolerance"); return CG_NULL_ID;
+    }
+    return cg_shape_tessellate_ex(id, c, a, p);
+}
+CgMeshId cg_shape_tessellate_welded_ex(CgShapeId id, double c, double a,
+                                       CgMeshPrecision p, double weld_tol,
+                                       CgNormalMode normal_mode) {
+    if (normal_mode != CG_NORMALS_LAZY && normal_mode != CG_NORMALS_EAGER) {
+        set_error("cg_shape_tessellate: invalid normal mode"); return CG_NULL_ID;
+    }
+    return cg_shape_tessellate_welded(id, c, a, p, weld_tol);
+}
+CgError cg_tess_cache_set_budget(size_t /*bytes*/) { return CG_OK; }
+CgError cg_tess_cache_stats(size_t* out_entries, size_t* out_bytes,
+                            uint64_t* out_hits, uint64_t* out_misses) {
+    if (out_entries) *out_entries = 0;
+    if (out_bytes)   *out_bytes   = 0;
+    if (out_hits)    *out_hits    = 0;
+    if (out_misses)  *out_misses  = 0;
+    return CG_OK;
+}
+void cg_tess_cache_clear(void) {}
+CgMeshStreamId cg_mesh_stream_begin(CgMeshId mesh_id, size_t chunk_triangles) {
+    if (mesh_id == CG_NULL_ID) { set_error("cg_mesh_stream_begin: null handle"); return CG_NULL_ID; }
+    if (chunk_triangles == 0) { set_error("cg_mesh_stream_begin: chunk_triangles must be > 0"); return CG_NULL_ID; }
+    set_error("not implemented"); return CG_NULL_ID;
+}
+CgError cg_mesh_stream_next(CgMeshStreamId id, float* out_vertices,
+                             float* /*out_normals*/, uint32_t* out_indices,
+                             size_t* out_n_vertices, size_t* out_n_triangles) {
+    if (out_n_vertices)  *out_n_vertices  = 0;
+    if (out_n_triangles) *out_n_triangles = 0;
+    if (!out_vertices || !out_indices || !out_n_vertices || !out_n_triangles) {
+        set_error("cg_mesh_stream_next: null output pointer"); return CG_ERR_INVALID_ARG;
+    }
+    if (id == CG_NULL_ID) { set_error("cg_mesh_stream_next: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NULL_HANDLE;
+}
+void cg_mesh_stream_free(CgMeshStreamId /*id*/) {}
+CgError cg_cache_save(const char* path) {
+    if (!path) { set_error("cg_cache_save: null path"); return CG_ERR_INVALID_ARG; }
+    set_error("not implemented"); return CG_ERR_NO_RESULT;
+}
+CgError cg_cache_load(const char* path, CgMeshId** out_meshes,
+                      size_t* out_count) {
+    if (!path || !out_meshes || !out_count) {
+        set_error("cg_cache_load: null argument"); return CG_ERR_INVALID_ARG;
+    }
+    *out_meshes = nullptr; *out_count = 0;
+    set_error("not implemented"); return CG_ERR_FILE_NOT_FOUND;
+}
+void cg_mesh_ids_free(CgMeshId* ids) { delete[] ids; }
+CgMeshPrecision cg_mesh_precision(CgMeshId /*id*/) { return CG_MESH_F64; }
 size_t  cg_mesh_vertex_count(CgMeshId /*id*/)   { return 0; }
 size_t  cg_mesh_triangle_count(CgMeshId /*id*/) { return 0; }
 CgError cg_mesh_copy_vertices(CgMeshId id, double* /*out*/) {
@@ -78,15 +174,66 @@ CgError cg_mesh_copy_indices(CgMeshId id, uint32_t* /*out*/) {
     if (id == CG_NULL_ID) { set_error("null handle"); return CG_ERR_NULL_HANDLE; }
     set_error("not implemented"); return CG_ERR_NULL_HANDLE;
 }
+CgError cg_mesh_copy_vertices_f32(CgMeshId id, float* /*out*/) {
+    if (id == CG_NULL_ID) { set_error("null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NULL_HANDLE;
+}
+CgError cg_mesh_copy_normals_f32(CgMeshId id, float* /*out*/) {
+    if (id == CG_NULL_ID) { set_error("null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NULL_HANDLE;
+}
+CgError cg_mesh_map(CgMeshId id) {
+    if (id == CG_NULL_ID) { set_error("cg_mesh_map: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NULL_HANDLE;
+}
+CgError cg_mesh_unmap(CgMeshId id) {
+    if (id == CG_NULL_ID) { set_error("cg_mesh_unmap: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_INVALID_ARG;
+}
+const double*   cg_mesh_vertices_ptr(CgMeshId /*id*/) { set_error("not implemented"); return nullptr; }
+const double*   cg_mesh_normals_ptr(CgMeshId /*id*/)  { set_error("not implemented"); return nullptr; }
+const uint32_t* cg_mesh_indices_ptr(CgMeshId /*id*/)  { set_error("not implemented"); return nullptr; }
+const float*    cg_mesh_vertices_ptr_f32(CgMeshId /*id*/) { set_error("not implemented"); return nullptr; }
+const float*    cg_mesh_normals_ptr_f32(CgMeshId /*id*/)  { set_error("not implemented"); return nullptr; }
 void cg_mesh_free(CgMeshId /*id*/) {}
 
+CgMeshId cg_mesh_simplify(CgMeshId id, double target_ratio, double /*max_error*/) {
+    if (id == CG_NULL_ID) { set_error("cg_mesh_simplify: null handle"); return CG_NULL_ID; }
+    if (!(target_ratio > 0.0) || target_ratio > 1.0) {
+        set_error("cg_mesh_simplify: target_ratio must be in (0, 1]"); return CG_NULL_ID;
+    }
+    set_error("not implemented"); return CG_NULL_ID;
+}
+CgError cg_mesh_build_lods(CgMeshId id, const double* ratios, size_t n,
+                           CgMeshId* out_meshes) {
+    if (!ratios || !out_meshes || n == 0) {
+        set_error("cg_mesh_build_lods: null array"); return CG_ERR_INVALID_ARG;
+    }
+    if (id == CG_NULL_ID) { set_error("cg_mesh_build_lods: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NULL_HANDLE;
+}
+
 CgSurfaceType cg_face_surface_type(CgFaceId /*id*/) { set_error("not implemented"); return CG_SURF_OTHER; }
 CgUVBounds    cg_face_uv_bounds(CgFaceId /*id*/)    { set_error("not implemented"); return CgUVBounds{0,0,0,0}; }
 CgPoint3 cg_face_eval_point(CgFaceId /*id*/, double /*u*/, double /*v*/)  { set_error("not implemented"); return CgPoint3{0,0,0}; }
 CgVec3   cg_face_eval_normal(CgFaceId /*id*/, double /*u*/, double /*v*/) { set_error("not implemented"); return CgVec3{0,0,0}; }
 CgVec3   cg_face_eval_du(CgFaceId /*id*/, double /*u*/, double /*v*/)     { set_error("not implemented"); return CgVec3{0,0,0}; }
 CgVec3   cg_face_eval_dv(CgFaceId /*id*/, double /*u*/, double /*v*/)     { set_error("not implemented"); return CgVec3{0,0,0}; }
+CgError cg_face_eval_batch(CgFaceId id, const double* uv_pairs, size_t /*n*/,
+                           CgPoint3* /*pts*/, CgVec3* /*nrm*/,
+                           CgVec3* /*du*/, CgVec3* /*dv*/) {
+    if (!uv_pairs) { set_error("cg_face_eval_batch: null uv_pairs"); return CG_ERR_INVALID_ARG; }
+    if (id == CG_NULL_ID) { set_error("cg_face_eval_batch: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NO_RESULT;
+}
 CgPoint2 cg_face_project_point(CgFaceId /*id*/, CgPoint3 /*p*/, double* /*d*/) { set_error("not implemented"); return CgPoint2{0,0}; }
+CgError cg_face_project_points(CgFaceId id, const CgPoint3* points, size_t /*n*/,
+                               const double* /*seeds*/, CgPoint2* out_uvs,
+                               double* /*dists*/) {
+    if (!points || !out_uvs) { set_error("cg_face_project_points: null array"); return CG_ERR_INVALID_ARG; }
+    if (id == CG_NULL_ID) { set_error("cg_face_project_points: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NO_RESULT;
+}
 CgError  cg_face_plane(CgFaceId /*id*/, CgVec3* /*n*/, CgPoint3* /*o*/)        { set_error("not implemented"); return CG_ERR_NO_RESULT; }
 CgError  cg_face_cylinder(CgFaceId /*id*/, CgVec3* /*ax*/, CgPoint3* /*o*/, double* /*r*/) { set_error("not implemented"); return CG_ERR_NO_RESULT; }
 
@@ -95,8 +242,44 @@ CgPoint3 cg_edge_eval_point(CgEdgeId /*id*/, double /*t*/)                { set_
 CgVec3   cg_edge_eval_tangent(CgEdgeId /*id*/, double /*t*/)              { set_error("not implemented"); return CgVec3{0,0,0}; }
 double   cg_edge_length(CgEdgeId /*id*/)                                  { set_error("not implemented"); return 0.0; }
 int      cg_edge_is_circle(CgEdgeId /*id*/, CgPoint3* /*c*/, CgVec3* /*ax*/, double* /*r*/) { set_error("not implemented"); return 0; }
+CgError cg_edge_discretize(CgEdgeId id, double chord_tol,
+                            CgPoint3** out_points, double** out_params,
+                            size_t* out_count) {
+    if (out_points) *out_points = nullptr;
+    if (out_params) *out_params = nullptr;
+    if (out_count)  *out_count  = 0;
+    if (!out_points || !out_count) { set_error("cg_edge_discretize: null output pointer"); return CG_ERR_INVALID_ARG; }
+    if (!(chord_tol > 0.0)) { set_error("cg_edge_discretize: chord_tol must be positive"); return CG_ERR_INVALID_ARG; }
+    if (id == CG_NULL_ID) { set_error("cg_edge_discretize: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NO_RESULT;
+}
+CgError cg_edge_discretize_batch(const CgEdgeId* edges, size_t n_edges,
+                                  double chord_tol, CgPoint3** out_points,
+                                  double** out_params, size_t** out_edge_counts) {
+    if (out_points)      *out_points      = nullptr;
+    if (out_params)      *out_params      = nullptr;
+    if (out_edge_counts) *out_edge_counts = nullptr;
+    if (!edges || !out_points || !out_edge_counts) { set_error("cg_edge_discretize_batch: null argument"); return CG_ERR_INVALID_ARG; }
+    if (!(chord_tol > 0.0)) { set_error("cg_edge_discretize_batch: chord_tol must be positive"); return CG_ERR_INVALID_ARG; }
+    for (size_t i = 0; i < n_edges; ++i)
+        if (edges[i] == CG_NULL_ID) { set_error("cg_edge_discretize_batch: null handle in array"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NO_RESULT;
+}
+void cg_params_free(double* params) { delete[] params; }
 
-double  cg_shape_distance(CgShapeId /*a*/, CgShapeId /*b*/)               { set_error("not implemented"); return -1.0; }
+double  cg_shape_distance(CgShapeId a, CgShapeId b) {
+    if (a == CG_NULL_ID || b == CG_NULL_ID) { set_error("cg_shape_distance: null handle"); return -1.0; }
+    set_error("not implemented");
+    return -1.0;
+}
+CgError cg_shape_distance_batch(CgShapeId fixed_shape, CgShapeId moving,
+                                 const double* transforms, size_t /*n*/,
+                                 double* out_distances) {
+    if (!transforms || !out_distances) { set_error("cg_shape_distance_batch: null array"); return CG_ERR_INVALID_ARG; }
+    if (fixed_shape == CG_NULL_ID || moving == CG_NULL_ID) { set_error("cg_shape_distance_batch: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented");
+    return CG_ERR_NO_RESULT;
+}
 CgError cg_shape_section_at_z(CgShapeId /*id*/, double /*z*/, CgPoint3** pts, size_t* cnt) {
     set_error("not implemented");
     if (pts) *pts = nullptr;
@@ -105,23 +288,53 @@ CgError cg_shape_section_at_z(CgShapeId /*id*/, double /*z*/, CgPoint3** pts, si
 }
 void cg_section_free(CgPoint3* pts) { delete[] pts; }
 
-size_t cg_shape_find_holes(CgShapeId /*id*/, double /*mn*/, double /*mx*/, CgHoleInfo** out) {
-    set_error("not implemented"); if (out) *out = nullptr; return 0;
+CgSlicerId cg_slicer_new(CgShapeId id) {
+    if (id == CG_NULL_ID) { set_error("cg_slicer_new: null handle"); return CG_NULL_ID; }
+    set_error("not implemented"); return CG_NULL_ID;
 }
-void cg_holes_free(CgHoleInfo* h) { delete[] h; }
-size_t cg_shape_find_planar_faces(CgShapeId /*id*/, CgPlanarFaceInfo** out) {
-    set_error("not implemented"); if (out) *out = nullptr; return 0;
+void cg_slicer_free(CgSlicerId /*id*/) {}
+CgError cg_slicer_section_multi_z(CgSlicerId id, const double* /*zs*/, size_t /*n*/,
+                                   double /*tol*/, CgPoint3** pts, size_t** counts) {
+    if (pts)    *pts    = nullptr;
+    if (counts) *counts = nullptr;
+    if (id == CG_NULL_ID) { set_error("cg_slicer_section_multi_z: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NULL_HANDLE;
+}
+void cg_level_counts_free(size_t* counts) { delete[] counts; }
+
+CgError cg_shape_section_loops_at_z(CgShapeId id, double /*z*/, CgPoint3** pts,
+                                     size_t** loop_counts, size_t* n_loops) {
+    if (pts)         *pts         = nullptr;
+    if (loop_counts) *loop_counts = nullptr;
+    if (n_loops)     *n_loops     = 0;
+    if (id == CG_NULL_ID) { set_error("cg_shape_section_loops_at_z: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NULL_HANDLE;
+}
+CgError cg_slicer_section_loops_multi_z(CgSlicerId id, const double* /*zs*/, size_t /*n*/,
+                                         double /*tol*/, CgPoint3** pts,
+                                         size_t** loop_counts, size_t** level_loops) {
+    if (pts)         *pts         = nullptr;
+    if (loop_counts) *loop_counts = nullptr;
+    if (level_loops) *level_loops = nullptr;
+    if (id == CG_NULL_ID) { set_error("cg_slicer_section_loops_multi_z: null handle"); return CG_ERR_NULL_HANDLE; }
+    set_error("not implemented"); return CG_ERR_NULL_HANDLE;
 }
-void cg_planar_faces_free(CgPlanarFaceInfo* f) { delete[] f; }
 
-CgError cg_poly_offset(const double* /*pts*/, size_t /*n*/, double /*d*/, double /*tol*/,
-                        double** out, size_t* cnt) {
-    set_error("not implemented"); if (out) *out=nullptr; if (cnt) *cnt=0; return CG_ERR_NO_RESULT;
+size_t cg_shape_find_holes(CgShapeId id, double mn, double mx, CgHoleInfo** out) {
+    if (out) *out = nullptr;
+    if (id == CG_NULL_ID || !out) { set_error("cg_shape_find_holes: null argument"); return 0; }
+    if (mn < 0.0 || mx < mn) { set_error("cg_shape_find_holes: invalid diameter range"); return 0; }
+    set_error("not implemented"); return 0;
 }
-void cg_poly_free(double* pts) { delete[] pts; }
-CgError cg_poly_boolean(const double* /*a*/, size_t /*na*/, const double* /*b*/, size_t /*nb*/,
-                         CgBoolOp /*op*/, double** out, size_t* cnt) {
-    set_error("not implemented"); if (out) *out=nullptr; if (cnt) *cnt=0; return CG_ERR_NO_RESULT;
+void cg_holes_free(CgHoleInfo* h) { delete[] h; }
+size_t cg_shape_find_planar_faces(CgShapeId id, CgPlanarFaceInfo** out) {
+    if (out) *out = nullptr;
+    if (id == CG_NULL_ID || !out) { set_error("cg_shape_find_planar_faces: null argument"); return 0; }
+    set_error("not implemented"); return 0;
 }
+void cg_planar_faces_free(CgPlanarFaceInfo* f) { delete[] f; }
+
+// 2D polygon operations are NOT stubbed here: cam_polygon.cpp has no OCCT
+// dependency, so stub test builds link the real implementation directly.
 
 } // extern "C"
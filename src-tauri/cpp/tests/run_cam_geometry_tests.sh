@@ -19,12 +19,30 @@ SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 CPP_DIR="$(dirname "$SCRIPT_DIR")"
 CXX="${CXX:-g++}"
 
+# Clipper2 sources needed by the real cam_polygon.cpp (no OCCT dependency —
+# the stub build links the real polygon implementation).
+CLIPPER2_DIR="$CPP_DIR/third_party/Clipper2/Clipper2Lib"
+CLIPPER2_SOURCES=(
+    "$CLIPPER2_DIR/src/clipper.engine.cpp"
+    "$CLIPPER2_DIR/src/clipper.offset.cpp"
+    "$CLIPPER2_DIR/src/clipper.rectclip.cpp"
+)
+
 # ── 1. Stub tests (no OCCT) ──────────────────────────────────────────────────
 echo "=== Building stub tests ==="
 STUB_BIN="$SCRIPT_DIR/test_cam_geometry_stub"
-"$CXX" -std=c++17 -I"$CPP_DIR" -Wall -Wextra \
+"$CXX" -std=c++17 -I"$CPP_DIR" -I"$CLIPPER2_DIR/include" -Wall -Wextra \
     "$SCRIPT_DIR/test_cam_geometry.cpp" \
     "$SCRIPT_DIR/cam_geometry_stub.cpp" \
+    "$CPP_DIR/cam_bvh.cpp" \
+    "$CPP_DIR/cam_heightmap.cpp" \
+    "$CPP_DIR/cam_perf.cpp" \
+    "$CPP_DIR/cam_stock.cpp" \
+    "$CPP_DIR/cam_threads.cpp" \
+    "$CPP_DIR/cam_polygon.cpp" \
+    "$CPP_DIR/cam_error.cpp" \
+    "${CLIPPER2_SOURCES[@]}" \
+    -pthread \
     -o "$STUB_BIN"
 
 echo "=== Running stub tests ==="
@@ -67,12 +85,23 @@ echo "=== Building OCCT integration tests (OCCT found at $OCCT_INCLUDE) ==="
 OCCT_BIN="$SCRIPT_DIR/test_cam_geometry_occt"
 "$CXX" -std=c++17 \
     -I"$CPP_DIR" \
+    -I"$CLIPPER2_DIR/include" \
     -I"$OCCT_INCLUDE" \
     "$SCRIPT_DIR/test_cam_geometry.cpp" \
+    "$CPP_DIR/cam_bvh.cpp" \
     "$CPP_DIR/cam_geometry.cpp" \
+    "$CPP_DIR/cam_heightmap.cpp" \
+    "$CPP_DIR/cam_perf.cpp" \
+    "$CPP_DIR/cam_polygon.cpp" \
+    "$CPP_DIR/cam_stock.cpp" \
+    "$CPP_DIR/cam_threads.cpp" \
+    "$CPP_DIR/cam_error.cpp" \
     "$CPP_DIR/handle_registry.cpp" \
+    "$CPP_DIR/section_chaining.cpp" \
+    "${CLIPPER2_SOURCES[@]}" \
     -L"$OCCT_LIB" \
     -lTKBRep -lTKernel -lTKMath -lTKGeomBase -lTKGeom3d \
+    -lTKTopAlgo -lTKGeomAlgo -lTKBO \
     -lTKMesh -lTKSTL -lTKXSBase -lTKSTEP -lTKSTEPBase -lTKSTEPAttr -lTKShHealing \
     -Wl,-rpath,"$OCCT_LIB" \
     -pthread \
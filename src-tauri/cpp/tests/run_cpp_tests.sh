@@ -1,7 +1,8 @@
 #!/usr/bin/env bash
-# run_cpp_tests.sh — compile and run the C++ unit tests for handle_registry.
+# run_cpp_tests.sh — compile and run the OCCT-free C++ unit tests.
 #
-# The tests use mock types so no OCCT installation is required.
+# Covers handle_registry (mock types), slot_map, bvh, section_chaining and
+# the Clipper2 polygon operations; no OCCT installation is required.
 #
 # Usage:
 #   bash src-tauri/cpp/tests/run_cpp_tests.sh
@@ -11,10 +12,10 @@ set -euo pipefail
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 CPP_DIR="$(dirname "$SCRIPT_DIR")"
-BIN="$SCRIPT_DIR/test_handle_registry"
 
 CXX="${CXX:-g++}"
 
+BIN="$SCRIPT_DIR/test_handle_registry"
 echo "Compiling $BIN ..."
 "$CXX" -std=c++17 -I"$CPP_DIR" -pthread -Wall -Wextra \
     "$SCRIPT_DIR/test_handle_registry.cpp" \
@@ -22,3 +23,130 @@ echo "Compiling $BIN ..."
 
 echo "Running tests ..."
 "$BIN"
+
+BIN="$SCRIPT_DIR/test_slot_map"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -pthread -Wall -Wextra \
+    "$SCRIPT_DIR/test_slot_map.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+BIN="$SCRIPT_DIR/test_worker_pool"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -pthread -Wall -Wextra \
+    "$SCRIPT_DIR/test_worker_pool.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+BIN="$SCRIPT_DIR/test_perf_counters"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -Wall -Wextra \
+    "$SCRIPT_DIR/test_perf_counters.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+BIN="$SCRIPT_DIR/test_bvh"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -Wall -Wextra \
+    "$SCRIPT_DIR/test_bvh.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+BIN="$SCRIPT_DIR/test_heightmap"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -pthread -Wall -Wextra \
+    "$SCRIPT_DIR/test_heightmap.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+BIN="$SCRIPT_DIR/test_dexel"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -pthread -Wall -Wextra \
+    "$SCRIPT_DIR/test_dexel.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+BIN="$SCRIPT_DIR/test_weld"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -Wall -Wextra \
+    "$SCRIPT_DIR/test_weld.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+BIN="$SCRIPT_DIR/test_decimate"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -Wall -Wextra \
+    "$SCRIPT_DIR/test_decimate.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+BIN="$SCRIPT_DIR/test_stl_import"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -pthread -Wall -Wextra \
+    "$SCRIPT_DIR/test_stl_import.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+BIN="$SCRIPT_DIR/test_geom_cache"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -Wall -Wextra \
+    "$SCRIPT_DIR/test_geom_cache.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+BIN="$SCRIPT_DIR/test_section_chaining"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -Wall -Wextra \
+    "$SCRIPT_DIR/test_section_chaining.cpp" \
+    "$CPP_DIR/section_chaining.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
+
+CLIPPER2_DIR="$CPP_DIR/third_party/Clipper2/Clipper2Lib"
+BIN="$SCRIPT_DIR/test_polygon"
+echo ""
+echo "Compiling $BIN ..."
+"$CXX" -std=c++17 -I"$CPP_DIR" -I"$CLIPPER2_DIR/include" -Wall -Wextra \
+    "$SCRIPT_DIR/test_polygon.cpp" \
+    "$CPP_DIR/cam_polygon.cpp" \
+    "$CPP_DIR/cam_error.cpp" \
+    "$CLIPPER2_DIR/src/clipper.engine.cpp" \
+    "$CLIPPER2_DIR/src/clipper.offset.cpp" \
+    "$CLIPPER2_DIR/src/clipper.rectclip.cpp" \
+    -o "$BIN"
+
+echo "Running tests ..."
+"$BIN"
@@ -0,0 +1,322 @@
+// test_bvh.cpp
+//
+// Unit tests for the triangle BVH in bvh.h.
+//
+// Compiles without OCCT.
+//
+// Build:
+//   g++ -std=c++17 -I.. test_bvh.cpp -o test_bvh
+// Run:
+//   ./test_bvh
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include <iostream>
+
+#include "bvh.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define ASSERT_NEAR(label, a, b, tol) \
+    do { if (std::fabs((a) - (b)) <= (tol)) pass(label); \
+         else fail(label, #a " not within " #tol " of " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+// ---------------------------------------------------------------------------
+// Fixtures
+// ---------------------------------------------------------------------------
+
+// Axis-aligned box [0,10]^3 as 12 triangles (same shape as the STEP/STL
+// fixtures the OCCT tests use).
+struct BoxMesh {
+    std::vector<double>   vertices;
+    std::vector<uint32_t> indices;
+};
+
+static BoxMesh make_box() {
+    BoxMesh m;
+    m.vertices = {
+        0, 0, 0,   10, 0, 0,   10, 10, 0,   0, 10, 0,   // z = 0
+        0, 0, 10,  10, 0, 10,  10, 10, 10,  0, 10, 10,  // z = 10
+    };
+    m.indices = {
+        0, 2, 1,  0, 3, 2,   // bottom
+        4, 5, 6,  4, 6, 7,   // top
+        0, 1, 5,  0, 5, 4,   // y = 0
+        3, 6, 2,  3, 7, 6,   // y = 10
+        0, 4, 7,  0, 7, 3,   // x = 0
+        1, 2, 6,  1, 6, 5,   // x = 10
+    };
+    return m;
+}
+
+// Brute-force reference for the traversal tests.
+static double brute_closest_dist(const BoxMesh& m, const double p[3]) {
+    double best = std::numeric_limits<double>::infinity();
+    for (size_t t = 0; t * 3 < m.indices.size(); ++t) {
+        TriangleBvh single;
+        single.build(m.vertices.data(), m.indices.data() + t * 3, 1);
+        best = std::min(best, single.closest_point(p).distance);
+    }
+    return best;
+}
+
+// ---------------------------------------------------------------------------
+// Ray casting
+// ---------------------------------------------------------------------------
+
+TEST(raycast_hits_box_top) {
+    BoxMesh m = make_box();
+    TriangleBvh bvh;
+    bvh.build(m.vertices.data(), m.indices.data(), m.indices.size() / 3);
+    ASSERT_EQ("tree holds all triangles", bvh.triangle_count(), size_t{12});
+
+    double origin[3] = {5, 5, 20};
+    double dir[3]    = {0, 0, -1};
+    TriangleBvh::RayHit hit = bvh.raycast(origin, dir);
+    ASSERT_TRUE("downward ray hits", hit.tri != TriangleBvh::kNoHit);
+    ASSERT_NEAR("hit is on the top face (t = 10)", hit.t, 10.0, 1e-12);
+}
+
+TEST(raycast_nearest_of_two_faces) {
+    BoxMesh m = make_box();
+    TriangleBvh bvh;
+    bvh.build(m.vertices.data(), m.indices.data(), m.indices.size() / 3);
+
+    // From inside-out the ray crosses both x faces; nearest is x = 10.
+    double origin[3] = {8, 5, 5};
+    double dir[3]    = {1, 0, 0};
+    TriangleBvh::RayHit hit = bvh.raycast(origin, dir);
+    ASSERT_NEAR("nearest intersection wins", hit.t, 2.0, 1e-12);
+
+    // Scaled direction: t is in units of |dir|.
+    double dir2[3] = {2, 0, 0};
+    ASSERT_NEAR("t scales with direction length",
+                bvh.raycast(origin, dir2).t, 1.0, 1e-12);
+}
+
+TEST(raycast_miss) {
+    BoxMesh m = make_box();
+    TriangleBvh bvh;
+    bvh.build(m.vertices.data(), m.indices.data(), m.indices.size() / 3);
+
+    double origin[3] = {20, 20, 20};
+    double dir[3]    = {1, 0, 0};
+    TriangleBvh::RayHit hit = bvh.raycast(origin, dir);
+    ASSERT_EQ("miss reports kNoHit", hit.tri, TriangleBvh::kNoHit);
+    ASSERT_TRUE("miss reports t < 0", hit.t < 0.0);
+
+    // Pointing at the box but starting past it: hits behind the origin
+    // do not count.
+    double behind[3] = {5, 5, -1};
+    double up[3]     = {0, 0, -1};
+    ASSERT_EQ("hit behind origin does not count",
+              bvh.raycast(behind, up).tri, TriangleBvh::kNoHit);
+}
+
+TEST(raycast_f32_vertices) {
+    BoxMesh m = make_box();
+    std::vector<float> v32(m.vertices.begin(), m.vertices.end());
+    TriangleBvh bvh;
+    bvh.build(v32.data(), m.indices.data(), m.indices.size() / 3);
+
+    double origin[3] = {5, 5, 20};
+    double dir[3]    = {0, 0, -1};
+    ASSERT_NEAR("float32 build hits at the same t",
+                bvh.raycast(origin, dir).t, 10.0, 1e-6);
+}
+
+// ---------------------------------------------------------------------------
+// Closest point
+// ---------------------------------------------------------------------------
+
+TEST(closest_point_regions) {
+    BoxMesh m = make_box();
+    TriangleBvh bvh;
+    bvh.build(m.vertices.data(), m.indices.data(), m.indices.size() / 3);
+
+    // Above a face interior.
+    double above[3] = {5, 5, 13};
+    TriangleBvh::ClosestHit hit = bvh.closest_point(above);
+    ASSERT_NEAR("face-interior distance", hit.distance, 3.0, 1e-12);
+    ASSERT_NEAR("face-interior point x", hit.point[0], 5.0, 1e-12);
+    ASSERT_NEAR("face-interior point z", hit.point[2], 10.0, 1e-12);
+
+    // Beyond a corner: nearest feature is the vertex (10, 10, 10).
+    double corner[3] = {13, 14, 12};
+    hit = bvh.closest_point(corner);
+    ASSERT_NEAR("corner distance", hit.distance,
+                std::sqrt(3 * 3 + 4 * 4 + 2 * 2), 1e-12);
+
+    // Beyond an edge: nearest feature is the edge x=10, z=10.
+    double edge[3] = {13, 5, 14};
+    hit = bvh.closest_point(edge);
+    ASSERT_NEAR("edge distance", hit.distance, 5.0, 1e-12);
+
+    // On the surface.
+    double on[3] = {10, 5, 5};
+    ASSERT_NEAR("on-surface distance is 0", bvh.closest_point(on).distance,
+                0.0, 1e-12);
+}
+
+TEST(closest_point_matches_brute_force) {
+    BoxMesh m = make_box();
+    TriangleBvh bvh;
+    bvh.build(m.vertices.data(), m.indices.data(), m.indices.size() / 3);
+
+    std::srand(20260828);
+    bool all_match = true;
+    for (int i = 0; i < 200; ++i) {
+        double p[3];
+        for (int a = 0; a < 3; ++a)
+            p[a] = -10.0 + 40.0 * (std::rand() / double(RAND_MAX));
+        const double got = bvh.closest_point(p).distance;
+        const double ref = brute_closest_dist(m, p);
+        if (std::fabs(got - ref) > 1e-9) all_match = false;
+    }
+    ASSERT_TRUE("200 random queries match per-triangle brute force", all_match);
+}
+
+// ---------------------------------------------------------------------------
+// Degenerate input
+// ---------------------------------------------------------------------------
+
+TEST(empty_tree_is_safe) {
+    TriangleBvh bvh;
+    ASSERT_TRUE("default tree is empty", bvh.empty());
+    double origin[3] = {0, 0, 0};
+    double dir[3]    = {0, 0, 1};
+    ASSERT_EQ("raycast on empty tree misses",
+              bvh.raycast(origin, dir).tri, TriangleBvh::kNoHit);
+    ASSERT_TRUE("closest_point on empty tree reports distance < 0",
+                bvh.closest_point(origin).distance < 0.0);
+}
+
+TEST(coincident_triangles_build) {
+    // All centroids identical — the splitter must fall back to one leaf
+    // instead of recursing forever.
+    std::vector<double>   v = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+    std::vector<uint32_t> idx;
+    for (int t = 0; t < 10; ++t) { idx.push_back(0); idx.push_back(1); idx.push_back(2); }
+    TriangleBvh bvh;
+    bvh.build(v.data(), idx.data(), 10);
+    ASSERT_EQ("coincident triangles all stored", bvh.triangle_count(), size_t{10});
+    double p[3] = {0, 0, 5};
+    ASSERT_NEAR("queries still work", bvh.closest_point(p).distance, 5.0, 1e-12);
+}
+
+// ---------------------------------------------------------------------------
+// Mesh-to-mesh distance
+// ---------------------------------------------------------------------------
+
+TEST(distance_between_separated_boxes) {
+    const BoxMesh m = make_box();
+    TriangleBvh a, b;
+    a.build(m.vertices.data(), m.indices.data(), m.indices.size() / 3);
+
+    std::vector<double> shifted = m.vertices;
+    for (size_t i = 2; i < shifted.size(); i += 3) shifted[i] += 25.0;
+    b.build(shifted.data(), m.indices.data(), m.indices.size() / 3);
+
+    ASSERT_NEAR("gap between stacked boxes", a.distance_to(b), 15.0, 1e-12);
+    ASSERT_NEAR("distance is symmetric", b.distance_to(a), 15.0, 1e-12);
+}
+
+TEST(distance_with_transform) {
+    const BoxMesh m = make_box();
+    TriangleBvh a, b;
+    a.build(m.vertices.data(), m.indices.data(), m.indices.size() / 3);
+    b.build(m.vertices.data(), m.indices.data(), m.indices.size() / 3);
+
+    // Identity placement: the meshes coincide.
+    ASSERT_NEAR("coincident copies touch", a.distance_to(b), 0.0, 1e-12);
+
+    // Translate b by +30 in z: gap of 20 between [0,10] and [30,40].
+    const double xf[12] = {1, 0, 0, 0,
+                           0, 1, 0, 0,
+                           0, 0, 1, 30};
+    ASSERT_NEAR("translated placement opens a gap",
+                a.distance_to(b, xf), 20.0, 1e-12);
+
+    // Rotate 90° about z and translate — rigid motion preserves the gap.
+    const double rot[12] = {0, -1, 0, 0,
+                            1,  0, 0, 0,
+                            0,  0, 1, 30};
+    ASSERT_NEAR("rotated placement keeps the gap",
+                a.distance_to(b, rot), 20.0, 1e-12);
+}
+
+TEST(distance_detects_penetration) {
+    const BoxMesh m = make_box();
+    TriangleBvh a, b;
+    a.build(m.vertices.data(), m.indices.data(), m.indices.size() / 3);
+
+    // Overlapping box: surfaces cross, so the distance is exactly zero.
+    std::vector<double> shifted = m.vertices;
+    for (size_t i = 0; i < shifted.size(); i += 3) shifted[i] += 5.0;
+    b.build(shifted.data(), m.indices.data(), m.indices.size() / 3);
+    ASSERT_NEAR("interpenetrating boxes report zero", a.distance_to(b),
+                0.0, 1e-12);
+}
+
+TEST(distance_empty_tree) {
+    const BoxMesh m = make_box();
+    TriangleBvh a, empty;
+    a.build(m.vertices.data(), m.indices.data(), m.indices.size() / 3);
+    ASSERT_TRUE("distance to an empty tree reports < 0",
+                a.distance_to(empty) < 0.0);
+    ASSERT_TRUE("distance from an empty tree reports < 0",
+                empty.distance_to(a) < 0.0);
+}
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "test_bvh\n";
+
+    test_raycast_hits_box_top();
+    test_raycast_nearest_of_two_faces();
+    test_raycast_miss();
+    test_raycast_f32_vertices();
+    test_closest_point_regions();
+    test_closest_point_matches_brute_force();
+    test_empty_tree_is_safe();
+    test_coincident_triangles_build();
+    test_distance_between_separated_boxes();
+    test_distance_with_transform();
+    test_distance_detects_penetration();
+    test_distance_empty_tree();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
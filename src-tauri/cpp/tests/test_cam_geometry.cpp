@@ -14,10 +14,14 @@
 // Run:
 //   ./test_cam_geometry
 
+#include <cmath>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "cam_geometry.h"
 
@@ -49,6 +53,10 @@ static void fail(const char* label, const char* reason = "") {
 #define ASSERT_NE(label, a, b) \
     do { if ((a) != (b)) pass(label); else fail(label, #a " == " #b); } while (0)
 
+#define ASSERT_NEAR(label, a, b, tol) \
+    do { if (std::fabs((a) - (b)) <= (tol)) pass(label); \
+         else fail(label, #a " not within " #tol " of " #b); } while (0)
+
 #define TEST(name) static void test_##name()
 
 // ---------------------------------------------------------------------------
@@ -95,6 +103,266 @@ TEST(load_stl_missing_file) {
                 std::string(cg_last_error_message()).size() > 0);
 }
 
+TEST(shape_cache_set_dir_accepts_path_and_null) {
+    ASSERT_EQ("cg_shape_cache_set_dir(path) returns CG_OK",
+              (int)cg_shape_cache_set_dir("/tmp"), (int)CG_OK);
+    ASSERT_EQ("cg_shape_cache_set_dir(NULL) disables and returns CG_OK",
+              (int)cg_shape_cache_set_dir(nullptr), (int)CG_OK);
+}
+
+TEST(job_api_null_handling) {
+    ASSERT_EQ("cg_load_step_async(null) returns CG_NULL_ID",
+              cg_load_step_async(nullptr), CG_NULL_ID);
+    ASSERT_EQ("cg_job_status(unknown) returns CG_JOB_FAILED",
+              (int)cg_job_status(123456), (int)CG_JOB_FAILED);
+    ASSERT_EQ("cg_job_progress(unknown) returns 0", cg_job_progress(123456), 0.0);
+    ASSERT_EQ("cg_job_cancel(unknown) returns CG_ERR_NULL_HANDLE",
+              (int)cg_job_cancel(123456), (int)CG_ERR_NULL_HANDLE);
+    ASSERT_EQ("cg_job_shape(unknown) returns CG_NULL_ID",
+              cg_job_shape(123456), CG_NULL_ID);
+    cg_job_free(CG_NULL_ID);
+    cg_job_free(123456);
+    pass("cg_job_free on null/unknown IDs does not crash");
+}
+
+TEST(bvh_api_error_paths) {
+    ASSERT_EQ("cg_mesh_build_bvh(null) returns CG_NULL_ID",
+              cg_mesh_build_bvh(CG_NULL_ID), CG_NULL_ID);
+    ASSERT_EQ("cg_mesh_build_bvh(unknown mesh) returns CG_NULL_ID",
+              cg_mesh_build_bvh(123456), CG_NULL_ID);
+
+    double         origins[3] = {0, 0, 0};
+    double         dirs[3]    = {0, 0, 1};
+    CgRayHit       hit;
+    CgClosestPoint cp;
+    ASSERT_EQ("raycast with null arrays returns CG_ERR_INVALID_ARG",
+              (int)cg_bvh_raycast_batch(123456, nullptr, dirs, 1, &hit),
+              (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("raycast on unknown BVH returns CG_ERR_NULL_HANDLE",
+              (int)cg_bvh_raycast_batch(123456, origins, dirs, 1, &hit),
+              (int)CG_ERR_NULL_HANDLE);
+    ASSERT_EQ("closest_point with null arrays returns CG_ERR_INVALID_ARG",
+              (int)cg_bvh_closest_point_batch(123456, nullptr, 1, &cp),
+              (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("closest_point on unknown BVH returns CG_ERR_NULL_HANDLE",
+              (int)cg_bvh_closest_point_batch(123456, origins, 1, &cp),
+              (int)CG_ERR_NULL_HANDLE);
+    cg_bvh_free(CG_NULL_ID);
+    cg_bvh_free(123456);
+    pass("cg_bvh_free on null/unknown IDs does not crash");
+}
+
+TEST(heightmap_api_error_paths) {
+    CgBbox bounds{0, 0, 0, 10, 10, 10};
+    float* grid = nullptr;
+    ASSERT_EQ("rasterize with null output returns CG_ERR_INVALID_ARG",
+              (int)cg_mesh_rasterize_heightmap(123456, bounds, 4, 4, nullptr),
+              (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("rasterize with zero resolution returns CG_ERR_INVALID_ARG",
+              (int)cg_mesh_rasterize_heightmap(123456, bounds, 0, 4, &grid),
+              (int)CG_ERR_INVALID_ARG);
+    CgBbox empty{10, 10, 0, 0, 0, 10};
+    ASSERT_EQ("rasterize with empty bounds returns CG_ERR_INVALID_ARG",
+              (int)cg_mesh_rasterize_heightmap(123456, empty, 4, 4, &grid),
+              (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("rasterize null mesh returns CG_ERR_NULL_HANDLE",
+              (int)cg_mesh_rasterize_heightmap(CG_NULL_ID, bounds, 4, 4, &grid),
+              (int)CG_ERR_NULL_HANDLE);
+    ASSERT_EQ("rasterize unknown mesh returns CG_ERR_NULL_HANDLE",
+              (int)cg_mesh_rasterize_heightmap(123456, bounds, 4, 4, &grid),
+              (int)CG_ERR_NULL_HANDLE);
+    ASSERT_EQ("failed rasterize clears the output pointer",
+              grid, (float*)nullptr);
+    cg_heightmap_free(nullptr);
+    pass("cg_heightmap_free(nullptr) does not crash");
+}
+
+// The stock model has no OCCT dependency, so the stub build exercises the
+// real implementation.
+TEST(stock_block_sweep_real) {
+    CgBbox bounds{0, 0, 0, 20, 20, 10};
+    CgStockId stock = cg_stock_new(bounds, 0.5);
+    ASSERT_TRUE("cg_stock_new returns a handle", stock != CG_NULL_ID);
+    ASSERT_NEAR("block volume is 20*20*10", cg_stock_volume(stock), 4000.0, 1e-6);
+
+    CgToolDef tool{6.0, 0.0};
+    CgPoint3  pt{10, 10, 8};
+    double removed = 0, engagement = 0;
+    ASSERT_EQ("subtract_sweep returns CG_OK",
+              (int)cg_stock_subtract_sweep(stock, tool, &pt, 1, &removed,
+                                           &engagement),
+              (int)CG_OK);
+    ASSERT_TRUE("plunge removes material", removed > 0.0);
+    ASSERT_TRUE("buried plunge is fully engaged", engagement > 6.0);
+    ASSERT_NEAR("volume accounting is consistent",
+                4000.0 - cg_stock_volume(stock), removed, 1e-6);
+
+    // Dry run does not change the stock.
+    const double before = cg_stock_volume(stock);
+    ASSERT_EQ("cg_stock_engagement returns CG_OK",
+              (int)cg_stock_engagement(stock, tool, &pt, 1, &removed,
+                                       &engagement),
+              (int)CG_OK);
+    ASSERT_EQ("dry run leaves the stock untouched",
+              cg_stock_volume(stock), before);
+
+    float* heights = nullptr;
+    size_t rx = 0, ry = 0;
+    ASSERT_EQ("cg_stock_heights returns CG_OK",
+              (int)cg_stock_heights(stock, &heights, &rx, &ry), (int)CG_OK);
+    ASSERT_EQ("heights grid is 40x40", rx * ry, size_t{1600});
+    cg_heightmap_free(heights);
+    cg_stock_free(stock);
+}
+
+TEST(stock_api_error_paths) {
+    CgBbox bounds{0, 0, 0, 20, 20, 10};
+    ASSERT_EQ("cg_stock_new with zero cell returns CG_NULL_ID",
+              cg_stock_new(bounds, 0.0), CG_NULL_ID);
+    CgToolDef tool{6.0, 0.0};
+    CgPoint3  pt{0, 0, 0};
+    double    out = 0;
+    ASSERT_EQ("sweep on unknown stock returns CG_ERR_NULL_HANDLE",
+              (int)cg_stock_subtract_sweep(123456, tool, &pt, 1, &out, nullptr),
+              (int)CG_ERR_NULL_HANDLE);
+    CgToolDef bad{-1.0, 0.0};
+    CgStockId stock = cg_stock_new(bounds, 1.0);
+    ASSERT_EQ("negative tool diameter returns CG_ERR_INVALID_ARG",
+              (int)cg_stock_subtract_sweep(stock, bad, &pt, 1, &out, nullptr),
+              (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("cg_stock_volume(unknown) returns -1",
+              cg_stock_volume(123456), -1.0);
+    cg_stock_free(CG_NULL_ID);
+    cg_stock_free(123456);
+    cg_stock_free(stock);
+    pass("cg_stock_free on null/unknown IDs does not crash");
+}
+
+TEST(face_eval_batch_error_paths) {
+    CgPoint3 pts[1];
+    ASSERT_EQ("cg_face_eval_batch with null uv returns CG_ERR_INVALID_ARG",
+              (int)cg_face_eval_batch(123456, nullptr, 1, pts, nullptr,
+                                      nullptr, nullptr),
+              (int)CG_ERR_INVALID_ARG);
+    double uv[2] = {0, 0};
+    ASSERT_EQ("cg_face_eval_batch on null face returns CG_ERR_NULL_HANDLE",
+              (int)cg_face_eval_batch(CG_NULL_ID, uv, 1, pts, nullptr,
+                                      nullptr, nullptr),
+              (int)CG_ERR_NULL_HANDLE);
+}
+
+TEST(worker_thread_budget) {
+    ASSERT_EQ("cg_set_worker_threads(2) accepted",
+              (int)cg_set_worker_threads(2), (int)CG_OK);
+    CgPoolStats s = cg_pool_stats();
+    ASSERT_EQ("configured budget reported", s.configured_threads, size_t{2});
+    ASSERT_EQ("effective threads match the budget",
+              s.effective_threads, size_t{2});
+    ASSERT_EQ("absurd thread count rejected",
+              (int)cg_set_worker_threads(100000), (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("rejection left the budget alone",
+              cg_pool_stats().configured_threads, size_t{2});
+    ASSERT_EQ("cg_set_worker_threads(0) restores auto",
+              (int)cg_set_worker_threads(0), (int)CG_OK);
+    ASSERT_TRUE("auto budget is at least one",
+                cg_pool_stats().effective_threads >= 1);
+}
+
+TEST(shape_distance_error_paths) {
+    ASSERT_EQ("cg_shape_distance with null handles returns -1",
+              cg_shape_distance(CG_NULL_ID, CG_NULL_ID), -1.0);
+    const double xf[12] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0};
+    double dist = 0.0;
+    ASSERT_EQ("cg_shape_distance_batch rejects null arrays",
+              (int)cg_shape_distance_batch(123456, 123457, nullptr, 1, &dist),
+              (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("cg_shape_distance_batch rejects null handles",
+              (int)cg_shape_distance_batch(CG_NULL_ID, 123457, xf, 1, &dist),
+              (int)CG_ERR_NULL_HANDLE);
+}
+
+TEST(perf_instrumentation) {
+    ASSERT_EQ("cg_perf_reset succeeds", (int)cg_perf_reset(), (int)CG_OK);
+
+    const size_t n_subsystems = cg_perf_counters_snapshot(nullptr, 0);
+    ASSERT_TRUE("snapshot(NULL) reports the subsystem count",
+                n_subsystems >= 1);
+
+    // Drive one real instrumented entry point (the stub build links the
+    // real cam_polygon.cpp) and check it lands in the counters.
+    const double square[8] = {0, 0, 10, 0, 10, 10, 0, 10};
+    double* off_pts   = nullptr;
+    size_t  off_count = 0;
+    ASSERT_EQ("offset call succeeds",
+              (int)cg_poly_offset(square, 4, -1.0, 0.01, &off_pts, &off_count),
+              (int)CG_OK);
+    cg_poly_free(off_pts);
+
+    std::vector<CgPerfCounter> counters(n_subsystems);
+    ASSERT_EQ("snapshot fills every subsystem",
+              cg_perf_counters_snapshot(counters.data(), counters.size()),
+              n_subsystems);
+    bool found = false;
+    for (const CgPerfCounter& c : counters) {
+        if (std::strcmp(c.name, "offset") == 0)
+            found = c.calls == 1 && c.total_ns > 0 && c.bytes > 0;
+    }
+    ASSERT_TRUE("offset call counted with time and bytes", found);
+
+    ASSERT_EQ("trace dump rejects null path",
+              (int)cg_perf_trace_dump(nullptr), (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("trace capture enables", (int)cg_perf_trace_enable(1), (int)CG_OK);
+    double* pts2 = nullptr;
+    size_t  cnt2 = 0;
+    cg_poly_offset(square, 4, -1.0, 0.01, &pts2, &cnt2);
+    cg_poly_free(pts2);
+    ASSERT_EQ("trace capture disables", (int)cg_perf_trace_enable(0), (int)CG_OK);
+
+    const char* dump_path = "/tmp/test_cam_geometry_trace.json";
+    ASSERT_EQ("trace dump succeeds",
+              (int)cg_perf_trace_dump(dump_path), (int)CG_OK);
+    std::ifstream dump(dump_path);
+    std::string body((std::istreambuf_iterator<char>(dump)),
+                     std::istreambuf_iterator<char>());
+    std::remove(dump_path);
+    ASSERT_TRUE("dump is chrome trace JSON",
+                body.find("\"traceEvents\"") != std::string::npos);
+    ASSERT_TRUE("dump contains the captured offset event",
+                body.find("\"name\":\"offset\"") != std::string::npos);
+
+    ASSERT_EQ("reset after use succeeds", (int)cg_perf_reset(), (int)CG_OK);
+    cg_perf_counters_snapshot(counters.data(), counters.size());
+    ASSERT_EQ("reset zeroed the counters", counters[0].calls, uint64_t{0});
+}
+
+TEST(mesh_simplify_error_paths) {
+    ASSERT_EQ("cg_mesh_simplify(null) returns CG_NULL_ID",
+              cg_mesh_simplify(CG_NULL_ID, 0.5, 0.0), CG_NULL_ID);
+    ASSERT_EQ("cg_mesh_simplify with ratio > 1 returns CG_NULL_ID",
+              cg_mesh_simplify(123456, 1.5, 0.0), CG_NULL_ID);
+    CgMeshId lods[2];
+    double ratios[2] = {0.5, 0.25};
+    ASSERT_EQ("cg_mesh_build_lods with null outputs returns CG_ERR_INVALID_ARG",
+              (int)cg_mesh_build_lods(123456, ratios, 2, nullptr),
+              (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("cg_mesh_build_lods on null mesh returns CG_ERR_NULL_HANDLE",
+              (int)cg_mesh_build_lods(CG_NULL_ID, ratios, 2, lods),
+              (int)CG_ERR_NULL_HANDLE);
+}
+
+TEST(face_project_points_error_paths) {
+    CgPoint3 p{0, 0, 0};
+    CgPoint2 uv;
+    ASSERT_EQ("cg_face_project_points with null points returns CG_ERR_INVALID_ARG",
+              (int)cg_face_project_points(123456, nullptr, 1, nullptr, &uv,
+                                          nullptr),
+              (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("cg_face_project_points on null face returns CG_ERR_NULL_HANDLE",
+              (int)cg_face_project_points(CG_NULL_ID, &p, 1, nullptr, &uv,
+                                          nullptr),
+              (int)CG_ERR_NULL_HANDLE);
+}
+
 // ---------------------------------------------------------------------------
 // Group 3: Null-handle free operations are no-ops
 // ---------------------------------------------------------------------------
@@ -187,6 +455,17 @@ TEST(shape_heal_stub) {
     ASSERT_EQ("cg_shape_heal stub returns CG_NULL_ID", id, CG_NULL_ID);
 }
 
+TEST(shape_heal_set_level) {
+    ASSERT_EQ("cg_shape_heal_set_level(NONE) returns CG_OK",
+              (int)cg_shape_heal_set_level(CG_HEAL_NONE), (int)CG_OK);
+    ASSERT_EQ("cg_shape_heal_set_level(BASIC) returns CG_OK",
+              (int)cg_shape_heal_set_level(CG_HEAL_BASIC), (int)CG_OK);
+    ASSERT_EQ("cg_shape_heal_set_level(FULL) returns CG_OK",
+              (int)cg_shape_heal_set_level(CG_HEAL_FULL), (int)CG_OK);
+    ASSERT_EQ("cg_shape_heal_set_level(bogus) returns CG_ERR_INVALID_ARG",
+              (int)cg_shape_heal_set_level((CgHealLevel)99), (int)CG_ERR_INVALID_ARG);
+}
+
 TEST(face_surface_type_stub) {
     CgSurfaceType t = cg_face_surface_type(1);
     ASSERT_EQ("cg_face_surface_type stub returns CG_SURF_OTHER", (int)t, (int)CG_SURF_OTHER);
@@ -230,6 +509,16 @@ TEST(find_holes_stub) {
     size_t n = cg_shape_find_holes(1, 1.0, 10.0, &holes);
     ASSERT_EQ("cg_shape_find_holes stub returns 0", n, size_t{0});
     ASSERT_EQ("cg_shape_find_holes stub sets *out to null", holes, (CgHoleInfo*)nullptr);
+
+    n = cg_shape_find_holes(CG_NULL_ID, 1.0, 10.0, &holes);
+    ASSERT_EQ("cg_shape_find_holes null handle returns 0", n, size_t{0});
+    ASSERT_TRUE("cg_shape_find_holes null handle sets an error",
+                cg_last_error_message()[0] != '\0');
+
+    n = cg_shape_find_holes(1, 10.0, 1.0, &holes);
+    ASSERT_EQ("cg_shape_find_holes inverted range returns 0", n, size_t{0});
+    n = cg_shape_find_holes(1, -1.0, 10.0, &holes);
+    ASSERT_EQ("cg_shape_find_holes negative min returns 0", n, size_t{0});
 }
 
 TEST(find_planar_faces_stub) {
@@ -238,25 +527,41 @@ TEST(find_planar_faces_stub) {
     ASSERT_EQ("cg_shape_find_planar_faces stub returns 0", n, size_t{0});
     ASSERT_EQ("cg_shape_find_planar_faces stub sets *out to null",
               faces, (CgPlanarFaceInfo*)nullptr);
+
+    n = cg_shape_find_planar_faces(CG_NULL_ID, &faces);
+    ASSERT_EQ("cg_shape_find_planar_faces null handle returns 0", n, size_t{0});
+    ASSERT_TRUE("cg_shape_find_planar_faces null handle sets an error",
+                cg_last_error_message()[0] != '\0');
 }
 
-TEST(poly_offset_stub) {
-    double pts[] = {0,0, 1,0, 1,1, 0,1};
+TEST(poly_offset_real) {
+    // The real Clipper2-backed implementation links into the stub build, so
+    // a valid outward offset must succeed here.
+    double pts[] = {0,0, 10,0, 10,10, 0,10};
     double* out = nullptr;
-    size_t cnt = 99;
+    size_t cnt = 0;
     CgError e = cg_poly_offset(pts, 4, 1.0, 0.01, &out, &cnt);
-    ASSERT_EQ("cg_poly_offset stub returns CG_ERR_NO_RESULT",
-              (int)e, (int)CG_ERR_NO_RESULT);
-    ASSERT_EQ("cg_poly_offset stub sets *out to null", out, (double*)nullptr);
-    ASSERT_EQ("cg_poly_offset stub sets *cnt to 0", cnt, size_t{0});
+    ASSERT_EQ("cg_poly_offset(square, +1) returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_TRUE("cg_poly_offset(square, +1) yields points", out != nullptr && cnt >= 4);
+    cg_poly_free(out);
+}
+
+TEST(poly_offset_null_args) {
+    double* out = nullptr;
+    size_t cnt = 99;
+    CgError e = cg_poly_offset(nullptr, 4, 1.0, 0.01, &out, &cnt);
+    ASSERT_NE("cg_poly_offset(null points) != CG_OK", (int)e, (int)CG_OK);
+    ASSERT_EQ("cg_poly_offset(null points) sets *out to null", out, (double*)nullptr);
+    ASSERT_EQ("cg_poly_offset(null points) sets *cnt to 0", cnt, size_t{0});
 }
 
-TEST(poly_boolean_stub) {
+TEST(poly_boolean_real) {
     double a[] = {0,0, 1,0, 1,1}; double b[] = {0,0, 2,0, 2,2};
-    double* out = nullptr; size_t cnt = 99;
+    double* out = nullptr; size_t cnt = 0;
     CgError e = cg_poly_boolean(a, 3, b, 3, CG_BOOL_UNION, &out, &cnt);
-    ASSERT_EQ("cg_poly_boolean stub returns CG_ERR_NO_RESULT",
-              (int)e, (int)CG_ERR_NO_RESULT);
+    ASSERT_EQ("cg_poly_boolean(union) returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_TRUE("cg_poly_boolean(union) yields points", out != nullptr && cnt >= 3);
+    cg_poly_free(out);
 }
 
 // ---------------------------------------------------------------------------
@@ -299,6 +604,190 @@ TEST(edge_param_range_valid_outputs) {
     ASSERT_EQ("cg_edge_param_range stub sets tmax=0", tmax, 0.0);
 }
 
+TEST(edge_discretize_error_paths) {
+    CgPoint3* pts = nullptr;
+    double* params = nullptr;
+    size_t count = 99;
+
+    CgError e = cg_edge_discretize(1, 0.01, nullptr, nullptr, &count);
+    ASSERT_EQ("discretize null out_points -> INVALID_ARG",
+              (int)e, (int)CG_ERR_INVALID_ARG);
+    e = cg_edge_discretize(1, 0.0, &pts, &params, &count);
+    ASSERT_EQ("discretize zero chord_tol -> INVALID_ARG",
+              (int)e, (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("discretize error clears count", count, size_t{0});
+    e = cg_edge_discretize(CG_NULL_ID, 0.01, &pts, &params, &count);
+    ASSERT_EQ("discretize null handle -> NULL_HANDLE",
+              (int)e, (int)CG_ERR_NULL_HANDLE);
+
+    size_t* counts = nullptr;
+    const CgEdgeId edges[2] = {1, CG_NULL_ID};
+    e = cg_edge_discretize_batch(nullptr, 2, 0.01, &pts, &params, &counts);
+    ASSERT_EQ("batch null edge array -> INVALID_ARG",
+              (int)e, (int)CG_ERR_INVALID_ARG);
+    e = cg_edge_discretize_batch(edges, 2, 0.01, &pts, &params, &counts);
+    ASSERT_EQ("batch null handle in array -> NULL_HANDLE",
+              (int)e, (int)CG_ERR_NULL_HANDLE);
+    ASSERT_EQ("batch error clears out_points", pts, (CgPoint3*)nullptr);
+
+    cg_params_free(nullptr);
+    pass("cg_params_free(nullptr) does not crash");
+}
+
+// ---------------------------------------------------------------------------
+// Group 9: Zero-copy mesh access null/invalid handling
+// ---------------------------------------------------------------------------
+
+TEST(mesh_map_null_handle) {
+    CgError e = cg_mesh_map(CG_NULL_ID);
+    ASSERT_NE("cg_mesh_map(null) != CG_OK", (int)e, (int)CG_OK);
+    ASSERT_TRUE("cg_mesh_map(null) sets error message",
+                std::string(cg_last_error_message()).size() > 0);
+}
+
+TEST(mesh_unmap_null_handle) {
+    CgError e = cg_mesh_unmap(CG_NULL_ID);
+    ASSERT_NE("cg_mesh_unmap(null) != CG_OK", (int)e, (int)CG_OK);
+}
+
+TEST(mesh_ptrs_null_handle) {
+    ASSERT_EQ("cg_mesh_vertices_ptr(0) == null",
+              cg_mesh_vertices_ptr(CG_NULL_ID), (const double*)nullptr);
+    ASSERT_EQ("cg_mesh_normals_ptr(0) == null",
+              cg_mesh_normals_ptr(CG_NULL_ID), (const double*)nullptr);
+    ASSERT_EQ("cg_mesh_indices_ptr(0) == null",
+              cg_mesh_indices_ptr(CG_NULL_ID), (const uint32_t*)nullptr);
+    ASSERT_EQ("cg_mesh_vertices_ptr_f32(0) == null",
+              cg_mesh_vertices_ptr_f32(CG_NULL_ID), (const float*)nullptr);
+    ASSERT_EQ("cg_mesh_normals_ptr_f32(0) == null",
+              cg_mesh_normals_ptr_f32(CG_NULL_ID), (const float*)nullptr);
+}
+
+// ---------------------------------------------------------------------------
+// Group 10: Mesh precision modes
+// ---------------------------------------------------------------------------
+
+TEST(tessellate_ex_invalid_precision) {
+    CgMeshId id = cg_shape_tessellate_ex(1, 0.1, 0.5, (CgMeshPrecision)99);
+    ASSERT_EQ("cg_shape_tessellate_ex(invalid precision) == CG_NULL_ID", id, CG_NULL_ID);
+    ASSERT_TRUE("cg_shape_tessellate_ex(invalid precision) sets error",
+                std::string(cg_last_error_message()).size() > 0);
+}
+
+TEST(tessellate_welded_ex_invalid_normal_mode) {
+    CgMeshId id = cg_shape_tessellate_welded_ex(1, 0.1, 0.5, CG_MESH_F64, 0.0,
+                                                (CgNormalMode)7);
+    ASSERT_EQ("cg_shape_tessellate_welded_ex(invalid normal mode) == CG_NULL_ID",
+              id, CG_NULL_ID);
+    ASSERT_TRUE("cg_shape_tessellate_welded_ex(invalid normal mode) sets error",
+                std::string(cg_last_error_message()).size() > 0);
+}
+
+TEST(tess_cache_controls) {
+    ASSERT_EQ("cg_tess_cache_set_budget returns CG_OK",
+              (int)cg_tess_cache_set_budget((size_t)1 << 20), (int)CG_OK);
+    size_t entries = 99, bytes = 99;
+    ASSERT_EQ("cg_tess_cache_stats returns CG_OK",
+              (int)cg_tess_cache_stats(&entries, &bytes, nullptr, nullptr),
+              (int)CG_OK);
+    ASSERT_EQ("stub cache reports zero entries", entries, (size_t)0);
+    ASSERT_EQ("stub cache reports zero bytes", bytes, (size_t)0);
+    ASSERT_EQ("cg_tess_cache_stats tolerates all-NULL outputs",
+              (int)cg_tess_cache_stats(nullptr, nullptr, nullptr, nullptr),
+              (int)CG_OK);
+    cg_tess_cache_clear();  // no-op in the stub, must not crash
+}
+
+TEST(mesh_copy_f32_null_handle) {
+    float buf[3] = {0};
+    ASSERT_NE("cg_mesh_copy_vertices_f32(null) != CG_OK",
+              (int)cg_mesh_copy_vertices_f32(CG_NULL_ID, buf), (int)CG_OK);
+    ASSERT_NE("cg_mesh_copy_normals_f32(null) != CG_OK",
+              (int)cg_mesh_copy_normals_f32(CG_NULL_ID, buf), (int)CG_OK);
+}
+
+TEST(snapshot_cache_error_paths) {
+    ASSERT_EQ("cg_cache_save(NULL) rejects the path",
+              (int)cg_cache_save(nullptr), (int)CG_ERR_INVALID_ARG);
+    CgMeshId* ids = (CgMeshId*)0x1;
+    size_t count = 99;
+    ASSERT_EQ("cg_cache_load(NULL path) rejects the arguments",
+              (int)cg_cache_load(nullptr, &ids, &count),
+              (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("cg_cache_load(null outputs) rejects the arguments",
+              (int)cg_cache_load("x.cgcache", nullptr, &count),
+              (int)CG_ERR_INVALID_ARG);
+    CgError rc = cg_cache_load("does_not_exist.cgcache", &ids, &count);
+    ASSERT_NE("cg_cache_load(missing file) != CG_OK", (int)rc, (int)CG_OK);
+    ASSERT_EQ("cg_cache_load failure clears *out_meshes",
+              ids, (CgMeshId*)nullptr);
+    ASSERT_EQ("cg_cache_load failure clears *out_count", count, (size_t)0);
+    cg_mesh_ids_free(nullptr);
+    pass("cg_mesh_ids_free(NULL) does not crash");
+}
+
+TEST(mesh_stream_error_paths) {
+    ASSERT_EQ("cg_mesh_stream_begin(null) == CG_NULL_ID",
+              cg_mesh_stream_begin(CG_NULL_ID, 64), CG_NULL_ID);
+    ASSERT_EQ("cg_mesh_stream_begin(chunk=0) == CG_NULL_ID",
+              cg_mesh_stream_begin(1, 0), CG_NULL_ID);
+    ASSERT_TRUE("cg_mesh_stream_begin(chunk=0) sets error",
+                cg_last_error_message()[0] != '\0');
+
+    float verts[9];
+    uint32_t idx[3];
+    size_t nv = 9, nt = 9;
+    ASSERT_EQ("cg_mesh_stream_next(null outputs) == INVALID_ARG",
+              (int)cg_mesh_stream_next(1, nullptr, nullptr, idx, &nv, &nt),
+              (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("cg_mesh_stream_next(null handle) == NULL_HANDLE",
+              (int)cg_mesh_stream_next(CG_NULL_ID, verts, nullptr, idx,
+                                       &nv, &nt),
+              (int)CG_ERR_NULL_HANDLE);
+    ASSERT_EQ("cg_mesh_stream_next error clears triangle count", nt, size_t{0});
+
+    cg_mesh_stream_free(CG_NULL_ID);
+    pass("cg_mesh_stream_free(CG_NULL_ID) does not crash");
+}
+
+TEST(mesh_precision_null_handle) {
+    ASSERT_EQ("cg_mesh_precision(0) == CG_MESH_F64",
+              (int)cg_mesh_precision(CG_NULL_ID), (int)CG_MESH_F64);
+}
+
+// ---------------------------------------------------------------------------
+// Group 11: Slicer null/invalid handling
+// ---------------------------------------------------------------------------
+
+TEST(slicer_new_null_handle) {
+    CgSlicerId id = cg_slicer_new(CG_NULL_ID);
+    ASSERT_EQ("cg_slicer_new(null) == CG_NULL_ID", id, CG_NULL_ID);
+    ASSERT_TRUE("cg_slicer_new(null) sets error message",
+                std::string(cg_last_error_message()).size() > 0);
+}
+
+TEST(slicer_free_null_is_noop) {
+    cg_slicer_free(CG_NULL_ID);
+    pass("cg_slicer_free(CG_NULL_ID) does not crash");
+}
+
+TEST(slicer_section_multi_z_null_handle) {
+    double zs[] = {0.0, 1.0};
+    CgPoint3* pts = (CgPoint3*)0x1;
+    size_t* counts = (size_t*)0x1;
+    CgError e = cg_slicer_section_multi_z(CG_NULL_ID, zs, 2, 0.01, &pts, &counts);
+    ASSERT_NE("cg_slicer_section_multi_z(null) != CG_OK", (int)e, (int)CG_OK);
+    ASSERT_EQ("cg_slicer_section_multi_z(null) clears out_points",
+              pts, (CgPoint3*)nullptr);
+    ASSERT_EQ("cg_slicer_section_multi_z(null) clears out_level_counts",
+              counts, (size_t*)nullptr);
+}
+
+TEST(level_counts_free_null_is_noop) {
+    cg_level_counts_free(nullptr);
+    pass("cg_level_counts_free(nullptr) does not crash");
+}
+
 // ---------------------------------------------------------------------------
 // Runner
 // ---------------------------------------------------------------------------
@@ -314,6 +803,18 @@ int main() {
     test_load_stl_null_path();
     test_load_step_missing_file();
     test_load_stl_missing_file();
+    test_shape_cache_set_dir_accepts_path_and_null();
+    test_job_api_null_handling();
+    test_bvh_api_error_paths();
+    test_heightmap_api_error_paths();
+    test_stock_block_sweep_real();
+    test_stock_api_error_paths();
+    test_face_eval_batch_error_paths();
+    test_worker_thread_budget();
+    test_shape_distance_error_paths();
+    test_perf_instrumentation();
+    test_mesh_simplify_error_paths();
+    test_face_project_points_error_paths();
 
     // Group 3: Free no-ops
     test_shape_free_null_is_noop();
@@ -335,6 +836,7 @@ int main() {
     // Group 6: Stub error returns
     test_load_iges_stub();
     test_shape_heal_stub();
+    test_shape_heal_set_level();
     test_face_surface_type_stub();
     test_face_plane_stub();
     test_face_cylinder_stub();
@@ -343,8 +845,9 @@ int main() {
     test_shape_section_at_z_stub();
     test_find_holes_stub();
     test_find_planar_faces_stub();
-    test_poly_offset_stub();
-    test_poly_boolean_stub();
+    test_poly_offset_real();
+    test_poly_offset_null_args();
+    test_poly_boolean_real();
 
     // Group 7: Free-null no-ops
     test_section_free_null_is_noop();
@@ -355,6 +858,27 @@ int main() {
     // Group 8: Edge param range
     test_edge_param_range_null_outputs();
     test_edge_param_range_valid_outputs();
+    test_edge_discretize_error_paths();
+
+    // Group 9: Zero-copy mesh access
+    test_mesh_map_null_handle();
+    test_mesh_unmap_null_handle();
+    test_mesh_ptrs_null_handle();
+
+    // Group 10: Mesh precision modes
+    test_tessellate_ex_invalid_precision();
+    test_tessellate_welded_ex_invalid_normal_mode();
+    test_tess_cache_controls();
+    test_mesh_copy_f32_null_handle();
+    test_mesh_stream_error_paths();
+    test_snapshot_cache_error_paths();
+    test_mesh_precision_null_handle();
+
+    // Group 11: Slicer
+    test_slicer_new_null_handle();
+    test_slicer_free_null_is_noop();
+    test_slicer_section_multi_z_null_handle();
+    test_level_counts_free_null_is_noop();
 
     std::cout << "\n=== Results: " << g_pass << " passed, " << g_fail << " failed ===\n";
     return g_fail > 0 ? 1 : 0;
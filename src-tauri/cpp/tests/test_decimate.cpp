@@ -0,0 +1,213 @@
+// test_decimate.cpp
+//
+// Unit tests for the quadric-error-metric decimator in decimate.h.
+//
+// Compiles without OCCT.
+//
+// Build:
+//   g++ -std=c++17 -I.. test_decimate.cpp -o test_decimate
+// Run:
+//   ./test_decimate
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <iostream>
+
+#include "decimate.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define ASSERT_NEAR(label, a, b, tol) \
+    do { if (std::fabs((a) - (b)) <= (tol)) pass(label); \
+         else fail(label, #a " not within " #tol " of " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+// ---------------------------------------------------------------------------
+// Fixtures
+// ---------------------------------------------------------------------------
+
+// A flat n x n vertex grid in the z = 0 plane, fully triangulated.
+static void make_grid(size_t n, std::vector<double>& v,
+                      std::vector<uint32_t>& idx) {
+    v.clear();
+    idx.clear();
+    for (size_t y = 0; y < n; ++y)
+        for (size_t x = 0; x < n; ++x)
+            v.insert(v.end(), {double(x), double(y), 0.0});
+    for (size_t y = 0; y + 1 < n; ++y)
+        for (size_t x = 0; x + 1 < n; ++x) {
+            const uint32_t a = uint32_t(y * n + x);
+            const uint32_t b = a + 1;
+            const uint32_t c = uint32_t((y + 1) * n + x);
+            const uint32_t d = c + 1;
+            idx.insert(idx.end(), {a, b, c, b, d, c});
+        }
+}
+
+// A closed unit cube: 8 corners, 12 triangles, outward winding.
+static void make_cube(std::vector<double>& v, std::vector<uint32_t>& idx) {
+    v = {0,0,0, 1,0,0, 1,1,0, 0,1,0, 0,0,1, 1,0,1, 1,1,1, 0,1,1};
+    idx = {0,2,1, 0,3,2,   // bottom
+           4,5,6, 4,6,7,   // top
+           0,1,5, 0,5,4,   // front
+           2,3,7, 2,7,6,   // back
+           1,2,6, 1,6,5,   // right
+           3,0,4, 3,4,7};  // left
+}
+
+// ---------------------------------------------------------------------------
+// Simplification
+// ---------------------------------------------------------------------------
+
+TEST(flat_grid_collapses_to_target) {
+    std::vector<double> v;
+    std::vector<uint32_t> idx;
+    make_grid(12, v, idx);  // 242 triangles
+
+    const size_t before = idx.size() / 3;
+    const size_t after  = decimate::simplify(v, idx, before / 10);
+    ASSERT_TRUE("triangle count reached the target",
+                after <= before / 10 + 2);
+    ASSERT_EQ("index buffer matches the returned count",
+              idx.size(), after * 3);
+
+    // Every surviving vertex still lies in the z = 0 plane.
+    bool planar = true;
+    for (size_t i = 2; i < v.size(); i += 3)
+        if (std::fabs(v[i]) > 1e-9) planar = false;
+    ASSERT_TRUE("decimated vertices stay on the plane", planar);
+
+    // The boundary constraint keeps the outer square: x/y stay in range.
+    bool inside = true;
+    for (size_t i = 0; i < v.size(); i += 3)
+        if (v[i] < -1e-6 || v[i] > 11.0 + 1e-6 ||
+            v[i+1] < -1e-6 || v[i+1] > 11.0 + 1e-6) inside = false;
+    ASSERT_TRUE("boundary vertices stay on the footprint", inside);
+}
+
+TEST(cube_corners_resist_collapse) {
+    std::vector<double> v;
+    std::vector<uint32_t> idx;
+    make_cube(v, idx);
+
+    // A cube's 12 triangles are all necessary; asking for fewer must not
+    // destroy the shape because every collapse costs a corner.
+    const size_t after = decimate::simplify(v, idx, 4, /*max_error=*/1e-6);
+    ASSERT_EQ("error cap keeps all cube triangles", after, size_t{12});
+}
+
+TEST(max_error_stops_before_target) {
+    std::vector<double> v;
+    std::vector<uint32_t> idx;
+    make_grid(8, v, idx);
+
+    // On a flat grid interior collapses cost ~0, so a tiny error cap still
+    // lets the count fall well below the input.
+    const size_t before = idx.size() / 3;
+    const size_t after  = decimate::simplify(v, idx, 2, 1e-9);
+    ASSERT_TRUE("near-zero-cost collapses proceed under a tight cap",
+                after < before / 2);
+}
+
+TEST(indices_remain_valid) {
+    std::vector<double> v;
+    std::vector<uint32_t> idx;
+    make_grid(10, v, idx);
+    decimate::simplify(v, idx, 20);
+
+    const uint32_t nv = uint32_t(v.size() / 3);
+    bool ok = true;
+    for (size_t t = 0; t < idx.size(); t += 3) {
+        if (idx[t] >= nv || idx[t+1] >= nv || idx[t+2] >= nv) ok = false;
+        if (idx[t] == idx[t+1] || idx[t+1] == idx[t+2] ||
+            idx[t] == idx[t+2]) ok = false;
+    }
+    ASSERT_TRUE("all indices in range and no degenerate triangles", ok);
+}
+
+TEST(float_meshes_decimate_too) {
+    std::vector<double> vd;
+    std::vector<uint32_t> idx;
+    make_grid(8, vd, idx);
+    std::vector<float> v(vd.begin(), vd.end());
+    const size_t after = decimate::simplify(v, idx, 10);
+    ASSERT_TRUE("f32 grid reaches the target", after <= 12);
+}
+
+TEST(already_small_mesh_is_untouched) {
+    std::vector<double> v;
+    std::vector<uint32_t> idx;
+    make_cube(v, idx);
+    const std::vector<uint32_t> orig = idx;
+    ASSERT_EQ("target above current count is a no-op",
+              decimate::simplify(v, idx, 100), size_t{12});
+    ASSERT_TRUE("index buffer unchanged", idx == orig);
+}
+
+// ---------------------------------------------------------------------------
+// Normal recomputation
+// ---------------------------------------------------------------------------
+
+TEST(recomputed_normals_are_unit_and_outward) {
+    std::vector<double> v, normals;
+    std::vector<uint32_t> idx;
+    make_cube(v, idx);
+    decimate::recompute_normals(v, idx, normals);
+
+    ASSERT_EQ("one normal per vertex", normals.size(), v.size());
+    bool unit = true, outward = true;
+    for (size_t i = 0; i < normals.size() / 3; ++i) {
+        const double x = normals[i*3], y = normals[i*3+1], z = normals[i*3+2];
+        if (std::fabs(std::sqrt(x*x + y*y + z*z) - 1.0) > 1e-9) unit = false;
+        // Corner normals point away from the cube centre (0.5, 0.5, 0.5).
+        const double dx = v[i*3] - 0.5, dy = v[i*3+1] - 0.5, dz = v[i*3+2] - 0.5;
+        if (x * dx + y * dy + z * dz <= 0.0) outward = false;
+    }
+    ASSERT_TRUE("normals are unit length", unit);
+    ASSERT_TRUE("corner normals point outward", outward);
+}
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "test_decimate\n";
+
+    test_flat_grid_collapses_to_target();
+    test_cube_corners_resist_collapse();
+    test_max_error_stops_before_target();
+    test_indices_remain_valid();
+    test_float_meshes_decimate_too();
+    test_already_small_mesh_is_untouched();
+    test_recomputed_normals_are_unit_and_outward();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
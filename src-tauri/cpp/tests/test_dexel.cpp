@@ -0,0 +1,238 @@
+// test_dexel.cpp
+//
+// Unit tests for the Z-dexel stock model in dexel.h.
+//
+// Compiles without OCCT.
+//
+// Build:
+//   g++ -std=c++17 -I.. -pthread test_dexel.cpp -o test_dexel
+// Run:
+//   ./test_dexel
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <iostream>
+
+#include "dexel.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define ASSERT_NEAR(label, a, b, tol) \
+    do { if (std::fabs((a) - (b)) <= (tol)) pass(label); \
+         else fail(label, #a " not within " #tol " of " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+static const double kPi = 3.14159265358979323846;
+
+// 100 x 100 x 20 mm block at 0.5 mm cells.
+static DexelStock make_block() {
+    DexelStock s;
+    s.build_block(0, 0, 0, 100, 100, 20, 0.5);
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Construction and volume
+// ---------------------------------------------------------------------------
+
+TEST(block_volume) {
+    DexelStock s = make_block();
+    ASSERT_EQ("grid is 200 x 200 columns", s.res_x(), size_t{200});
+    ASSERT_NEAR("block volume is 100*100*20", s.volume(), 200000.0, 1e-6);
+}
+
+TEST(build_from_heights) {
+    // Half the columns at z = 10, half with no material.
+    const size_t n = 10;
+    std::vector<float> h(n * n, -std::numeric_limits<float>::infinity());
+    for (size_t iy = 0; iy < n; ++iy)
+        for (size_t ix = 0; ix < n / 2; ++ix) h[iy * n + ix] = 10.0f;
+    DexelStock s;
+    s.build_from_heights(0, 0, 0, 10, 10, 1.0, h.data());
+    ASSERT_NEAR("heightmap stock volume is 5*10*10", s.volume(), 500.0, 1e-9);
+}
+
+// ---------------------------------------------------------------------------
+// Material removal
+// ---------------------------------------------------------------------------
+
+TEST(plunge_removes_cylinder) {
+    DexelStock s = make_block();
+    DexelStock::Tool flat{5.0, 0.0};  // 10 mm flat endmill
+
+    // One plunge in the middle of the block down to z = 15.
+    double pt[3] = {50, 50, 15};
+    double removed = 0;
+    s.subtract_sweep(flat, pt, 1, &removed, nullptr);
+
+    const double expect = kPi * 5.0 * 5.0 * 5.0;  // pi r^2 * depth
+    ASSERT_NEAR("removed volume is the cylinder (2% grid tolerance)",
+                removed, expect, 0.02 * expect);
+    ASSERT_NEAR("stock volume dropped by the same amount",
+                200000.0 - s.volume(), removed, 1e-6);
+}
+
+TEST(repeat_pass_removes_nothing) {
+    DexelStock s = make_block();
+    DexelStock::Tool flat{5.0, 0.0};
+    double pt[3] = {50, 50, 15};
+    double removed = 0;
+    s.subtract_sweep(flat, pt, 1, &removed, nullptr);
+    ASSERT_TRUE("first plunge removes material", removed > 0.0);
+    s.subtract_sweep(flat, pt, 1, &removed, nullptr);
+    ASSERT_EQ("second identical plunge removes nothing", removed, 0.0);
+}
+
+TEST(linear_sweep_cuts_slot) {
+    DexelStock s = make_block();
+    DexelStock::Tool flat{5.0, 0.0};
+
+    // A straight pass across the full block at z = 15, 1 mm steps.
+    std::vector<double> pts;
+    const size_t n = 121;
+    for (size_t i = 0; i < n; ++i)
+        pts.insert(pts.end(), {-10.0 + double(i), 50.0, 15.0});
+    std::vector<double> removed(n);
+    s.subtract_sweep(flat, pts.data(), n, removed.data(), nullptr);
+
+    // Slot 10 wide x 5 deep x 100 long, plus nothing outside the block.
+    double total = 0;
+    for (double r : removed) total += r;
+    ASSERT_NEAR("slot volume (2% tolerance)", total, 5000.0, 100.0);
+
+    // The ends of the path are off the stock entirely.
+    ASSERT_EQ("off-stock points remove nothing", removed.front(), 0.0);
+    ASSERT_EQ("off-stock points remove nothing (far end)", removed.back(), 0.0);
+}
+
+TEST(ball_nose_leaves_scallop) {
+    DexelStock s = make_block();
+    DexelStock::Tool ball{5.0, 5.0};  // 10 mm ball nose
+
+    // Tip at z = 15: the sphere centre sits at z = 20, so directly under
+    // the axis the floor is 15 but at the rim it rises to 20.
+    double pt[3] = {50, 50, 15};
+    s.subtract_sweep(ball, pt, 1, nullptr, nullptr);
+
+    const auto& tops = s.tops();
+    const size_t res = s.res_x();
+    // Column under the axis (cell centre 50.25, r = 0.35): z ≈ 15.
+    const size_t centre = (50 * 2) * res + (50 * 2);
+    ASSERT_NEAR("floor under the tip follows the ball",
+                tops[centre], 15.0, 0.05);
+    // Column whose centre (54.25, 50.25) sits r off-axis: z = 20 - sqrt(25 - r^2).
+    const size_t off = (50 * 2) * res + (54 * 2);
+    const double r2 = 4.25 * 4.25 + 0.25 * 0.25;
+    ASSERT_NEAR("floor off-axis follows the sphere",
+                tops[off], 20.0 - std::sqrt(25.0 - r2), 1e-9);
+}
+
+// ---------------------------------------------------------------------------
+// Engagement
+// ---------------------------------------------------------------------------
+
+TEST(engagement_full_and_half) {
+    DexelStock s = make_block();
+    DexelStock::Tool flat{5.0, 0.0};
+
+    // First point: fully buried plunge -> engagement 2*pi.
+    // Then re-cut the same spot: engagement 0.
+    // Then step over by one radius: roughly half the rim is buried.
+    std::vector<double> pts = {
+        50, 50, 15,
+        50, 50, 15,
+        55, 50, 15,
+    };
+    std::vector<double> engagement(3);
+    s.subtract_sweep(flat, pts.data(), 3, nullptr, engagement.data());
+
+    ASSERT_NEAR("buried plunge reads 2*pi", engagement[0], 2 * kPi, 0.01);
+    ASSERT_NEAR("repeat cut reads 0", engagement[1], 0.0, 1e-12);
+    ASSERT_TRUE("half step-over reads roughly half the rim",
+                engagement[2] > 0.3 * 2 * kPi && engagement[2] < 0.7 * 2 * kPi);
+}
+
+TEST(engagement_outside_stock_is_zero) {
+    DexelStock s = make_block();
+    DexelStock::Tool flat{5.0, 0.0};
+    double pt[3] = {200, 200, 15};
+    double engagement = -1, removed = -1;
+    s.subtract_sweep(flat, pt, 1, &removed, &engagement);
+    ASSERT_EQ("no removal off the stock", removed, 0.0);
+    ASSERT_EQ("no engagement off the stock", engagement, 0.0);
+}
+
+// ---------------------------------------------------------------------------
+// Parallel consistency
+// ---------------------------------------------------------------------------
+
+TEST(worker_counts_agree) {
+    DexelStock a = make_block(), b = make_block();
+    DexelStock::Tool bull{6.0, 1.0};
+
+    // A zig-zag pass with varying depth.
+    std::vector<double> pts;
+    for (int i = 0; i < 200; ++i)
+        pts.insert(pts.end(),
+                   {5.0 + 0.45 * i, 50.0 + 20.0 * std::sin(0.1 * i),
+                    16.0 - 0.01 * i});
+    const size_t n = pts.size() / 3;
+    std::vector<double> rem1(n), rem8(n), eng1(n), eng8(n);
+    a.subtract_sweep(bull, pts.data(), n, rem1.data(), eng1.data(), 1);
+    b.subtract_sweep(bull, pts.data(), n, rem8.data(), eng8.data(), 8);
+
+    ASSERT_TRUE("1- and 8-worker grids are identical", a.tops() == b.tops());
+    bool same = true;
+    for (size_t i = 0; i < n; ++i)
+        if (std::fabs(rem1[i] - rem8[i]) > 1e-9 ||
+            std::fabs(eng1[i] - eng8[i]) > 1e-12) same = false;
+    ASSERT_TRUE("per-point outputs are identical across worker counts", same);
+}
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "test_dexel\n";
+
+    test_block_volume();
+    test_build_from_heights();
+    test_plunge_removes_cylinder();
+    test_repeat_pass_removes_nothing();
+    test_linear_sweep_cuts_slot();
+    test_ball_nose_leaves_scallop();
+    test_engagement_full_and_half();
+    test_engagement_outside_stock_is_zero();
+    test_worker_counts_agree();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+// test_geom_cache.cpp
+//
+// Unit tests for the geometry snapshot file format in geom_cache.h: offset
+// planning and the validation that guards cg_cache_load against truncated,
+// corrupt, or hostile files.
+//
+// Compiles without OCCT.
+//
+// Build:
+//   g++ -std=c++17 -I.. test_geom_cache.cpp -o test_geom_cache
+// Run:
+//   ./test_geom_cache
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <iostream>
+
+#include "geom_cache.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_slot_map.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+// Build an in-memory snapshot with the given per-mesh (n_vertices, n_indices)
+// counts, all f64, payload bytes zeroed.
+static std::vector<uint8_t> make_snapshot(
+    const std::vector<std::pair<uint64_t, uint64_t>>& meshes) {
+    std::vector<geom_cache::MeshRecord> records(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        records[i].precision    = 0;  // CG_MESH_F64
+        records[i].scalar_bytes = 8;
+        records[i].n_vertices   = meshes[i].first;
+        records[i].n_indices    = meshes[i].second;
+    }
+    const size_t total = geom_cache::plan_offsets(records);
+    std::vector<uint8_t> file(total, 0);
+    geom_cache::FileHeader hdr{};
+    std::memcpy(hdr.magic, geom_cache::kMagic, sizeof(hdr.magic));
+    hdr.version  = geom_cache::kVersion;
+    hdr.n_meshes = uint32_t(records.size());
+    std::memcpy(file.data(), &hdr, sizeof(hdr));
+    std::memcpy(file.data() + sizeof(hdr), records.data(),
+                records.size() * sizeof(geom_cache::MeshRecord));
+    return file;
+}
+
+static geom_cache::MeshRecord* record_at(std::vector<uint8_t>& file, size_t i) {
+    return reinterpret_cast<geom_cache::MeshRecord*>(
+        file.data() + sizeof(geom_cache::FileHeader) +
+        i * sizeof(geom_cache::MeshRecord));
+}
+
+// ---------------------------------------------------------------------------
+// Offset planning
+// ---------------------------------------------------------------------------
+
+TEST(plan_aligns_every_section) {
+    std::vector<geom_cache::MeshRecord> records(3);
+    for (size_t i = 0; i < records.size(); ++i) {
+        records[i].scalar_bytes = (i == 1) ? 4 : 8;
+        records[i].n_vertices   = 7 + i;   // odd sizes force padding
+        records[i].n_indices    = 9 + 3 * i;
+    }
+    const size_t total = geom_cache::plan_offsets(records);
+
+    bool aligned = true;
+    bool ordered = true;
+    uint64_t prev_end = sizeof(geom_cache::FileHeader) +
+                        records.size() * sizeof(geom_cache::MeshRecord);
+    for (const auto& r : records) {
+        const uint64_t vb = r.n_vertices * 3 * r.scalar_bytes;
+        const uint64_t sections[3][2] = {{r.vertices_offset, vb},
+                                         {r.normals_offset, vb},
+                                         {r.indices_offset, r.n_indices * 4}};
+        for (const auto& s : sections) {
+            if (s[0] % geom_cache::kAlign != 0) aligned = false;
+            if (s[0] < prev_end) ordered = false;
+            prev_end = s[0] + s[1];
+        }
+    }
+    ASSERT_TRUE("every section offset is kAlign-aligned", aligned);
+    ASSERT_TRUE("sections are laid out in order without overlap", ordered);
+    ASSERT_TRUE("total covers the last section", total == prev_end);
+}
+
+TEST(plan_empty_store_is_header_only) {
+    std::vector<geom_cache::MeshRecord> records;
+    ASSERT_EQ("empty plan is just the header",
+              geom_cache::plan_offsets(records),
+              sizeof(geom_cache::FileHeader));
+}
+
+// ---------------------------------------------------------------------------
+// Validation
+// ---------------------------------------------------------------------------
+
+TEST(validate_accepts_well_formed_file) {
+    auto file = make_snapshot({{8, 36}, {100, 300}});
+    std::vector<geom_cache::MeshRecord> records;
+    ASSERT_TRUE("well-formed snapshot validates",
+                geom_cache::validate(file.data(), file.size(), records));
+    ASSERT_EQ("record count round-trips", records.size(), size_t{2});
+    ASSERT_EQ("counts round-trip", records[1].n_vertices, uint64_t{100});
+}
+
+TEST(validate_accepts_empty_snapshot) {
+    auto file = make_snapshot({});
+    std::vector<geom_cache::MeshRecord> records;
+    ASSERT_TRUE("empty snapshot validates",
+                geom_cache::validate(file.data(), file.size(), records));
+    ASSERT_EQ("empty snapshot has no records", records.size(), size_t{0});
+}
+
+TEST(validate_rejects_bad_magic_and_version) {
+    auto file = make_snapshot({{8, 36}});
+    std::vector<geom_cache::MeshRecord> records;
+    auto bad_magic = file;
+    bad_magic[0] ^= 0xff;
+    ASSERT_TRUE("corrupt magic is rejected",
+                !geom_cache::validate(bad_magic.data(), bad_magic.size(),
+                                      records));
+    auto bad_version = file;
+    bad_version[8] = 99;  // version field follows the 8-byte magic
+    ASSERT_TRUE("unknown version is rejected",
+                !geom_cache::validate(bad_version.data(), bad_version.size(),
+                                      records));
+}
+
+TEST(validate_rejects_truncation) {
+    auto file = make_snapshot({{8, 36}});
+    std::vector<geom_cache::MeshRecord> records;
+    ASSERT_TRUE("file cut inside the payload is rejected",
+                !geom_cache::validate(file.data(), file.size() - 1, records));
+    ASSERT_TRUE("file cut inside the records is rejected",
+                !geom_cache::validate(file.data(),
+                                      sizeof(geom_cache::FileHeader) + 4,
+                                      records));
+    ASSERT_TRUE("file shorter than the header is rejected",
+                !geom_cache::validate(file.data(), 8, records));
+    ASSERT_TRUE("null data is rejected",
+                !geom_cache::validate(nullptr, file.size(), records));
+}
+
+TEST(validate_rejects_corrupt_records) {
+    std::vector<geom_cache::MeshRecord> records;
+    {
+        auto file = make_snapshot({{8, 36}});
+        record_at(file, 0)->vertices_offset += 4;  // misaligned
+        ASSERT_TRUE("misaligned section offset is rejected",
+                    !geom_cache::validate(file.data(), file.size(), records));
+    }
+    {
+        auto file = make_snapshot({{8, 36}});
+        record_at(file, 0)->scalar_bytes = 2;
+        ASSERT_TRUE("unknown scalar size is rejected",
+                    !geom_cache::validate(file.data(), file.size(), records));
+    }
+    {
+        auto file = make_snapshot({{8, 36}});
+        record_at(file, 0)->n_vertices = ~uint64_t{0};  // would overflow
+        ASSERT_TRUE("absurd vertex count is rejected",
+                    !geom_cache::validate(file.data(), file.size(), records));
+    }
+    {
+        auto file = make_snapshot({{8, 36}});
+        record_at(file, 0)->indices_offset =
+            geom_cache::align_up(file.size());  // points past the file
+        ASSERT_TRUE("section past end-of-file is rejected",
+                    !geom_cache::validate(file.data(), file.size(), records));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Runner
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "=== geom_cache unit tests ===\n";
+
+    std::cout << "\n-- offset planning --\n";
+    test_plan_aligns_every_section();
+    test_plan_empty_store_is_header_only();
+
+    std::cout << "\n-- validation --\n";
+    test_validate_accepts_well_formed_file();
+    test_validate_accepts_empty_snapshot();
+    test_validate_rejects_bad_magic_and_version();
+    test_validate_rejects_truncation();
+    test_validate_rejects_corrupt_records();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
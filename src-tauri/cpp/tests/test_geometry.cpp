@@ -20,8 +20,13 @@
 
 #include "cam_geometry.h"
 
+#include <chrono>
+#include <cmath>
 #include <cstring>
+#include <filesystem>
 #include <string>
+#include <thread>
+#include <vector>
 
 // ---------------------------------------------------------------------------
 // Helpers
@@ -63,6 +68,89 @@ TEST_CASE("load STEP with non-existent path returns CG_NULL_ID and sets error")
     CHECK(last_error().size() > 0);
 }
 
+TEST_CASE("binary shape cache speeds re-open and matches the direct import") {
+    namespace fs = std::filesystem;
+
+    // Point the cache at a fresh temp directory.
+    fs::path cache_dir =
+        fs::temp_directory_path() / "jamiecam_shape_cache_test";
+    fs::remove_all(cache_dir);
+    REQUIRE(fs::create_directory(cache_dir));
+    REQUIRE(cg_shape_cache_set_dir(cache_dir.string().c_str()) == CG_OK);
+
+    // First load populates the sidecar.
+    CgShapeId first = cg_load_step(STEP_PATH);
+    INFO("last error: " << last_error());
+    REQUIRE(first != CG_NULL_ID);
+    CgBbox bb_first = cg_shape_bounding_box(first);
+
+    // Exactly one .bbrep sidecar must now exist.
+    int sidecars = 0;
+    for (const auto& entry : fs::directory_iterator(cache_dir))
+        if (entry.path().extension() == ".bbrep") ++sidecars;
+    CHECK(sidecars == 1);
+
+    // Second load takes the cache path and yields the same geometry.
+    CgShapeId second = cg_load_step(STEP_PATH);
+    REQUIRE(second != CG_NULL_ID);
+    CgBbox bb_second = cg_shape_bounding_box(second);
+    CHECK(bb_second.xmax - bb_second.xmin ==
+          doctest::Approx(bb_first.xmax - bb_first.xmin));
+    CHECK(bb_second.zmax - bb_second.zmin ==
+          doctest::Approx(bb_first.zmax - bb_first.zmin));
+
+    cg_shape_free(first);
+    cg_shape_free(second);
+    REQUIRE(cg_shape_cache_set_dir(nullptr) == CG_OK);
+    fs::remove_all(cache_dir);
+}
+
+TEST_CASE("async STEP import completes and yields a valid shape") {
+    CgJobId job = cg_load_step_async(STEP_PATH);
+    REQUIRE(job != CG_NULL_ID);
+
+    // Poll to completion (the fixture is tiny, but be generous).
+    CgJobStatus status = CG_JOB_RUNNING;
+    for (int i = 0; i < 3000 && status == CG_JOB_RUNNING; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        status = cg_job_status(job);
+    }
+    INFO("last error: " << last_error());
+    REQUIRE(status == CG_JOB_DONE);
+    CHECK(cg_job_progress(job) == doctest::Approx(1.0));
+
+    CgShapeId shape = cg_job_shape(job);
+    REQUIRE(shape != CG_NULL_ID);
+    CgBbox bb = cg_shape_bounding_box(shape);
+    CHECK(bb.xmax - bb.xmin == doctest::Approx(10.0).epsilon(0.01));
+
+    cg_shape_free(shape);
+    cg_job_free(job);
+}
+
+TEST_CASE("async import of a missing file fails with an error message") {
+    CgJobId job = cg_load_step_async("/nonexistent/path/missing.step");
+    REQUIRE(job != CG_NULL_ID);
+    CgJobStatus status = CG_JOB_RUNNING;
+    for (int i = 0; i < 3000 && status == CG_JOB_RUNNING; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        status = cg_job_status(job);
+    }
+    CHECK(status == CG_JOB_FAILED);
+    CHECK(cg_job_shape(job) == CG_NULL_ID);
+    CHECK(last_error().size() > 0);
+    cg_job_free(job);
+}
+
+TEST_CASE("cancelled or completed job is safe to free while in flight") {
+    CgJobId job = cg_load_step_async(STEP_PATH);
+    REQUIRE(job != CG_NULL_ID);
+    CHECK(cg_job_cancel(job) == CG_OK);
+    // Free immediately: joins the worker and releases an untaken shape.
+    cg_job_free(job);
+    CHECK(cg_job_status(job) == CG_JOB_FAILED);  // unknown ID after free
+}
+
 } // TEST_SUITE step_loading
 
 // ---------------------------------------------------------------------------
@@ -90,6 +178,44 @@ TEST_CASE("load STL with non-existent path returns CG_NULL_ID and sets error") {
     CHECK(last_error().size() > 0);
 }
 
+TEST_CASE("fast binary path matches the expected box geometry") {
+    // box.stl is binary, so this exercises the memory-mapped parser.
+    CgMeshId plain = cg_load_stl(STL_PATH);
+    REQUIRE(plain != CG_NULL_ID);
+    CHECK(cg_mesh_triangle_count(plain) == 12);
+    CHECK(cg_mesh_vertex_count(plain) == 36); // unshared, 3 per triangle
+
+    CgBbox bb{0, 0, 0, 0, 0, 0};
+    size_t nv = cg_mesh_vertex_count(plain);
+    std::vector<double> v(nv * 3);
+    REQUIRE(cg_mesh_copy_vertices(plain, v.data()) == CG_OK);
+    for (size_t i = 0; i < nv; ++i) {
+        bb.xmax = std::max(bb.xmax, v[i * 3]);
+        bb.ymax = std::max(bb.ymax, v[i * 3 + 1]);
+        bb.zmax = std::max(bb.zmax, v[i * 3 + 2]);
+    }
+    CHECK(bb.xmax == doctest::Approx(10.0));
+    CHECK(bb.ymax == doctest::Approx(10.0));
+    CHECK(bb.zmax == doctest::Approx(10.0));
+
+    // Welding collapses the box to its 8 corners; f32 works the same.
+    CgMeshId welded = cg_load_stl_ex(STL_PATH, CG_MESH_F64, 1e-6);
+    REQUIRE(welded != CG_NULL_ID);
+    CHECK(cg_mesh_vertex_count(welded) == 8);
+    CHECK(cg_mesh_triangle_count(welded) == 12);
+
+    CgMeshId welded32 = cg_load_stl_ex(STL_PATH, CG_MESH_F32, 1e-6);
+    REQUIRE(welded32 != CG_NULL_ID);
+    CHECK(cg_mesh_precision(welded32) == CG_MESH_F32);
+    CHECK(cg_mesh_vertex_count(welded32) == 8);
+
+    CHECK(cg_load_stl_ex(STL_PATH, (CgMeshPrecision)7, 0.0) == CG_NULL_ID);
+
+    cg_mesh_free(plain);
+    cg_mesh_free(welded);
+    cg_mesh_free(welded32);
+}
+
 } // TEST_SUITE stl_loading
 
 // ---------------------------------------------------------------------------
@@ -138,8 +264,641 @@ TEST_CASE("tessellate with null handle returns CG_NULL_ID and sets error") {
     CHECK(last_error().size() > 0);
 }
 
+TEST_CASE("parallel mesh assembly is deterministic across runs") {
+    // Faces are written at precomputed offsets, so the merged buffers must be
+    // byte-identical regardless of how the fill pass is scheduled.
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgMeshId a = cg_shape_tessellate(shape, 0.1, 0.5);
+    CgMeshId b = cg_shape_tessellate(shape, 0.1, 0.5);
+    REQUIRE(a != CG_NULL_ID);
+    REQUIRE(b != CG_NULL_ID);
+
+    size_t nv = cg_mesh_vertex_count(a);
+    size_t nt = cg_mesh_triangle_count(a);
+    REQUIRE(cg_mesh_vertex_count(b)   == nv);
+    REQUIRE(cg_mesh_triangle_count(b) == nt);
+
+    const double*   va = cg_mesh_vertices_ptr(a);
+    const double*   vb = cg_mesh_vertices_ptr(b);
+    const uint32_t* ia = cg_mesh_indices_ptr(a);
+    const uint32_t* ib = cg_mesh_indices_ptr(b);
+    REQUIRE(va != nullptr);
+    REQUIRE(ia != nullptr);
+    CHECK(std::memcmp(va, vb, nv * 3 * sizeof(double))   == 0);
+    CHECK(std::memcmp(ia, ib, nt * 3 * sizeof(uint32_t)) == 0);
+
+    cg_mesh_free(a);
+    cg_mesh_free(b);
+    cg_shape_free(shape);
+}
+
+TEST_CASE("float32 tessellation matches the double mesh within f32 precision") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgMeshId mesh64 = cg_shape_tessellate_ex(shape, 0.1, 0.5, CG_MESH_F64);
+    CgMeshId mesh32 = cg_shape_tessellate_ex(shape, 0.1, 0.5, CG_MESH_F32);
+    REQUIRE(mesh64 != CG_NULL_ID);
+    REQUIRE(mesh32 != CG_NULL_ID);
+
+    CHECK(cg_mesh_precision(mesh64) == CG_MESH_F64);
+    CHECK(cg_mesh_precision(mesh32) == CG_MESH_F32);
+
+    size_t nv = cg_mesh_vertex_count(mesh64);
+    size_t nt = cg_mesh_triangle_count(mesh64);
+    CHECK(cg_mesh_vertex_count(mesh32)   == nv);
+    CHECK(cg_mesh_triangle_count(mesh32) == nt);
+
+    std::vector<double> v64(nv * 3);
+    std::vector<float>  v32(nv * 3);
+    REQUIRE(cg_mesh_copy_vertices(mesh64, v64.data())      == CG_OK);
+    REQUIRE(cg_mesh_copy_vertices_f32(mesh32, v32.data())  == CG_OK);
+    for (size_t i = 0; i < nv * 3; ++i) {
+        CHECK(v32[i] == doctest::Approx(v64[i]).epsilon(1e-5));
+    }
+
+    // Zero-copy pointers are precision-gated, never converting.
+    CHECK(cg_mesh_vertices_ptr(mesh32)     == nullptr);
+    CHECK(cg_mesh_vertices_ptr_f32(mesh32) != nullptr);
+    CHECK(cg_mesh_vertices_ptr_f32(mesh64) == nullptr);
+
+    cg_mesh_free(mesh64);
+    cg_mesh_free(mesh32);
+    cg_shape_free(shape);
+}
+
+TEST_CASE("f32 copy accessors narrow from a double mesh") {
+    CgMeshId mesh = cg_load_stl(STL_PATH);
+    REQUIRE(mesh != CG_NULL_ID);
+
+    size_t nv = cg_mesh_vertex_count(mesh);
+    REQUIRE(nv > 0);
+
+    std::vector<double> v64(nv * 3);
+    std::vector<float>  v32(nv * 3);
+    REQUIRE(cg_mesh_copy_vertices(mesh, v64.data())     == CG_OK);
+    REQUIRE(cg_mesh_copy_vertices_f32(mesh, v32.data()) == CG_OK);
+    for (size_t i = 0; i < nv * 3; ++i) {
+        CHECK(v32[i] == static_cast<float>(v64[i]));
+    }
+
+    cg_mesh_free(mesh);
+}
+
+TEST_CASE("welded tessellation deduplicates face-seam vertices") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgMeshId plain  = cg_shape_tessellate(shape, 0.1, 0.5);
+    CgMeshId welded = cg_shape_tessellate_welded(shape, 0.1, 0.5,
+                                                 CG_MESH_F64, 1e-6);
+    REQUIRE(plain != CG_NULL_ID);
+    REQUIRE(welded != CG_NULL_ID);
+
+    // Each box corner appears on three faces unwelded but once welded.
+    CHECK(cg_mesh_vertex_count(welded) < cg_mesh_vertex_count(plain));
+    CHECK(cg_mesh_vertex_count(welded) == 8);
+    CHECK(cg_mesh_triangle_count(welded) == cg_mesh_triangle_count(plain));
+
+    // Welded corner normals merged the three faces' contributions and
+    // renormalized.
+    size_t nv = cg_mesh_vertex_count(welded);
+    std::vector<double> normals(nv * 3);
+    REQUIRE(cg_mesh_copy_normals(welded, normals.data()) == CG_OK);
+    for (size_t i = 0; i < nv; ++i) {
+        double len = std::sqrt(normals[i*3]*normals[i*3] +
+                               normals[i*3+1]*normals[i*3+1] +
+                               normals[i*3+2]*normals[i*3+2]);
+        CHECK(len == doctest::Approx(1.0));
+    }
+
+    // weld_tol == 0 keeps the unwelded layout for per-face attribution.
+    CgMeshId unwelded = cg_shape_tessellate_welded(shape, 0.1, 0.5,
+                                                   CG_MESH_F64, 0.0);
+    REQUIRE(unwelded != CG_NULL_ID);
+    CHECK(cg_mesh_vertex_count(unwelded) == cg_mesh_vertex_count(plain));
+
+    cg_mesh_free(plain);
+    cg_mesh_free(welded);
+    cg_mesh_free(unwelded);
+    cg_shape_free(shape);
+}
+
+TEST_CASE("lazy normals materialize on first access and match the eager build") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgMeshId lazy  = cg_shape_tessellate_welded_ex(shape, 0.1, 0.5,
+                                                   CG_MESH_F64, 1e-6,
+                                                   CG_NORMALS_LAZY);
+    CgMeshId eager = cg_shape_tessellate_welded_ex(shape, 0.1, 0.5,
+                                                   CG_MESH_F64, 1e-6,
+                                                   CG_NORMALS_EAGER);
+    REQUIRE(lazy != CG_NULL_ID);
+    REQUIRE(eager != CG_NULL_ID);
+
+    const size_t nv = cg_mesh_vertex_count(lazy);
+    REQUIRE(nv == cg_mesh_vertex_count(eager));
+
+    // Deferred build lands on the same smooth normals the eager path
+    // accumulates during assembly, and repeat reads see the cached buffer.
+    std::vector<double> n_lazy(nv * 3), n_eager(nv * 3);
+    REQUIRE(cg_mesh_copy_normals(lazy, n_lazy.data()) == CG_OK);
+    REQUIRE(cg_mesh_copy_normals(eager, n_eager.data()) == CG_OK);
+    for (size_t i = 0; i < nv * 3; ++i)
+        CHECK(n_lazy[i] == doctest::Approx(n_eager[i]).epsilon(1e-9));
+
+    const double* ptr1 = cg_mesh_normals_ptr(lazy);
+    const double* ptr2 = cg_mesh_normals_ptr(lazy);
+    REQUIRE(ptr1 != nullptr);
+    CHECK(ptr1 == ptr2);
+
+    cg_mesh_free(lazy);
+    cg_mesh_free(eager);
+    cg_shape_free(shape);
+}
+
+TEST_CASE("fragment cache hits on repeat tessellation and obeys its budget") {
+    cg_tess_cache_clear();
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    // Cold build: every face probe misses, six fragments become resident.
+    CgMeshId first = cg_shape_tessellate_welded(shape, 0.1, 0.5,
+                                                CG_MESH_F64, 1e-6);
+    REQUIRE(first != CG_NULL_ID);
+    size_t entries = 0, bytes = 0;
+    uint64_t hits = 0, misses = 0;
+    REQUIRE(cg_tess_cache_stats(&entries, &bytes, &hits, &misses) == CG_OK);
+    CHECK(entries == 6);
+    CHECK(bytes > 0);
+    CHECK(misses == 6);
+    CHECK(hits == 0);
+
+    // Warm build at the same tolerances: all probes hit, identical mesh.
+    CgMeshId second = cg_shape_tessellate_welded(shape, 0.1, 0.5,
+                                                 CG_MESH_F64, 1e-6);
+    REQUIRE(second != CG_NULL_ID);
+    REQUIRE(cg_tess_cache_stats(&entries, nullptr, &hits, nullptr) == CG_OK);
+    CHECK(entries == 6);
+    CHECK(hits == 6);
+    CHECK(cg_mesh_vertex_count(second) == cg_mesh_vertex_count(first));
+    CHECK(cg_mesh_triangle_count(second) == cg_mesh_triangle_count(first));
+
+    // A second tolerance keeps its own fragments alongside the first.
+    CgMeshId coarse = cg_shape_tessellate_welded(shape, 0.5, 0.8,
+                                                 CG_MESH_F64, 1e-6);
+    REQUIRE(coarse != CG_NULL_ID);
+    REQUIRE(cg_tess_cache_stats(&entries, nullptr, nullptr, nullptr) == CG_OK);
+    CHECK(entries == 12);
+
+    // Shrinking the budget evicts everything down to it.
+    REQUIRE(cg_tess_cache_set_budget(1) == CG_OK);
+    REQUIRE(cg_tess_cache_stats(&entries, &bytes, nullptr, nullptr) == CG_OK);
+    CHECK(entries == 0);
+    CHECK(bytes == 0);
+    REQUIRE(cg_tess_cache_set_budget((size_t)256 << 20) == CG_OK);
+
+    cg_mesh_free(first);
+    cg_mesh_free(second);
+    cg_mesh_free(coarse);
+    cg_shape_free(shape);
+}
+
+TEST_CASE("simplify and LOD chain reduce the triangle count") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    // A fine tessellation so there is something to decimate.
+    CgMeshId mesh = cg_shape_tessellate_welded(shape, 0.01, 0.2,
+                                               CG_MESH_F64, 1e-6);
+    REQUIRE(mesh != CG_NULL_ID);
+    const size_t full = cg_mesh_triangle_count(mesh);
+    REQUIRE(full > 100);
+
+    CgMeshId half = cg_mesh_simplify(mesh, 0.5, 0.0);
+    REQUIRE(half != CG_NULL_ID);
+    CHECK(cg_mesh_triangle_count(half) <= full / 2 + 2);
+    CHECK(cg_mesh_triangle_count(half) > 0);
+    CHECK(cg_mesh_triangle_count(mesh) == full); // source untouched
+
+    // Decimated vertices stay on the box.
+    size_t nv = cg_mesh_vertex_count(half);
+    std::vector<double> verts(nv * 3);
+    REQUIRE(cg_mesh_copy_vertices(half, verts.data()) == CG_OK);
+    for (double c : verts) {
+        CHECK(c > -1e-6);
+        CHECK(c < 10.0 + 1e-6);
+    }
+
+    // A rejected ratio must still null every output slot.
+    double bad_ratios[2] = {0.0, 0.5};
+    CgMeshId stale[2] = {123456, 654321};
+    CHECK(cg_mesh_build_lods(mesh, bad_ratios, 2, stale) == CG_ERR_INVALID_ARG);
+    CHECK(stale[0] == CG_NULL_ID);
+    CHECK(stale[1] == CG_NULL_ID);
+
+    double ratios[2] = {0.5, 0.1};
+    CgMeshId lods[2];
+    REQUIRE(cg_mesh_build_lods(mesh, ratios, 2, lods) == CG_OK);
+    REQUIRE(lods[0] != CG_NULL_ID);
+    REQUIRE(lods[1] != CG_NULL_ID);
+    // Each level matches its standalone decimation.
+    CHECK(cg_mesh_triangle_count(lods[0]) == cg_mesh_triangle_count(half));
+    CHECK(cg_mesh_triangle_count(lods[1]) < cg_mesh_triangle_count(lods[0]));
+
+    cg_mesh_free(lods[0]);
+    cg_mesh_free(lods[1]);
+    cg_mesh_free(half);
+    cg_mesh_free(mesh);
+    cg_shape_free(shape);
+}
+
 } // TEST_SUITE tessellation
 
+// ---------------------------------------------------------------------------
+// Test suite: streaming mesh extraction
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("streaming") {
+
+TEST_CASE("chunked extraction reassembles the whole box mesh") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+    CgMeshId mesh = cg_shape_tessellate_welded(shape, 0.1, 0.5,
+                                               CG_MESH_F64, 1e-6);
+    REQUIRE(mesh != CG_NULL_ID);
+    const size_t total_tris = cg_mesh_triangle_count(mesh);
+    REQUIRE(total_tris == 12);
+
+    const size_t chunk = 5;  // 12 triangles -> chunks of 5, 5, 2
+    CgMeshStreamId stream = cg_mesh_stream_begin(mesh, chunk);
+    REQUIRE(stream != CG_NULL_ID);
+
+    // The stream holds its own reference — freeing the mesh mid-stream is
+    // allowed, like a map pin.
+    cg_mesh_free(mesh);
+
+    std::vector<float> verts(chunk * 9), normals(chunk * 9);
+    std::vector<uint32_t> idx(chunk * 3);
+    size_t chunks = 0, tris_seen = 0;
+    for (;;) {
+        size_t nv = 0, nt = 0;
+        REQUIRE(cg_mesh_stream_next(stream, verts.data(), normals.data(),
+                                    idx.data(), &nv, &nt) == CG_OK);
+        if (nt == 0) break;
+        ++chunks;
+        tris_seen += nt;
+        CHECK(nt <= chunk);
+        CHECK(nv <= nt * 3);
+        for (size_t i = 0; i < nt * 3; ++i)
+            CHECK(idx[i] < nv);  // indices are chunk-local
+        for (size_t v = 0; v < nv; ++v) {
+            // Box vertices lie in [0,10]^3; normals are unit.
+            for (int k = 0; k < 3; ++k) {
+                CHECK(verts[v * 3 + k] >= -1e-3f);
+                CHECK(verts[v * 3 + k] <= 10.001f);
+            }
+            const float len = std::sqrt(normals[v * 3] * normals[v * 3] +
+                                        normals[v * 3 + 1] * normals[v * 3 + 1] +
+                                        normals[v * 3 + 2] * normals[v * 3 + 2]);
+            CHECK(len == doctest::Approx(1.0f).epsilon(1e-4));
+        }
+    }
+    CHECK(chunks == 3);
+    CHECK(tris_seen == total_tris);
+
+    // A drained stream keeps reporting completion.
+    size_t nv = 9, nt = 9;
+    CHECK(cg_mesh_stream_next(stream, verts.data(), nullptr, idx.data(),
+                              &nv, &nt) == CG_OK);
+    CHECK(nt == 0);
+
+    cg_mesh_stream_free(stream);
+    cg_shape_free(shape);
+}
+
+} // TEST_SUITE streaming
+
+// ---------------------------------------------------------------------------
+// Test suite: snapshot
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("snapshot") {
+
+TEST_CASE("save and load round-trip meshes as zero-copy views") {
+    namespace fs = std::filesystem;
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+    CgMeshId m64 = cg_shape_tessellate_welded(shape, 0.1, 0.5,
+                                              CG_MESH_F64, 1e-6);
+    CgMeshId m32 = cg_shape_tessellate_welded_ex(shape, 0.1, 0.5,
+                                                 CG_MESH_F32, 1e-6,
+                                                 CG_NORMALS_LAZY);
+    REQUIRE(m64 != CG_NULL_ID);
+    REQUIRE(m32 != CG_NULL_ID);
+    const size_t nv = cg_mesh_vertex_count(m64);
+    const size_t nt = cg_mesh_triangle_count(m64);
+    std::vector<double>   ref_verts(nv * 3), ref_norms(nv * 3);
+    std::vector<uint32_t> ref_idx(nt * 3);
+    REQUIRE(cg_mesh_copy_vertices(m64, ref_verts.data()) == CG_OK);
+    REQUIRE(cg_mesh_copy_normals(m64, ref_norms.data()) == CG_OK);
+    REQUIRE(cg_mesh_copy_indices(m64, ref_idx.data()) == CG_OK);
+
+    fs::path path =
+        fs::temp_directory_path() / "jamiecam_snapshot_test.cgcache";
+    REQUIRE(cg_cache_save(path.string().c_str()) == CG_OK);
+
+    CgMeshId* loaded   = nullptr;
+    size_t    n_loaded = 0;
+    REQUIRE(cg_cache_load(path.string().c_str(), &loaded, &n_loaded) ==
+            CG_OK);
+    REQUIRE(n_loaded >= 2);  // other suites may leave live meshes too
+    REQUIRE(loaded != nullptr);
+
+    // Find the views of our two meshes (the f64 one by exact content, since
+    // other saved meshes may share its counts).
+    CgMeshId view64 = CG_NULL_ID, view32 = CG_NULL_ID;
+    for (size_t i = 0; i < n_loaded; ++i) {
+        const CgMeshId id = loaded[i];
+        if (cg_mesh_vertex_count(id) != nv ||
+            cg_mesh_triangle_count(id) != nt)
+            continue;
+        if (cg_mesh_precision(id) == CG_MESH_F64 && view64 == CG_NULL_ID) {
+            std::vector<double> v(nv * 3);
+            REQUIRE(cg_mesh_copy_vertices(id, v.data()) == CG_OK);
+            if (std::memcmp(v.data(), ref_verts.data(),
+                            nv * 3 * sizeof(double)) == 0)
+                view64 = id;
+        } else if (cg_mesh_precision(id) == CG_MESH_F32 &&
+                   view32 == CG_NULL_ID) {
+            view32 = id;
+        }
+    }
+    REQUIRE(view64 != CG_NULL_ID);
+    REQUIRE(view32 != CG_NULL_ID);
+
+    // Indices and normals round-trip bit-for-bit (the save materialized the
+    // lazy buffers, so the view never rebuilds them).
+    std::vector<double>   norms(nv * 3);
+    std::vector<uint32_t> idx(nt * 3);
+    REQUIRE(cg_mesh_copy_normals(view64, norms.data()) == CG_OK);
+    REQUIRE(cg_mesh_copy_indices(view64, idx.data()) == CG_OK);
+    CHECK(std::memcmp(norms.data(), ref_norms.data(),
+                      nv * 3 * sizeof(double)) == 0);
+    CHECK(std::memcmp(idx.data(), ref_idx.data(),
+                      nt * 3 * sizeof(uint32_t)) == 0);
+
+    // Pointer access serves the mapping directly, and consumers built on
+    // the accessors work on a view unchanged.
+    const double* p = cg_mesh_vertices_ptr(view64);
+    REQUIRE(p != nullptr);
+    CHECK(p[0] == ref_verts[0]);
+    CHECK(cg_mesh_vertices_ptr_f32(view32) != nullptr);
+    CgBvhId bvh = cg_mesh_build_bvh(view64);
+    CHECK(bvh != CG_NULL_ID);
+    cg_bvh_free(bvh);
+
+    for (size_t i = 0; i < n_loaded; ++i) cg_mesh_free(loaded[i]);
+    cg_mesh_ids_free(loaded);
+    cg_mesh_free(m64);
+    cg_mesh_free(m32);
+    cg_shape_free(shape);
+    fs::remove(path);
+}
+
+TEST_CASE("loading a non-snapshot file fails cleanly") {
+    CgMeshId* ids = (CgMeshId*)0x1;
+    size_t    n   = 99;
+    CHECK(cg_cache_load(STEP_PATH, &ids, &n) == CG_ERR_PARSE_FAILED);
+    CHECK(ids == nullptr);
+    CHECK(n == 0);
+    CHECK(cg_cache_load("no_such_dir/x.cgcache", &ids, &n) ==
+          CG_ERR_FILE_NOT_FOUND);
+    CHECK(last_error().size() > 0);
+}
+
+} // TEST_SUITE snapshot
+
+// ---------------------------------------------------------------------------
+// Test suite: threading
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("threading") {
+
+TEST_CASE("kernel features honor a single-thread budget") {
+    REQUIRE(cg_set_worker_threads(1) == CG_OK);
+    const uint64_t batches_before = cg_pool_stats().parallel_batches;
+
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+    CgMeshId mesh = cg_shape_tessellate(shape, 0.1, 0.5);
+    CHECK(mesh != CG_NULL_ID);
+
+    // Under a budget of one no parallel section may fork.
+    CHECK(cg_pool_stats().parallel_batches == batches_before);
+    CHECK(cg_pool_stats().effective_threads == 1);
+
+    cg_mesh_free(mesh);
+    cg_shape_free(shape);
+    REQUIRE(cg_set_worker_threads(0) == CG_OK);
+}
+
+TEST_CASE("perf counters record import and tessellation") {
+    REQUIRE(cg_perf_reset() == CG_OK);
+
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+    CgMeshId mesh = cg_shape_tessellate(shape, 0.1, 0.5);
+    REQUIRE(mesh != CG_NULL_ID);
+
+    const size_t n = cg_perf_counters_snapshot(nullptr, 0);
+    std::vector<CgPerfCounter> counters(n);
+    REQUIRE(cg_perf_counters_snapshot(counters.data(), n) == n);
+    for (const CgPerfCounter& c : counters) {
+        if (std::string(c.name) == "import") {
+            CHECK(c.calls == 1);
+            CHECK(c.total_ns > 0);
+        } else if (std::string(c.name) == "tessellate") {
+            CHECK(c.calls == 1);
+            // Bytes attribute the produced mesh buffers.
+            CHECK(c.bytes > 0);
+            CHECK(c.max_ns <= c.total_ns);
+        }
+    }
+
+    cg_mesh_free(mesh);
+    cg_shape_free(shape);
+    cg_perf_reset();
+}
+
+} // TEST_SUITE threading
+
+// ---------------------------------------------------------------------------
+// Test suite: shape distance
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("distance") {
+
+TEST_CASE("distance between a shape and its translated copy") {
+    CgShapeId a = cg_load_step(STEP_PATH);
+    CgShapeId b = cg_load_step(STEP_PATH);
+    REQUIRE(a != CG_NULL_ID);
+    REQUIRE(b != CG_NULL_ID);
+
+    // Identical placement: the copies coincide.
+    CHECK(cg_shape_distance(a, b) == doctest::Approx(0.0));
+    // Second query hits the cached BVHs and agrees.
+    CHECK(cg_shape_distance(a, b) == doctest::Approx(0.0));
+
+    // Batch placements of the moving copy along z; the box is 10 mm tall,
+    // so a 30 mm lift opens a 20 mm gap and a 5 mm lift still overlaps.
+    const double transforms[24] = {
+        1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 30,
+        1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 5,
+    };
+    double dists[2] = {-1.0, -1.0};
+    REQUIRE(cg_shape_distance_batch(a, b, transforms, 2, dists) == CG_OK);
+    CHECK(dists[0] == doctest::Approx(20.0).epsilon(1e-6));
+    CHECK(dists[1] == doctest::Approx(0.0));
+
+    cg_shape_free(a);
+    cg_shape_free(b);
+}
+
+} // TEST_SUITE distance
+
+// ---------------------------------------------------------------------------
+// Test suite: feature detection
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("features") {
+
+TEST_CASE("planar face scan classifies all six faces of the box") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgPlanarFaceInfo* faces = nullptr;
+    size_t n = cg_shape_find_planar_faces(shape, &faces);
+    REQUIRE(n == 6);
+    REQUIRE(faces != nullptr);
+
+    double top_z = -1.0;
+    for (size_t i = 0; i < n; ++i) {
+        CHECK(faces[i].area == doctest::Approx(100.0).epsilon(1e-6));
+        // Outward-oriented unit normal.
+        const double len = std::sqrt(faces[i].normal.x * faces[i].normal.x +
+                                     faces[i].normal.y * faces[i].normal.y +
+                                     faces[i].normal.z * faces[i].normal.z);
+        CHECK(len == doctest::Approx(1.0).epsilon(1e-9));
+        if (faces[i].normal.z > 0.5) top_z = faces[i].z_height;
+        // Each entry carries an independently owned face handle.
+        CHECK(cg_face_surface_type(faces[i].face_id) == CG_SURF_PLANE);
+        cg_face_free(faces[i].face_id);
+    }
+    CHECK(top_z == doctest::Approx(10.0).epsilon(1e-6));
+
+    cg_planar_faces_free(faces);
+    cg_shape_free(shape);
+}
+
+TEST_CASE("hole detection finds nothing on a plain box") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgHoleInfo* holes = nullptr;
+    CHECK(cg_shape_find_holes(shape, 0.0, 100.0, &holes) == 0);
+    CHECK(holes == nullptr);
+
+    cg_shape_free(shape);
+}
+
+} // TEST_SUITE features
+
+// ---------------------------------------------------------------------------
+// Test suite: edge evaluation and discretization
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("edges") {
+
+TEST_CASE("edge evaluation on a box edge") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    size_t n_edges = cg_shape_edges(shape, nullptr, 0);
+    REQUIRE(n_edges == 12);
+    std::vector<CgEdgeId> edges(n_edges);
+    REQUIRE(cg_shape_edges(shape, edges.data(), n_edges) == n_edges);
+
+    // Every box edge is a straight 10 mm segment.
+    CHECK(cg_edge_length(edges[0]) == doctest::Approx(10.0).epsilon(1e-6));
+    CHECK(cg_edge_is_circle(edges[0], nullptr, nullptr, nullptr) == 0);
+
+    double t0 = 0.0, t1 = 0.0;
+    cg_edge_param_range(edges[0], &t0, &t1);
+    CHECK(t1 > t0);
+
+    const CgPoint3 a = cg_edge_eval_point(edges[0], t0);
+    const CgPoint3 b = cg_edge_eval_point(edges[0], t1);
+    const double dx = b.x - a.x, dy = b.y - a.y, dz = b.z - a.z;
+    CHECK(std::sqrt(dx * dx + dy * dy + dz * dz) ==
+          doctest::Approx(10.0).epsilon(1e-6));
+
+    const CgVec3 tan = cg_edge_eval_tangent(edges[0], 0.5 * (t0 + t1));
+    CHECK(std::sqrt(tan.x * tan.x + tan.y * tan.y + tan.z * tan.z) ==
+          doctest::Approx(1.0).epsilon(1e-9));
+
+    for (CgEdgeId e : edges) cg_edge_free(e);
+    cg_shape_free(shape);
+}
+
+TEST_CASE("discretization of box edges yields endpoint-only polylines") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    std::vector<CgEdgeId> edges(12);
+    REQUIRE(cg_shape_edges(shape, edges.data(), 12) == 12);
+
+    // Single edge: a line needs exactly its two endpoints.
+    CgPoint3* pts = nullptr;
+    double* params = nullptr;
+    size_t count = 0;
+    REQUIRE(cg_edge_discretize(edges[0], 0.01, &pts, &params, &count) == CG_OK);
+    CHECK(count == 2);
+    CHECK(params[0] < params[1]);
+    cg_section_free(pts);
+    cg_params_free(params);
+
+    // Batch: 12 lines, two points each, packed in input order.
+    size_t* counts = nullptr;
+    REQUIRE(cg_edge_discretize_batch(edges.data(), edges.size(), 0.01,
+                                     &pts, &params, &counts) == CG_OK);
+    size_t total = 0;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        CHECK(counts[i] == 2);
+        total += counts[i];
+    }
+    CHECK(total == 24);
+    // Each edge's chord spans 10 mm.
+    for (size_t i = 0; i < edges.size(); ++i) {
+        const CgPoint3& p0 = pts[i * 2];
+        const CgPoint3& p1 = pts[i * 2 + 1];
+        const double dx = p1.x - p0.x, dy = p1.y - p0.y, dz = p1.z - p0.z;
+        CHECK(std::sqrt(dx * dx + dy * dy + dz * dz) ==
+              doctest::Approx(10.0).epsilon(1e-6));
+    }
+    cg_section_free(pts);
+    cg_params_free(params);
+    cg_level_counts_free(counts);
+
+    for (CgEdgeId e : edges) cg_edge_free(e);
+    cg_shape_free(shape);
+}
+
+} // TEST_SUITE edges
+
 // ---------------------------------------------------------------------------
 // Test suite: bounding box
 // ---------------------------------------------------------------------------
@@ -161,6 +920,329 @@ TEST_CASE("bounding box of loaded STEP box is approximately 10x10x10") {
 
 } // TEST_SUITE bounding_box
 
+// ---------------------------------------------------------------------------
+// Test suite: shape healing
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("shape_heal") {
+
+TEST_CASE("healing a loaded shape yields a new handle with the same bounds") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgShapeId healed = cg_shape_heal(shape);
+    REQUIRE(healed != CG_NULL_ID);
+    CHECK(healed != shape);
+
+    CgBbox a = cg_shape_bounding_box(shape);
+    CgBbox b = cg_shape_bounding_box(healed);
+    CHECK(b.xmax - b.xmin == doctest::Approx(a.xmax - a.xmin).epsilon(1e-6));
+    CHECK(b.ymax - b.ymin == doctest::Approx(a.ymax - a.ymin).epsilon(1e-6));
+    CHECK(b.zmax - b.zmin == doctest::Approx(a.zmax - a.zmin).epsilon(1e-6));
+
+    cg_shape_free(healed);
+    cg_shape_free(shape);
+}
+
+TEST_CASE("healing level is validated and round-trips through the import path") {
+    CHECK(cg_shape_heal_set_level(static_cast<CgHealLevel>(99)) == CG_ERR_INVALID_ARG);
+
+    // NONE still imports the shape, just without the ShapeFix pass.
+    REQUIRE(cg_shape_heal_set_level(CG_HEAL_NONE) == CG_OK);
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    CHECK(shape != CG_NULL_ID);
+    cg_shape_free(shape);
+
+    REQUIRE(cg_shape_heal_set_level(CG_HEAL_FULL) == CG_OK);
+}
+
+TEST_CASE("healing with invalid or null handle fails cleanly") {
+    CHECK(cg_shape_heal(CG_NULL_ID) == CG_NULL_ID);
+    CHECK(cg_shape_heal(0xdeadbeefULL) == CG_NULL_ID);
+    CHECK(std::string(cg_last_error_message()).size() > 0);
+}
+
+} // TEST_SUITE shape_heal
+
+// ---------------------------------------------------------------------------
+// Test suite: mesh spatial index
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("bvh") {
+
+TEST_CASE("batch raycast against the box mesh hits the expected faces") {
+    CgMeshId mesh = cg_load_stl(STL_PATH);
+    REQUIRE(mesh != CG_NULL_ID);
+    CgBvhId bvh = cg_mesh_build_bvh(mesh);
+    REQUIRE(bvh != CG_NULL_ID);
+    // The index is self-contained: the source mesh can be freed.
+    cg_mesh_free(mesh);
+
+    // A 3x3 grid of downward rays over the box plus one that misses.
+    std::vector<double>   origins, dirs;
+    for (int ix = 0; ix < 3; ++ix)
+        for (int iy = 0; iy < 3; ++iy) {
+            origins.insert(origins.end(), {2.0 + 3.0 * ix, 2.0 + 3.0 * iy, 20.0});
+            dirs.insert(dirs.end(), {0.0, 0.0, -1.0});
+        }
+    origins.insert(origins.end(), {50.0, 50.0, 20.0});
+    dirs.insert(dirs.end(), {0.0, 0.0, -1.0});
+
+    std::vector<CgRayHit> hits(10);
+    REQUIRE(cg_bvh_raycast_batch(bvh, origins.data(), dirs.data(), 10,
+                                 hits.data()) == CG_OK);
+    for (int i = 0; i < 9; ++i) {
+        CHECK(hits[i].triangle != UINT32_MAX);
+        CHECK(hits[i].t == doctest::Approx(10.0)); // top face at z = 10
+    }
+    CHECK(hits[9].triangle == UINT32_MAX);
+    CHECK(hits[9].t < 0.0);
+
+    cg_bvh_free(bvh);
+}
+
+TEST_CASE("batch closest-point distances match the box geometry") {
+    CgMeshId mesh = cg_load_stl(STL_PATH);
+    REQUIRE(mesh != CG_NULL_ID);
+    CgBvhId bvh = cg_mesh_build_bvh(mesh);
+    REQUIRE(bvh != CG_NULL_ID);
+
+    const double points[] = {
+        5, 5, 13,   // above the top face
+        5, 5, 5,    // inside (nearest face 5 mm away)
+        13, 14, 12, // beyond the (10,10,10) corner
+    };
+    CgClosestPoint results[3];
+    REQUIRE(cg_bvh_closest_point_batch(bvh, points, 3, results) == CG_OK);
+    CHECK(results[0].distance == doctest::Approx(3.0));
+    CHECK(results[0].point.z == doctest::Approx(10.0));
+    CHECK(results[1].distance == doctest::Approx(5.0));
+    CHECK(results[2].distance ==
+          doctest::Approx(std::sqrt(3.0 * 3.0 + 4.0 * 4.0 + 2.0 * 2.0)));
+
+    cg_bvh_free(bvh);
+    cg_mesh_free(mesh);
+}
+
+TEST_CASE("building a BVH from a freed or null mesh fails cleanly") {
+    CHECK(cg_mesh_build_bvh(CG_NULL_ID) == CG_NULL_ID);
+    CHECK(cg_mesh_build_bvh(0xdeadbeefULL) == CG_NULL_ID);
+    CHECK(std::string(cg_last_error_message()).size() > 0);
+}
+
+} // TEST_SUITE bvh
+
+// ---------------------------------------------------------------------------
+// Test suite: heightmap rasterization
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("heightmap") {
+
+TEST_CASE("rasterized box heightmap reads the top face inside, no-data outside") {
+    CgMeshId mesh = cg_load_stl(STL_PATH);
+    REQUIRE(mesh != CG_NULL_ID);
+
+    // A window twice the box footprint, so the outer ring of cells is empty.
+    CgBbox bounds{-5, -5, 0, 15, 15, 0};
+    const size_t n = 20;
+    float* grid = nullptr;
+    REQUIRE(cg_mesh_rasterize_heightmap(mesh, bounds, n, n, &grid) == CG_OK);
+    REQUIRE(grid != nullptr);
+
+    size_t covered = 0;
+    for (size_t i = 0; i < n * n; ++i)
+        if (std::isfinite(grid[i])) {
+            ++covered;
+            CHECK(grid[i] == doctest::Approx(10.0)); // top face of the box
+        }
+    // Box [0,10]^2 over 1 mm cells: a 10x10 block of centers falls inside.
+    CHECK(covered == 100);
+
+    cg_heightmap_free(grid);
+    cg_mesh_free(mesh);
+}
+
+TEST_CASE("heightmap argument validation") {
+    CgMeshId mesh = cg_load_stl(STL_PATH);
+    REQUIRE(mesh != CG_NULL_ID);
+    CgBbox bounds{0, 0, 0, 10, 10, 0};
+    float* grid = nullptr;
+    CHECK(cg_mesh_rasterize_heightmap(mesh, bounds, 0, 4, &grid) ==
+          CG_ERR_INVALID_ARG);
+    CHECK(cg_mesh_rasterize_heightmap(CG_NULL_ID, bounds, 4, 4, &grid) ==
+          CG_ERR_NULL_HANDLE);
+    CHECK(grid == nullptr);
+    cg_mesh_free(mesh);
+}
+
+} // TEST_SUITE heightmap
+
+// ---------------------------------------------------------------------------
+// Test suite: stock model
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("stock") {
+
+TEST_CASE("stock built from the box mesh matches its volume") {
+    CgMeshId mesh = cg_load_stl(STL_PATH);
+    REQUIRE(mesh != CG_NULL_ID);
+
+    CgBbox bounds{-2, -2, 0, 12, 12, 0};
+    CgStockId stock = cg_stock_new_from_mesh(mesh, bounds, 0.25);
+    REQUIRE(stock != CG_NULL_ID);
+    // The 10x10x10 box, within heightmap discretization.
+    CHECK(cg_stock_volume(stock) == doctest::Approx(1000.0).epsilon(0.02));
+
+    // Face the top off by 2 mm and check the volume accounting.
+    const double before = cg_stock_volume(stock);
+    CgToolDef tool{8.0, 0.0};
+    std::vector<CgPoint3> pts;
+    for (int row = 0; row < 5; ++row)
+        for (int i = 0; i <= 20; ++i)
+            pts.push_back(CgPoint3{-2.0 + 0.7 * i, 1.0 + 2.5 * row, 8.0});
+    std::vector<double> removed(pts.size());
+    REQUIRE(cg_stock_subtract_sweep(stock, tool, pts.data(), pts.size(),
+                                    removed.data(), nullptr) == CG_OK);
+    double total = 0;
+    for (double r : removed) total += r;
+    CHECK(total == doctest::Approx(before - cg_stock_volume(stock)).epsilon(1e-9));
+
+    cg_stock_free(stock);
+    cg_mesh_free(mesh);
+}
+
+} // TEST_SUITE stock
+
+// ---------------------------------------------------------------------------
+// Test suite: surface evaluation
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("surface_eval") {
+
+TEST_CASE("box faces enumerate as six planes with sane UV bounds") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    REQUIRE(cg_shape_faces(shape, nullptr, 0) == 6); // count query
+    CgFaceId faces[6];
+    REQUIRE(cg_shape_faces(shape, faces, 6) == 6);
+
+    for (CgFaceId f : faces) {
+        CHECK(cg_face_surface_type(f) == CG_SURF_PLANE);
+        CgUVBounds b = cg_face_uv_bounds(f);
+        CHECK(b.umax - b.umin == doctest::Approx(10.0)); // 10 mm box
+        CHECK(b.vmax - b.vmin == doctest::Approx(10.0));
+        cg_face_free(f);
+    }
+    cg_shape_free(shape);
+}
+
+TEST_CASE("batch evaluation lands on the box and matches single samples") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+    CgFaceId faces[6];
+    REQUIRE(cg_shape_faces(shape, faces, 6) == 6);
+
+    for (CgFaceId f : faces) {
+        CgUVBounds b = cg_face_uv_bounds(f);
+        // A 3x3 grid of interior samples.
+        std::vector<double> uv;
+        for (int i = 1; i <= 3; ++i)
+            for (int j = 1; j <= 3; ++j) {
+                uv.push_back(b.umin + 0.25 * i * (b.umax - b.umin));
+                uv.push_back(b.vmin + 0.25 * j * (b.vmax - b.vmin));
+            }
+        const size_t n = uv.size() / 2;
+        std::vector<CgPoint3> pts(n);
+        std::vector<CgVec3>   nrm(n), du(n), dv(n);
+        REQUIRE(cg_face_eval_batch(f, uv.data(), n, pts.data(), nrm.data(),
+                                   du.data(), dv.data()) == CG_OK);
+
+        for (size_t i = 0; i < n; ++i) {
+            // Every sample sits on one of the box's planes.
+            bool on_surface = false;
+            for (double c : {pts[i].x, pts[i].y, pts[i].z}) {
+                CHECK(c > -1e-9);
+                CHECK(c < 10.0 + 1e-9);
+                if (std::fabs(c) < 1e-9 || std::fabs(c - 10.0) < 1e-9)
+                    on_surface = true;
+            }
+            CHECK(on_surface);
+            const double len = std::sqrt(nrm[i].x * nrm[i].x +
+                                         nrm[i].y * nrm[i].y +
+                                         nrm[i].z * nrm[i].z);
+            CHECK(len == doctest::Approx(1.0));
+        }
+
+        // The batch agrees with the single-sample evaluators.
+        CgPoint3 p = cg_face_eval_point(f, uv[0], uv[1]);
+        CgVec3   m = cg_face_eval_normal(f, uv[0], uv[1]);
+        CgVec3   d = cg_face_eval_du(f, uv[0], uv[1]);
+        CHECK(p.x == doctest::Approx(pts[0].x));
+        CHECK(p.y == doctest::Approx(pts[0].y));
+        CHECK(p.z == doctest::Approx(pts[0].z));
+        CHECK(m.z == doctest::Approx(nrm[0].z));
+        CHECK(d.x == doctest::Approx(du[0].x));
+        cg_face_free(f);
+    }
+    cg_shape_free(shape);
+}
+
+TEST_CASE("batch evaluation rejects bad arguments") {
+    CgPoint3 pts[1];
+    CHECK(cg_face_eval_batch(123456, nullptr, 1, pts, nullptr, nullptr,
+                             nullptr) == CG_ERR_INVALID_ARG);
+    double uv[2] = {0, 0};
+    CHECK(cg_face_eval_batch(CG_NULL_ID, uv, 1, pts, nullptr, nullptr,
+                             nullptr) == CG_ERR_NULL_HANDLE);
+    CHECK(cg_face_eval_batch(123456, uv, 1, pts, nullptr, nullptr,
+                             nullptr) == CG_ERR_NULL_HANDLE);
+}
+
+TEST_CASE("seeded projection follows a path across a face") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+    CgFaceId faces[6];
+    REQUIRE(cg_shape_faces(shape, faces, 6) == 6);
+
+    // Find the top face (normal +Z) and project a path hovering 1 mm above.
+    CgFaceId top = CG_NULL_ID;
+    for (CgFaceId f : faces) {
+        CgUVBounds b = cg_face_uv_bounds(f);
+        CgVec3 nrm = cg_face_eval_normal(f, 0.5 * (b.umin + b.umax),
+                                         0.5 * (b.vmin + b.vmax));
+        if (nrm.z > 0.9) top = f;
+    }
+    REQUIRE(top != CG_NULL_ID);
+
+    std::vector<CgPoint3> path;
+    for (int i = 0; i <= 20; ++i)
+        path.push_back(CgPoint3{0.5 + 0.45 * i, 2.0 + 0.3 * i, 11.0});
+    std::vector<CgPoint2> uvs(path.size());
+    std::vector<double>   dists(path.size());
+    REQUIRE(cg_face_project_points(top, path.data(), path.size(), nullptr,
+                                   uvs.data(), dists.data()) == CG_OK);
+    for (size_t i = 0; i < path.size(); ++i) {
+        CHECK(dists[i] == doctest::Approx(1.0).epsilon(1e-6));
+        CgPoint3 foot = cg_face_eval_point(top, uvs[i].u, uvs[i].v);
+        CHECK(foot.x == doctest::Approx(path[i].x));
+        CHECK(foot.y == doctest::Approx(path[i].y));
+        CHECK(foot.z == doctest::Approx(10.0));
+    }
+
+    // The one-point wrapper agrees.
+    double d = -1;
+    CgPoint2 uv = cg_face_project_point(top, path[0], &d);
+    CHECK(uv.u == doctest::Approx(uvs[0].u));
+    CHECK(uv.v == doctest::Approx(uvs[0].v));
+    CHECK(d == doctest::Approx(dists[0]));
+
+    for (CgFaceId f : faces) cg_face_free(f);
+    cg_shape_free(shape);
+}
+
+} // TEST_SUITE surface_eval
+
 // ---------------------------------------------------------------------------
 // Test suite: mesh data copy
 // ---------------------------------------------------------------------------
@@ -202,6 +1284,235 @@ TEST_CASE("STL box mesh has expected triangle count") {
 
 } // TEST_SUITE mesh_data_copy
 
+// ---------------------------------------------------------------------------
+// Test suite: zero-copy mesh access
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("mesh_zero_copy") {
+
+TEST_CASE("borrowed pointers expose the same data as the copy functions") {
+    CgMeshId mesh = cg_load_stl(STL_PATH);
+    REQUIRE(mesh != CG_NULL_ID);
+
+    size_t nv = cg_mesh_vertex_count(mesh);
+    size_t nt = cg_mesh_triangle_count(mesh);
+    REQUIRE(nv > 0);
+    REQUIRE(nt > 0);
+
+    const double*   verts = cg_mesh_vertices_ptr(mesh);
+    const double*   norms = cg_mesh_normals_ptr(mesh);
+    const uint32_t* idxs  = cg_mesh_indices_ptr(mesh);
+    REQUIRE(verts != nullptr);
+    REQUIRE(norms != nullptr);
+    REQUIRE(idxs  != nullptr);
+
+    std::vector<double>   verts_copy(nv * 3);
+    std::vector<double>   norms_copy(nv * 3);
+    std::vector<uint32_t> idxs_copy(nt * 3);
+    REQUIRE(cg_mesh_copy_vertices(mesh, verts_copy.data()) == CG_OK);
+    REQUIRE(cg_mesh_copy_normals(mesh, norms_copy.data())  == CG_OK);
+    REQUIRE(cg_mesh_copy_indices(mesh, idxs_copy.data())   == CG_OK);
+
+    CHECK(std::memcmp(verts, verts_copy.data(), nv * 3 * sizeof(double))   == 0);
+    CHECK(std::memcmp(norms, norms_copy.data(), nv * 3 * sizeof(double))   == 0);
+    CHECK(std::memcmp(idxs,  idxs_copy.data(),  nt * 3 * sizeof(uint32_t)) == 0);
+
+    cg_mesh_free(mesh);
+}
+
+TEST_CASE("mapped buffers survive cg_mesh_free until unmap") {
+    CgMeshId mesh = cg_load_stl(STL_PATH);
+    REQUIRE(mesh != CG_NULL_ID);
+
+    size_t nv = cg_mesh_vertex_count(mesh);
+    REQUIRE(nv > 0);
+
+    REQUIRE(cg_mesh_map(mesh) == CG_OK);
+    const double* verts = cg_mesh_vertices_ptr(mesh);
+    REQUIRE(verts != nullptr);
+    const double first_x = verts[0];
+
+    cg_mesh_free(mesh);
+
+    // The handle is freed but the pin keeps the buffers alive and readable.
+    CHECK(cg_mesh_vertex_count(mesh) == nv);
+    CHECK(cg_mesh_vertices_ptr(mesh) == verts);
+    CHECK(verts[0] == first_x);
+
+    CHECK(cg_mesh_unmap(mesh) == CG_OK);
+
+    // After the last unmap the mesh is fully gone.
+    CHECK(cg_mesh_vertices_ptr(mesh) == nullptr);
+}
+
+TEST_CASE("maps nest; unmap without map fails") {
+    CgMeshId mesh = cg_load_stl(STL_PATH);
+    REQUIRE(mesh != CG_NULL_ID);
+
+    CHECK(cg_mesh_unmap(mesh) == CG_ERR_INVALID_ARG);
+
+    REQUIRE(cg_mesh_map(mesh) == CG_OK);
+    REQUIRE(cg_mesh_map(mesh) == CG_OK);
+    CHECK(cg_mesh_unmap(mesh) == CG_OK);
+    CHECK(cg_mesh_unmap(mesh) == CG_OK);
+    CHECK(cg_mesh_unmap(mesh) == CG_ERR_INVALID_ARG);
+
+    cg_mesh_free(mesh);
+}
+
+TEST_CASE("map with null or unknown id fails") {
+    CHECK(cg_mesh_map(CG_NULL_ID) == CG_ERR_NULL_HANDLE);
+    CHECK(cg_mesh_map(UINT64_C(0xDEAD)) == CG_ERR_NULL_HANDLE);
+}
+
+} // TEST_SUITE mesh_zero_copy
+
+// ---------------------------------------------------------------------------
+// Test suite: sectioning
+// ---------------------------------------------------------------------------
+
+TEST_SUITE("sectioning") {
+
+TEST_CASE("section of the box at mid-height yields segments on the plane") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgBbox bb = cg_shape_bounding_box(shape);
+    const double z_mid = (bb.zmin + bb.zmax) / 2.0;
+
+    CgPoint3* pts = nullptr;
+    size_t    count = 0;
+    CgError e = cg_shape_section_at_z(shape, z_mid, &pts, &count);
+    INFO("last error: " << last_error());
+    REQUIRE(e == CG_OK);
+    REQUIRE(pts != nullptr);
+    // Segment pairs: count must be even and non-zero (box outline = 4 edges).
+    CHECK(count >= 8);
+    CHECK(count % 2 == 0);
+    for (size_t i = 0; i < count; ++i) {
+        CHECK(pts[i].z == doctest::Approx(z_mid).epsilon(1e-6));
+    }
+
+    cg_section_free(pts);
+    cg_shape_free(shape);
+}
+
+TEST_CASE("section outside the shape returns CG_ERR_NO_RESULT") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgBbox bb = cg_shape_bounding_box(shape);
+    CgPoint3* pts = nullptr;
+    size_t    count = 0;
+    CgError e = cg_shape_section_at_z(shape, bb.zmax + 100.0, &pts, &count);
+    CHECK(e == CG_ERR_NO_RESULT);
+    CHECK(pts == nullptr);
+    CHECK(count == 0);
+
+    cg_shape_free(shape);
+}
+
+TEST_CASE("multi-z slicing matches per-level expectations") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgSlicerId slicer = cg_slicer_new(shape);
+    INFO("last error: " << last_error());
+    REQUIRE(slicer != CG_NULL_ID);
+
+    CgBbox bb = cg_shape_bounding_box(shape);
+    // Two levels inside the box, one far above it.
+    const double zs[3] = {
+        bb.zmin + (bb.zmax - bb.zmin) * 0.25,
+        bb.zmin + (bb.zmax - bb.zmin) * 0.75,
+        bb.zmax + 100.0,
+    };
+
+    CgPoint3* pts = nullptr;
+    size_t*   counts = nullptr;
+    CgError e = cg_slicer_section_multi_z(slicer, zs, 3, 0.01, &pts, &counts);
+    INFO("last error: " << last_error());
+    REQUIRE(e == CG_OK);
+    REQUIRE(pts != nullptr);
+    REQUIRE(counts != nullptr);
+
+    CHECK(counts[0] >= 8);
+    CHECK(counts[1] >= 8);
+    CHECK(counts[2] == 0);
+
+    // Each level's points lie on its plane, in concatenation order.
+    size_t offset = 0;
+    for (size_t lvl = 0; lvl < 2; ++lvl) {
+        for (size_t i = 0; i < counts[lvl]; ++i) {
+            CHECK(pts[offset + i].z == doctest::Approx(zs[lvl]).epsilon(1e-6));
+        }
+        offset += counts[lvl];
+    }
+
+    cg_section_free(pts);
+    cg_level_counts_free(counts);
+    cg_slicer_free(slicer);
+    cg_shape_free(shape);
+}
+
+TEST_CASE("slicer survives cg_shape_free of its source shape") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgSlicerId slicer = cg_slicer_new(shape);
+    REQUIRE(slicer != CG_NULL_ID);
+
+    CgBbox bb = cg_shape_bounding_box(shape);
+    const double z_mid = (bb.zmin + bb.zmax) / 2.0;
+    cg_shape_free(shape);
+
+    CgPoint3* pts = nullptr;
+    size_t*   counts = nullptr;
+    CgError e = cg_slicer_section_multi_z(slicer, &z_mid, 1, 0.01, &pts, &counts);
+    CHECK(e == CG_OK);
+    if (e == CG_OK) {
+        CHECK(counts[0] > 0);
+        cg_section_free(pts);
+        cg_level_counts_free(counts);
+    }
+    cg_slicer_free(slicer);
+}
+
+TEST_CASE("section loops of the box form one closed CCW square outline") {
+    CgShapeId shape = cg_load_step(STEP_PATH);
+    REQUIRE(shape != CG_NULL_ID);
+
+    CgBbox bb = cg_shape_bounding_box(shape);
+    const double z_mid = (bb.zmin + bb.zmax) / 2.0;
+
+    CgPoint3* pts = nullptr;
+    size_t*   loop_counts = nullptr;
+    size_t    n_loops = 0;
+    CgError e = cg_shape_section_loops_at_z(shape, z_mid, &pts, &loop_counts,
+                                            &n_loops);
+    INFO("last error: " << last_error());
+    REQUIRE(e == CG_OK);
+    REQUIRE(n_loops == 1);
+    REQUIRE(loop_counts[0] >= 4);
+
+    // All loop points lie on the plane and on the box outline.
+    double area2 = 0.0;
+    for (size_t i = 0; i < loop_counts[0]; ++i) {
+        CHECK(pts[i].z == doctest::Approx(z_mid).epsilon(1e-6));
+        const CgPoint3& a = pts[i];
+        const CgPoint3& b = pts[(i + 1) % loop_counts[0]];
+        area2 += a.x * b.y - b.x * a.y;
+    }
+    // Closed CCW loop: positive area, approximately the box cross-section.
+    CHECK(area2 / 2.0 == doctest::Approx(100.0).epsilon(1e-2));
+
+    cg_section_free(pts);
+    cg_level_counts_free(loop_counts);
+    cg_shape_free(shape);
+}
+
+} // TEST_SUITE sectioning
+
 // ---------------------------------------------------------------------------
 // Test suite: free / double-free safety
 // ---------------------------------------------------------------------------
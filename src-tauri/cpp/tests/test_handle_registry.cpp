@@ -280,6 +280,71 @@ TEST(concurrent_reads_succeed) {
               successes.load(), N_READERS);
 }
 
+TEST(counts_and_frees_span_shards) {
+    // More entries than kShardCount guarantees every shard is populated;
+    // counts must aggregate across shards and frees must hit the right one.
+    MockReg reg;
+    constexpr size_t N = MockReg::kShardCount * 4;
+
+    std::vector<uint64_t> shape_ids, mesh_ids;
+    for (size_t i = 0; i < N; ++i) {
+        shape_ids.push_back(reg.store_shape("s" + std::to_string(i)));
+        mesh_ids.push_back(
+            reg.store_mesh(std::make_shared<std::string>(std::to_string(i))));
+    }
+    ASSERT_EQ("sharded shape_count aggregates", reg.shape_count(), N);
+    ASSERT_EQ("sharded mesh_count aggregates", reg.mesh_count(), N);
+
+    bool all_found = true;
+    for (size_t i = 0; i < N; ++i)
+        if (reg.get_shape(shape_ids[i]) != "s" + std::to_string(i))
+            all_found = false;
+    ASSERT_TRUE("every shard resolves its own IDs", all_found);
+
+    // Free every other entry; survivors must be untouched.
+    for (size_t i = 0; i < N; i += 2) {
+        reg.free_shape(shape_ids[i]);
+        reg.free_mesh(mesh_ids[i]);
+    }
+    ASSERT_EQ("half the shapes remain after interleaved frees",
+              reg.shape_count(), N / 2);
+    ASSERT_EQ("surviving shape still readable",
+              reg.get_shape(shape_ids[1]), std::string("s1"));
+}
+
+TEST(concurrent_reads_during_frees_on_other_ids) {
+    // Readers on one set of handles and a writer freeing a different set
+    // must not interfere — the sharded lock makes this the common case.
+    MockReg reg;
+    constexpr int N_KEEP = 64;
+    constexpr int N_FREE = 64;
+
+    std::vector<uint64_t> keep_ids, free_ids;
+    for (int i = 0; i < N_KEEP; ++i)
+        keep_ids.push_back(reg.store_shape("keep" + std::to_string(i)));
+    for (int i = 0; i < N_FREE; ++i)
+        free_ids.push_back(reg.store_shape("free" + std::to_string(i)));
+
+    std::atomic<int> read_errors{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int pass = 0; pass < 100; ++pass)
+                for (int i = 0; i < N_KEEP; ++i)
+                    if (reg.get_shape(keep_ids[i]) != "keep" + std::to_string(i))
+                        read_errors.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+    threads.emplace_back([&]() {
+        for (uint64_t id : free_ids) reg.free_shape(id);
+    });
+    for (auto& th : threads) th.join();
+
+    ASSERT_EQ("reads stay correct while other IDs are freed",
+              read_errors.load(), 0);
+    ASSERT_EQ("freed set is gone", reg.shape_count(), size_t{N_KEEP});
+}
+
 // ---------------------------------------------------------------------------
 // Group 7: cam_geometry.h constants and type layout
 // ---------------------------------------------------------------------------
@@ -401,6 +466,8 @@ int main() {
     // Group 6: Thread safety
     test_concurrent_stores_produce_unique_ids();
     test_concurrent_reads_succeed();
+    test_counts_and_frees_span_shards();
+    test_concurrent_reads_during_frees_on_other_ids();
 
     std::cout << "\n=== cam_geometry.h constants and layout ===\n";
 
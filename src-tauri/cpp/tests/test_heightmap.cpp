@@ -0,0 +1,226 @@
+// test_heightmap.cpp
+//
+// Unit tests for the max-Z heightmap rasterizer in heightmap.h.
+//
+// Compiles without OCCT.
+//
+// Build:
+//   g++ -std=c++17 -I.. -pthread test_heightmap.cpp -o test_heightmap
+// Run:
+//   ./test_heightmap
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <iostream>
+
+#include "heightmap.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define ASSERT_NEAR(label, a, b, tol) \
+    do { if (std::fabs((a) - (b)) <= (tol)) pass(label); \
+         else fail(label, #a " not within " #tol " of " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+static const float kNoData = -std::numeric_limits<float>::infinity();
+
+// ---------------------------------------------------------------------------
+// Flat plates
+// ---------------------------------------------------------------------------
+
+TEST(flat_quad_fills_grid) {
+    // A quad at z = 7 covering [0,10]^2, as two triangles.
+    std::vector<double> v = {
+        0, 0, 7,  10, 0, 7,  10, 10, 7,  0, 10, 7,
+    };
+    std::vector<uint32_t> idx = {0, 1, 2, 0, 2, 3};
+
+    std::vector<float> grid(8 * 8);
+    heightmap::rasterize_max_z(v.data(), idx.data(), 2,
+                               0, 0, 10, 10, 8, 8, grid.data());
+    bool all_seven = true;
+    for (float z : grid)
+        if (std::fabs(z - 7.0f) > 1e-6f) all_seven = false;
+    ASSERT_TRUE("every covered cell reads z = 7", all_seven);
+}
+
+TEST(cells_outside_coverage_are_no_data) {
+    // The same plate sampled over a window twice its size: the outer cells
+    // have no triangle above or below them.
+    std::vector<double> v = {
+        0, 0, 7,  10, 0, 7,  10, 10, 7,  0, 10, 7,
+    };
+    std::vector<uint32_t> idx = {0, 1, 2, 0, 2, 3};
+
+    const size_t n = 20;
+    std::vector<float> grid(n * n);
+    heightmap::rasterize_max_z(v.data(), idx.data(), 2,
+                               -10, -10, 30, 30, n, n, grid.data());
+    size_t covered = 0, empty = 0;
+    for (float z : grid)
+        (z == kNoData ? empty : covered)++;
+    ASSERT_EQ("plate covers a 5x5 block of cells", covered, size_t{25});
+    ASSERT_EQ("remaining cells are -infinity", empty, n * n - 25);
+}
+
+TEST(max_of_overlapping_plates_wins) {
+    // Two stacked plates; the z = 9 one must win wherever both cover.
+    std::vector<double> v = {
+        0, 0, 3,  10, 0, 3,  10, 10, 3,  0, 10, 3,   // low plate
+        2, 2, 9,   8, 2, 9,   8,  8, 9,  2,  8, 9,   // high plate, smaller
+    };
+    std::vector<uint32_t> idx = {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7};
+
+    std::vector<float> grid(10 * 10);
+    heightmap::rasterize_max_z(v.data(), idx.data(), 4,
+                               0, 0, 10, 10, 10, 10, grid.data());
+    // Cell (5, 5) center is (5.5, 5.5): under both plates.
+    ASSERT_NEAR("overlap reads the higher plate", grid[5 * 10 + 5], 9.0f, 1e-6f);
+    // Cell (0, 0) center is (0.5, 0.5): only the low plate.
+    ASSERT_NEAR("non-overlap reads the lower plate", grid[0], 3.0f, 1e-6f);
+}
+
+// ---------------------------------------------------------------------------
+// Interpolation and orientation
+// ---------------------------------------------------------------------------
+
+TEST(sloped_plate_interpolates_z) {
+    // A ramp rising from z = 0 at x = 0 to z = 10 at x = 10.
+    std::vector<double> v = {
+        0, 0, 0,  10, 0, 10,  10, 10, 10,  0, 10, 0,
+    };
+    std::vector<uint32_t> idx = {0, 1, 2, 0, 2, 3};
+
+    const size_t n = 10;
+    std::vector<float> grid(n * n);
+    heightmap::rasterize_max_z(v.data(), idx.data(), 2,
+                               0, 0, 10, 10, n, n, grid.data());
+    bool all_match = true;
+    for (size_t iy = 0; iy < n; ++iy)
+        for (size_t ix = 0; ix < n; ++ix) {
+            const float expect = float(ix) + 0.5f;  // z equals x at the center
+            if (std::fabs(grid[iy * n + ix] - expect) > 1e-5f) all_match = false;
+        }
+    ASSERT_TRUE("ramp samples interpolate z = x", all_match);
+}
+
+TEST(winding_does_not_matter) {
+    // The same triangle in both windings rasterizes identically.
+    std::vector<double>   v   = {0, 0, 4, 10, 0, 4, 0, 10, 4};
+    std::vector<uint32_t> ccw = {0, 1, 2};
+    std::vector<uint32_t> cw  = {0, 2, 1};
+
+    std::vector<float> a(6 * 6), b(6 * 6);
+    heightmap::rasterize_max_z(v.data(), ccw.data(), 1, 0, 0, 10, 10, 6, 6, a.data());
+    heightmap::rasterize_max_z(v.data(), cw.data(), 1, 0, 0, 10, 10, 6, 6, b.data());
+    ASSERT_TRUE("CW and CCW grids are identical", a == b);
+}
+
+TEST(vertical_triangles_are_skipped) {
+    // A wall in the XZ plane has zero XY area and must not contribute.
+    std::vector<double>   v   = {0, 5, 0, 10, 5, 0, 10, 5, 10};
+    std::vector<uint32_t> idx = {0, 1, 2};
+
+    std::vector<float> grid(4 * 4);
+    heightmap::rasterize_max_z(v.data(), idx.data(), 1,
+                               0, 0, 10, 10, 4, 4, grid.data());
+    bool all_empty = true;
+    for (float z : grid)
+        if (z != kNoData) all_empty = false;
+    ASSERT_TRUE("wall leaves every cell at -infinity", all_empty);
+}
+
+// ---------------------------------------------------------------------------
+// Parallel consistency and edge cases
+// ---------------------------------------------------------------------------
+
+TEST(worker_counts_agree) {
+    // A fan of many small triangles; 1 worker and 8 workers must produce
+    // bit-identical grids (bands write disjoint rows).
+    std::vector<double>   v;
+    std::vector<uint32_t> idx;
+    const int n_seg = 64;
+    v.insert(v.end(), {5, 5, 2});
+    for (int s = 0; s <= n_seg; ++s) {
+        const double a = 2.0 * 3.14159265358979 * s / n_seg;
+        v.insert(v.end(), {5 + 4 * std::cos(a), 5 + 4 * std::sin(a),
+                           2 + std::cos(3 * a)});
+    }
+    for (uint32_t s = 0; s < uint32_t(n_seg); ++s)
+        idx.insert(idx.end(), {0, s + 1, s + 2});
+
+    const size_t n = 64;
+    std::vector<float> serial(n * n), parallel(n * n);
+    heightmap::rasterize_max_z(v.data(), idx.data(), idx.size() / 3,
+                               0, 0, 10, 10, n, n, serial.data(), 1);
+    heightmap::rasterize_max_z(v.data(), idx.data(), idx.size() / 3,
+                               0, 0, 10, 10, n, n, parallel.data(), 8);
+    ASSERT_TRUE("1-worker and 8-worker grids are identical", serial == parallel);
+}
+
+TEST(float32_vertices_rasterize) {
+    std::vector<float>    v   = {0, 0, 7, 10, 0, 7, 10, 10, 7, 0, 10, 7};
+    std::vector<uint32_t> idx = {0, 1, 2, 0, 2, 3};
+    std::vector<float> grid(4 * 4);
+    heightmap::rasterize_max_z(v.data(), idx.data(), 2,
+                               0, 0, 10, 10, 4, 4, grid.data());
+    ASSERT_NEAR("float32 mesh rasterizes", grid[0], 7.0f, 1e-6f);
+}
+
+TEST(empty_input_clears_grid) {
+    std::vector<float> grid(3 * 3, 42.0f);
+    heightmap::rasterize_max_z<double>(nullptr, nullptr, 0,
+                                       0, 0, 10, 10, 3, 3, grid.data());
+    bool all_empty = true;
+    for (float z : grid)
+        if (z != kNoData) all_empty = false;
+    ASSERT_TRUE("zero triangles leaves every cell at -infinity", all_empty);
+}
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "test_heightmap\n";
+
+    test_flat_quad_fills_grid();
+    test_cells_outside_coverage_are_no_data();
+    test_max_of_overlapping_plates_wins();
+    test_sloped_plate_interpolates_z();
+    test_winding_does_not_matter();
+    test_vertical_triangles_are_skipped();
+    test_worker_counts_agree();
+    test_float32_vertices_rasterize();
+    test_empty_input_clears_grid();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
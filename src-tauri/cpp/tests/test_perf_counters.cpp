@@ -0,0 +1,151 @@
+// test_perf_counters.cpp
+//
+// Unit tests for the performance counters and trace capture in
+// perf_counters.h.
+//
+// Compiles without OCCT.
+//
+// Build:
+//   g++ -std=c++17 -I.. test_perf_counters.cpp -o test_perf_counters
+// Run:
+//   ./test_perf_counters
+
+#include <cstring>
+#include <string>
+
+#include <iostream>
+
+#include "perf_counters.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+// ---------------------------------------------------------------------------
+// Counters
+// ---------------------------------------------------------------------------
+
+TEST(scope_records_call_time_and_bytes) {
+    perf_counters::reset();
+    {
+        perf_counters::Scope s(perf_counters::kTessellate);
+        s.add_bytes(128);
+        s.add_bytes(72);
+    }
+    const auto& c = perf_counters::g_counters[perf_counters::kTessellate];
+    ASSERT_EQ("one call recorded", c.calls.load(), uint64_t{1});
+    ASSERT_EQ("bytes accumulated across add_bytes calls",
+              c.bytes.load(), uint64_t{200});
+    ASSERT_TRUE("total time is nonzero", c.total_ns.load() > 0);
+    ASSERT_TRUE("max does not exceed total",
+                c.max_ns.load() <= c.total_ns.load());
+}
+
+TEST(max_tracks_the_slowest_call) {
+    perf_counters::reset();
+    { perf_counters::Scope s(perf_counters::kSection); }
+    const uint64_t max_after_one =
+        perf_counters::g_counters[perf_counters::kSection].max_ns.load();
+    { perf_counters::Scope s(perf_counters::kSection); }
+    const auto& c = perf_counters::g_counters[perf_counters::kSection];
+    ASSERT_EQ("two calls recorded", c.calls.load(), uint64_t{2});
+    ASSERT_TRUE("max never decreases", c.max_ns.load() >= max_after_one);
+}
+
+TEST(subsystems_are_independent) {
+    perf_counters::reset();
+    { perf_counters::Scope s(perf_counters::kImport); }
+    ASSERT_EQ("import counted",
+              perf_counters::g_counters[perf_counters::kImport].calls.load(),
+              uint64_t{1});
+    ASSERT_EQ("offset untouched",
+              perf_counters::g_counters[perf_counters::kOffset].calls.load(),
+              uint64_t{0});
+}
+
+TEST(every_subsystem_has_a_name) {
+    bool ok = true;
+    for (size_t i = 0; i < perf_counters::kSubsystemCount; ++i) {
+        const char* name =
+            perf_counters::name_of(static_cast<perf_counters::Subsystem>(i));
+        if (!name || !name[0] || std::strcmp(name, "?") == 0) ok = false;
+    }
+    ASSERT_TRUE("each subsystem maps to a real name", ok);
+}
+
+// ---------------------------------------------------------------------------
+// Trace capture
+// ---------------------------------------------------------------------------
+
+TEST(tracing_captures_events_only_while_enabled) {
+    perf_counters::reset();
+    { perf_counters::Scope s(perf_counters::kBoolean); }
+    ASSERT_EQ("disabled tracing records nothing",
+              perf_counters::trace_event_count(), size_t{0});
+
+    perf_counters::g_trace_enabled.store(true);
+    { perf_counters::Scope s(perf_counters::kBoolean); }
+    { perf_counters::Scope s(perf_counters::kEval); }
+    perf_counters::g_trace_enabled.store(false);
+
+    ASSERT_EQ("one event per scope while enabled",
+              perf_counters::trace_event_count(), size_t{2});
+    ASSERT_TRUE("events carry their subsystem",
+                perf_counters::g_trace[0].sys == perf_counters::kBoolean &&
+                    perf_counters::g_trace[1].sys == perf_counters::kEval);
+    ASSERT_TRUE("events carry a thread tag",
+                perf_counters::g_trace[0].tid != 0);
+}
+
+TEST(reset_clears_counters_and_trace) {
+    perf_counters::g_trace_enabled.store(true);
+    { perf_counters::Scope s(perf_counters::kImport); }
+    perf_counters::g_trace_enabled.store(false);
+    perf_counters::reset();
+    ASSERT_EQ("counters zeroed",
+              perf_counters::g_counters[perf_counters::kImport].calls.load(),
+              uint64_t{0});
+    ASSERT_EQ("trace discarded", perf_counters::trace_event_count(),
+              size_t{0});
+}
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "test_perf_counters\n";
+
+    test_scope_records_call_time_and_bytes();
+    test_max_tracks_the_slowest_call();
+    test_subsystems_are_independent();
+    test_every_subsystem_has_a_name();
+    test_tracing_captures_events_only_while_enabled();
+    test_reset_clears_counters_and_trace();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
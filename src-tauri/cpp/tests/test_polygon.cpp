@@ -0,0 +1,409 @@
+// test_polygon.cpp
+//
+// Unit tests for the Clipper2-backed 2D polygon operations in cam_polygon.cpp.
+//
+// Compiles without OCCT — cam_polygon.cpp depends only on the vendored
+// Clipper2 sources.
+//
+// Build:
+//   g++ -std=c++17 -I.. -I../third_party/Clipper2/Clipper2Lib/include
+//       -o test_polygon
+//       test_polygon.cpp ../cam_polygon.cpp ../cam_error.cpp
+//       ../third_party/Clipper2/Clipper2Lib/src/clipper.engine.cpp
+//       ../third_party/Clipper2/Clipper2Lib/src/clipper.offset.cpp
+//       ../third_party/Clipper2/Clipper2Lib/src/clipper.rectclip.cpp
+// Run:
+//   ./test_polygon
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "cam_geometry.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+// Shoelace area of a flat [x0,y0, x1,y1, ...] ring.
+static double ring_area(const double* pts, size_t n) {
+    double a = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const size_t j = (i + 1) % n;
+        a += pts[i * 2] * pts[j * 2 + 1] - pts[j * 2] * pts[i * 2 + 1];
+    }
+    return std::abs(a) * 0.5;
+}
+
+// 10x10 square at the origin.
+static const double kSquare[] = {0,0, 10,0, 10,10, 0,10};
+
+// ---------------------------------------------------------------------------
+// cg_poly_offset
+// ---------------------------------------------------------------------------
+
+TEST(offset_outward_grows) {
+    double* out = nullptr;
+    size_t cnt = 0;
+    CgError e = cg_poly_offset(kSquare, 4, 2.0, 0.01, &out, &cnt);
+    ASSERT_EQ("outward offset returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_TRUE("outward offset yields a polygon", out != nullptr && cnt >= 4);
+    // Square grown by 2 with rounded corners: area between the plain square
+    // (14x14 minus corner cut) and the full miter square.
+    const double a = ring_area(out, cnt);
+    ASSERT_TRUE("outward offset area between 180 and 196",
+                a > 180.0 && a < 196.0);
+    cg_poly_free(out);
+}
+
+TEST(offset_inward_shrinks) {
+    double* out = nullptr;
+    size_t cnt = 0;
+    CgError e = cg_poly_offset(kSquare, 4, -2.0, 0.01, &out, &cnt);
+    ASSERT_EQ("inward offset returns CG_OK", (int)e, (int)CG_OK);
+    const double a = ring_area(out, cnt);
+    ASSERT_TRUE("inward offset area is ~36", std::abs(a - 36.0) < 0.5);
+    cg_poly_free(out);
+}
+
+TEST(offset_collapse) {
+    double* out = nullptr;
+    size_t cnt = 99;
+    CgError e = cg_poly_offset(kSquare, 4, -6.0, 0.01, &out, &cnt);
+    ASSERT_EQ("collapsing offset returns CG_ERR_NO_RESULT",
+              (int)e, (int)CG_ERR_NO_RESULT);
+    ASSERT_EQ("collapsing offset sets *out to null", out, (double*)nullptr);
+    ASSERT_EQ("collapsing offset sets *cnt to 0", cnt, size_t{0});
+    ASSERT_TRUE("collapsing offset sets error message",
+                std::string(cg_last_error_message()).find("collapsed")
+                    != std::string::npos);
+}
+
+TEST(offset_invalid_args) {
+    double* out = nullptr;
+    size_t cnt = 0;
+    ASSERT_EQ("null points rejected",
+              (int)cg_poly_offset(nullptr, 4, 1.0, 0.01, &out, &cnt),
+              (int)CG_ERR_NULL_HANDLE);
+    ASSERT_EQ("degenerate polygon (2 points) rejected",
+              (int)cg_poly_offset(kSquare, 2, 1.0, 0.01, &out, &cnt),
+              (int)CG_ERR_INVALID_ARG);
+}
+
+// ---------------------------------------------------------------------------
+// cg_poly_offset_family
+// ---------------------------------------------------------------------------
+
+TEST(family_inward_until_collapse) {
+    double* pts = nullptr;
+    size_t* counts = nullptr;
+    double* deltas = nullptr;
+    size_t n_rings = 0;
+    // Stepover 2 inward on a 10x10 square: rings at -2 and -4, collapse at -6.
+    CgError e = cg_poly_offset_family(kSquare, 4, -2.0, 0, 0.01,
+                                      &pts, &counts, &deltas, &n_rings);
+    ASSERT_EQ("inward family returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_EQ("inward family has 2 rings", n_rings, size_t{2});
+    if (n_rings == 2) {
+        ASSERT_TRUE("ring deltas are -2 and -4",
+                    std::abs(deltas[0] + 2.0) < 1e-9 &&
+                    std::abs(deltas[1] + 4.0) < 1e-9);
+        const double a0 = ring_area(pts, counts[0]);
+        const double a1 = ring_area(pts + counts[0] * 2, counts[1]);
+        ASSERT_TRUE("ring areas decrease inward (36 then 4)",
+                    std::abs(a0 - 36.0) < 0.5 && std::abs(a1 - 4.0) < 0.5);
+    }
+    cg_poly_free(pts);
+    cg_poly_counts_free(counts);
+    cg_poly_free(deltas);
+}
+
+TEST(family_outward_bounded) {
+    double* pts = nullptr;
+    size_t* counts = nullptr;
+    double* deltas = nullptr;
+    size_t n_rings = 0;
+    CgError e = cg_poly_offset_family(kSquare, 4, 1.0, 3, 0.01,
+                                      &pts, &counts, &deltas, &n_rings);
+    ASSERT_EQ("outward family returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_EQ("outward family honors max_steps", n_rings, size_t{3});
+    if (n_rings == 3) {
+        ASSERT_TRUE("outward deltas are 1, 2, 3",
+                    std::abs(deltas[0] - 1.0) < 1e-9 &&
+                    std::abs(deltas[1] - 2.0) < 1e-9 &&
+                    std::abs(deltas[2] - 3.0) < 1e-9);
+    }
+    cg_poly_free(pts);
+    cg_poly_counts_free(counts);
+    cg_poly_free(deltas);
+}
+
+TEST(family_outward_unbounded_rejected) {
+    double* pts = nullptr;
+    size_t* counts = nullptr;
+    double* deltas = nullptr;
+    size_t n_rings = 99;
+    CgError e = cg_poly_offset_family(kSquare, 4, 1.0, 0, 0.01,
+                                      &pts, &counts, &deltas, &n_rings);
+    ASSERT_EQ("unbounded outward family rejected",
+              (int)e, (int)CG_ERR_INVALID_ARG);
+    ASSERT_EQ("rejected family sets *n_rings to 0", n_rings, size_t{0});
+}
+
+TEST(family_first_step_collapse) {
+    double* pts = nullptr;
+    size_t* counts = nullptr;
+    double* deltas = nullptr;
+    size_t n_rings = 0;
+    CgError e = cg_poly_offset_family(kSquare, 4, -6.0, 0, 0.01,
+                                      &pts, &counts, &deltas, &n_rings);
+    ASSERT_EQ("family collapsing at step 1 returns CG_ERR_NO_RESULT",
+              (int)e, (int)CG_ERR_NO_RESULT);
+    ASSERT_EQ("collapsed family yields no points", pts, (double*)nullptr);
+}
+
+TEST(family_invalid_args) {
+    double* pts = nullptr;
+    size_t* counts = nullptr;
+    double* deltas = nullptr;
+    size_t n_rings = 0;
+    ASSERT_EQ("family null points rejected",
+              (int)cg_poly_offset_family(nullptr, 4, -1.0, 0, 0.01,
+                                         &pts, &counts, &deltas, &n_rings),
+              (int)CG_ERR_NULL_HANDLE);
+    ASSERT_EQ("family zero stepover rejected",
+              (int)cg_poly_offset_family(kSquare, 4, 0.0, 5, 0.01,
+                                         &pts, &counts, &deltas, &n_rings),
+              (int)CG_ERR_INVALID_ARG);
+}
+
+// ---------------------------------------------------------------------------
+// cg_poly_boolean / cg_poly_boolean_multi
+// ---------------------------------------------------------------------------
+
+// 10x10 square at (5,0) — overlaps kSquare's right half.
+static const double kShifted[] = {5,0, 15,0, 15,10, 5,10};
+
+TEST(boolean_union_overlap) {
+    double* out = nullptr;
+    size_t cnt = 0;
+    CgError e = cg_poly_boolean(kSquare, 4, kShifted, 4, CG_BOOL_UNION,
+                                &out, &cnt);
+    ASSERT_EQ("overlapping union returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_TRUE("union area is 150", std::abs(ring_area(out, cnt) - 150.0) < 0.01);
+    cg_poly_free(out);
+}
+
+TEST(boolean_intersection) {
+    double* out = nullptr;
+    size_t cnt = 0;
+    CgError e = cg_poly_boolean(kSquare, 4, kShifted, 4, CG_BOOL_INTERSECTION,
+                                &out, &cnt);
+    ASSERT_EQ("intersection returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_TRUE("intersection area is 50", std::abs(ring_area(out, cnt) - 50.0) < 0.01);
+    cg_poly_free(out);
+}
+
+TEST(boolean_difference_empty) {
+    // Subtracting a polygon from itself leaves nothing.
+    double* out = nullptr;
+    size_t cnt = 99;
+    CgError e = cg_poly_boolean(kSquare, 4, kSquare, 4, CG_BOOL_DIFFERENCE,
+                                &out, &cnt);
+    ASSERT_EQ("self-difference returns CG_ERR_NO_RESULT",
+              (int)e, (int)CG_ERR_NO_RESULT);
+    ASSERT_EQ("self-difference sets *out to null", out, (double*)nullptr);
+}
+
+TEST(boolean_multi_disjoint_union) {
+    // Two disjoint squares in one subject set, no clips: union keeps both.
+    const double pts[] = {0,0, 10,0, 10,10, 0,10,   20,0, 30,0, 30,10, 20,10};
+    const size_t counts[] = {4, 4};
+    double* out = nullptr;
+    size_t* out_counts = nullptr;
+    size_t n_rings = 0;
+    CgError e = cg_poly_boolean_multi(pts, counts, 2, nullptr, nullptr, 0,
+                                      CG_BOOL_UNION, &out, &out_counts, &n_rings);
+    ASSERT_EQ("disjoint union returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_EQ("disjoint union keeps 2 rings", n_rings, size_t{2});
+    cg_poly_free(out);
+    cg_poly_counts_free(out_counts);
+}
+
+TEST(boolean_multi_hole) {
+    // Difference of a small square out of the big one leaves a ring with a
+    // hole: 2 result rings, net area 100 - 4.
+    const double inner[] = {3,3, 7,3, 7,7, 3,7};
+    const size_t subj_counts[] = {4};
+    const size_t clip_counts[] = {4};
+    double* out = nullptr;
+    size_t* out_counts = nullptr;
+    size_t n_rings = 0;
+    CgError e = cg_poly_boolean_multi(kSquare, subj_counts, 1,
+                                      inner, clip_counts, 1,
+                                      CG_BOOL_DIFFERENCE,
+                                      &out, &out_counts, &n_rings);
+    ASSERT_EQ("hole difference returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_EQ("hole difference yields 2 rings", n_rings, size_t{2});
+    if (n_rings == 2) {
+        const double a0 = ring_area(out, out_counts[0]);
+        const double a1 = ring_area(out + out_counts[0] * 2, out_counts[1]);
+        ASSERT_TRUE("outer ring is 100, hole is 16",
+                    std::abs(a0 + a1 - 116.0) < 0.01);
+    }
+    cg_poly_free(out);
+    cg_poly_counts_free(out_counts);
+}
+
+TEST(boolean_multi_empty_result_ok) {
+    // Unlike the pairwise API, an empty result is CG_OK with 0 rings.
+    const size_t counts[] = {4};
+    double* out = nullptr;
+    size_t* out_counts = nullptr;
+    size_t n_rings = 99;
+    CgError e = cg_poly_boolean_multi(kSquare, counts, 1, kSquare, counts, 1,
+                                      CG_BOOL_DIFFERENCE,
+                                      &out, &out_counts, &n_rings);
+    ASSERT_EQ("empty multi result returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_EQ("empty multi result has 0 rings", n_rings, size_t{0});
+    ASSERT_EQ("empty multi result nulls *out", out, (double*)nullptr);
+}
+
+// ---------------------------------------------------------------------------
+// Persistent clipper engine
+// ---------------------------------------------------------------------------
+
+TEST(clipper_incremental_union) {
+    CgClipperId id = cg_clipper_new();
+    ASSERT_TRUE("cg_clipper_new returns a handle", id != CG_NULL_ID);
+
+    const size_t counts[] = {4};
+    ASSERT_EQ("add first footprint",
+              (int)cg_clipper_add_subject(id, kSquare, counts, 1), (int)CG_OK);
+
+    double* out = nullptr;
+    size_t* out_counts = nullptr;
+    size_t n_rings = 0;
+    CgError e = cg_clipper_execute(id, CG_BOOL_UNION, &out, &out_counts, &n_rings);
+    ASSERT_EQ("first execute returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_EQ("first union has 1 ring", n_rings, size_t{1});
+    double area1 = (n_rings == 1) ? ring_area(out, out_counts[0]) : 0.0;
+    ASSERT_TRUE("first union area is 100", std::abs(area1 - 100.0) < 0.01);
+    cg_poly_free(out);
+    cg_poly_counts_free(out_counts);
+
+    // Add one more footprint WITHOUT re-feeding the first: inputs survive
+    // execute, so the union grows incrementally.
+    ASSERT_EQ("add second footprint",
+              (int)cg_clipper_add_subject(id, kShifted, counts, 1), (int)CG_OK);
+    out = nullptr; out_counts = nullptr; n_rings = 0;
+    e = cg_clipper_execute(id, CG_BOOL_UNION, &out, &out_counts, &n_rings);
+    ASSERT_EQ("second execute returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_EQ("second union has 1 ring", n_rings, size_t{1});
+    double area2 = (n_rings == 1) ? ring_area(out, out_counts[0]) : 0.0;
+    ASSERT_TRUE("accumulated union area is 150", std::abs(area2 - 150.0) < 0.01);
+    cg_poly_free(out);
+    cg_poly_counts_free(out_counts);
+
+    cg_clipper_free(id);
+}
+
+TEST(clipper_difference_with_clips) {
+    CgClipperId id = cg_clipper_new();
+    const double inner[] = {3,3, 7,3, 7,7, 3,7};
+    const size_t counts[] = {4};
+    cg_clipper_add_subject(id, kSquare, counts, 1);
+    cg_clipper_add_clip(id, inner, counts, 1);
+
+    double* out = nullptr;
+    size_t* out_counts = nullptr;
+    size_t n_rings = 0;
+    CgError e = cg_clipper_execute(id, CG_BOOL_DIFFERENCE,
+                                   &out, &out_counts, &n_rings);
+    ASSERT_EQ("engine difference returns CG_OK", (int)e, (int)CG_OK);
+    ASSERT_EQ("engine difference yields outer + hole", n_rings, size_t{2});
+    cg_poly_free(out);
+    cg_poly_counts_free(out_counts);
+    cg_clipper_free(id);
+}
+
+TEST(clipper_invalid_handles) {
+    const size_t counts[] = {4};
+    double* out = nullptr;
+    size_t* out_counts = nullptr;
+    size_t n_rings = 0;
+    ASSERT_EQ("add to null handle rejected",
+              (int)cg_clipper_add_subject(CG_NULL_ID, kSquare, counts, 1),
+              (int)CG_ERR_NULL_HANDLE);
+    ASSERT_EQ("execute on unknown handle rejected",
+              (int)cg_clipper_execute(999999, CG_BOOL_UNION,
+                                      &out, &out_counts, &n_rings),
+              (int)CG_ERR_NULL_HANDLE);
+    cg_clipper_free(CG_NULL_ID);
+    pass("cg_clipper_free(CG_NULL_ID) does not crash");
+}
+
+// ---------------------------------------------------------------------------
+// Runner
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "=== cam_polygon tests ===\n";
+
+    std::cout << "\n-- cg_poly_offset --\n";
+    test_offset_outward_grows();
+    test_offset_inward_shrinks();
+    test_offset_collapse();
+    test_offset_invalid_args();
+
+    std::cout << "\n-- cg_poly_offset_family --\n";
+    test_family_inward_until_collapse();
+    test_family_outward_bounded();
+    test_family_outward_unbounded_rejected();
+    test_family_first_step_collapse();
+    test_family_invalid_args();
+
+    std::cout << "\n-- cg_poly_boolean / cg_poly_boolean_multi --\n";
+    test_boolean_union_overlap();
+    test_boolean_intersection();
+    test_boolean_difference_empty();
+    test_boolean_multi_disjoint_union();
+    test_boolean_multi_hole();
+    test_boolean_multi_empty_result_ok();
+
+    std::cout << "\n-- persistent clipper engine --\n";
+    test_clipper_incremental_union();
+    test_clipper_difference_with_clips();
+    test_clipper_invalid_handles();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+// test_section_chaining.cpp
+//
+// Unit tests for chain_section_segments() in section_chaining.cpp.
+//
+// Compiles without OCCT — the chaining module only depends on CgPoint3 from
+// cam_geometry.h.
+//
+// Build:
+//   g++ -std=c++17 -I.. -o test_section_chaining
+//       test_section_chaining.cpp ../section_chaining.cpp
+// Run:
+//   ./test_section_chaining
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "section_chaining.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+static CgPoint3 P(double x, double y, double z = 0.0) { return CgPoint3{x, y, z}; }
+
+// Append a segment (start, end) to the soup.
+static void seg(std::vector<CgPoint3>& soup, CgPoint3 a, CgPoint3 b) {
+    soup.push_back(a);
+    soup.push_back(b);
+}
+
+static bool near_xy(const CgPoint3& a, const CgPoint3& b, double tol = 1e-9) {
+    return std::abs(a.x - b.x) <= tol && std::abs(a.y - b.y) <= tol;
+}
+
+// True if `loop` visits exactly the given corner points (any rotation,
+// already assumed CCW).
+static bool loop_matches(const std::vector<CgPoint3>& loop,
+                         const std::vector<CgPoint3>& corners) {
+    if (loop.size() != corners.size()) return false;
+    for (size_t rot = 0; rot < loop.size(); ++rot) {
+        bool ok = true;
+        for (size_t i = 0; i < corners.size() && ok; ++i) {
+            ok = near_xy(loop[(rot + i) % loop.size()], corners[i]);
+        }
+        if (ok) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(empty_input_gives_no_loops) {
+    std::vector<CgPoint3> soup;
+    auto loops = chain_section_segments(soup, 1e-6);
+    ASSERT_EQ("empty soup -> no loops", loops.size(), size_t{0});
+}
+
+TEST(shuffled_square_chains_to_one_closed_ccw_loop) {
+    // Unit square; segments deliberately out of order and with mixed
+    // directions.
+    std::vector<CgPoint3> soup;
+    seg(soup, P(1, 1), P(0, 1));  // top, right-to-left
+    seg(soup, P(0, 0), P(1, 0));  // bottom
+    seg(soup, P(0, 0), P(0, 1));  // left, bottom-to-top (reversed sense)
+    seg(soup, P(1, 0), P(1, 1));  // right
+
+    auto loops = chain_section_segments(soup, 1e-6);
+    ASSERT_EQ("square -> one loop", loops.size(), size_t{1});
+    if (loops.size() != 1) return;
+
+    ASSERT_EQ("loop has 4 vertices (first point not repeated)",
+              loops[0].size(), size_t{4});
+    ASSERT_TRUE("loop is counter-clockwise",
+                polygon_signed_area_xy(loops[0]) > 0.0);
+    ASSERT_TRUE("loop visits the square's corners",
+                loop_matches(loops[0], {P(0, 0), P(1, 0), P(1, 1), P(0, 1)}));
+}
+
+TEST(clockwise_input_is_normalized_to_ccw) {
+    std::vector<CgPoint3> soup;
+    seg(soup, P(0, 0), P(0, 1));
+    seg(soup, P(0, 1), P(1, 1));
+    seg(soup, P(1, 1), P(1, 0));
+    seg(soup, P(1, 0), P(0, 0));
+
+    auto loops = chain_section_segments(soup, 1e-6);
+    ASSERT_EQ("cw square -> one loop", loops.size(), size_t{1});
+    if (loops.size() != 1) return;
+    ASSERT_TRUE("cw input normalized to ccw",
+                polygon_signed_area_xy(loops[0]) > 0.0);
+}
+
+TEST(two_disjoint_squares_give_two_loops) {
+    std::vector<CgPoint3> soup;
+    // Square A at origin.
+    seg(soup, P(0, 0), P(1, 0));
+    seg(soup, P(1, 0), P(1, 1));
+    seg(soup, P(1, 1), P(0, 1));
+    seg(soup, P(0, 1), P(0, 0));
+    // Square B far away, interleaved into the soup.
+    seg(soup, P(10, 10), P(11, 10));
+    seg(soup, P(11, 10), P(11, 11));
+    seg(soup, P(11, 11), P(10, 11));
+    seg(soup, P(10, 11), P(10, 10));
+
+    auto loops = chain_section_segments(soup, 1e-6);
+    ASSERT_EQ("two squares -> two loops", loops.size(), size_t{2});
+    size_t total = 0;
+    for (const auto& loop : loops) total += loop.size();
+    ASSERT_EQ("8 vertices in total", total, size_t{8});
+}
+
+TEST(endpoints_jittered_within_tolerance_still_chain) {
+    const double jitter = 1e-5;  // below the 1e-4 matching tolerance
+    std::vector<CgPoint3> soup;
+    seg(soup, P(0, 0), P(1, 0));
+    seg(soup, P(1 + jitter, jitter), P(1, 1));
+    seg(soup, P(1 - jitter, 1 + jitter), P(0, 1));
+    seg(soup, P(jitter, 1 - jitter), P(0, 0));
+
+    auto loops = chain_section_segments(soup, 1e-4);
+    ASSERT_EQ("jittered square -> one loop", loops.size(), size_t{1});
+    if (loops.size() == 1) {
+        ASSERT_EQ("jittered loop has 4 vertices", loops[0].size(), size_t{4});
+    }
+}
+
+TEST(open_polyline_is_returned_unclosed) {
+    std::vector<CgPoint3> soup;
+    seg(soup, P(1, 0), P(2, 0));  // middle first — backward extension needed
+    seg(soup, P(0, 0), P(1, 0));
+    seg(soup, P(2, 0), P(3, 0));
+
+    auto loops = chain_section_segments(soup, 1e-6);
+    ASSERT_EQ("open chain -> one polyline", loops.size(), size_t{1});
+    if (loops.size() != 1) return;
+    ASSERT_EQ("open polyline has 4 vertices", loops[0].size(), size_t{4});
+    ASSERT_TRUE("open polyline spans from (0,0) to (3,0)",
+                (near_xy(loops[0].front(), P(0, 0)) &&
+                 near_xy(loops[0].back(), P(3, 0))) ||
+                (near_xy(loops[0].front(), P(3, 0)) &&
+                 near_xy(loops[0].back(), P(0, 0))));
+}
+
+TEST(signed_area_helper) {
+    std::vector<CgPoint3> ccw = {P(0, 0), P(1, 0), P(1, 1), P(0, 1)};
+    std::vector<CgPoint3> cw(ccw.rbegin(), ccw.rend());
+    ASSERT_TRUE("ccw unit square area == +1",
+                std::abs(polygon_signed_area_xy(ccw) - 1.0) < 1e-12);
+    ASSERT_TRUE("cw unit square area == -1",
+                std::abs(polygon_signed_area_xy(cw) + 1.0) < 1e-12);
+}
+
+// ---------------------------------------------------------------------------
+// Runner
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "=== section_chaining unit tests ===\n";
+
+    test_empty_input_gives_no_loops();
+    test_shuffled_square_chains_to_one_closed_ccw_loop();
+    test_clockwise_input_is_normalized_to_ccw();
+    test_two_disjoint_squares_give_two_loops();
+    test_endpoints_jittered_within_tolerance_still_chain();
+    test_open_polyline_is_returned_unclosed();
+    test_signed_area_helper();
+
+    std::cout << "\n=== Results: " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail > 0 ? 1 : 0;
+}
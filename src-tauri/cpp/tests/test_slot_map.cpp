@@ -0,0 +1,223 @@
+// test_slot_map.cpp
+//
+// Unit tests for the generation-tagged slot arena in slot_map.h.
+//
+// Compiles without OCCT.
+//
+// Build:
+//   g++ -std=c++17 -I.. -pthread test_slot_map.cpp -o test_slot_map
+// Run:
+//   ./test_slot_map
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <iostream>
+
+#include "slot_map.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+// ---------------------------------------------------------------------------
+// Basic lifecycle
+// ---------------------------------------------------------------------------
+
+TEST(insert_get_roundtrip) {
+    SlotMap<std::string> map;
+    uint64_t id = map.insert(std::make_shared<std::string>("hello"));
+    ASSERT_TRUE("insert returns a non-null ID", id != 0);
+    ASSERT_TRUE("get finds the value", map.get(id) != nullptr);
+    ASSERT_EQ("get returns the stored value", *map.get(id), std::string("hello"));
+    ASSERT_EQ("size is 1", map.size(), size_t{1});
+}
+
+TEST(invalid_ids_miss) {
+    SlotMap<std::string> map;
+    map.insert(std::make_shared<std::string>("x"));
+    ASSERT_EQ("get(0) is null", map.get(0), (std::string*)nullptr);
+    ASSERT_EQ("get(garbage) is null", map.get(0xdeadbeefdeadbeef),
+              (std::string*)nullptr);
+    ASSERT_TRUE("erase(garbage) returns null",
+                map.erase(0xdeadbeefdeadbeef) == nullptr);
+}
+
+TEST(erase_invalidates_id) {
+    SlotMap<std::string> map;
+    uint64_t id = map.insert(std::make_shared<std::string>("gone"));
+    auto out = map.erase(id);
+    ASSERT_TRUE("erase returns the value", out && *out == "gone");
+    ASSERT_EQ("stale ID misses after erase", map.get(id), (std::string*)nullptr);
+    ASSERT_TRUE("double erase returns null", map.erase(id) == nullptr);
+    ASSERT_EQ("size is 0 after erase", map.size(), size_t{0});
+}
+
+TEST(slot_reuse_gets_fresh_generation) {
+    SlotMap<std::string> map;
+    uint64_t id1 = map.insert(std::make_shared<std::string>("first"));
+    map.erase(id1);
+    uint64_t id2 = map.insert(std::make_shared<std::string>("second"));
+    // The freed slot is recycled, but the generation differs.
+    ASSERT_EQ("recycled slot has the same index",
+              id1 & 0xffffffffu, id2 & 0xffffffffu);
+    ASSERT_TRUE("recycled ID differs from the stale one", id1 != id2);
+    ASSERT_EQ("stale ID still misses after reuse", map.get(id1),
+              (std::string*)nullptr);
+    ASSERT_EQ("fresh ID resolves to the new value", *map.get(id2),
+              std::string("second"));
+}
+
+TEST(get_shared_extends_lifetime) {
+    SlotMap<std::string> map;
+    uint64_t id = map.insert(std::make_shared<std::string>("pinned"));
+    std::shared_ptr<std::string> pin = map.get_shared(id);
+    map.erase(id);
+    ASSERT_TRUE("shared_ptr keeps the value alive after erase",
+                pin && *pin == "pinned");
+}
+
+TEST(growth_across_chunks) {
+    SlotMap<int> map;
+    const size_t n = SlotMap<int>::kChunkSize * 2 + 10;
+    std::vector<uint64_t> ids;
+    for (size_t i = 0; i < n; ++i)
+        ids.push_back(map.insert(std::make_shared<int>(static_cast<int>(i))));
+    bool all_resolve = true;
+    for (size_t i = 0; i < n; ++i) {
+        int* v = map.get(ids[i]);
+        if (!v || *v != static_cast<int>(i)) all_resolve = false;
+    }
+    ASSERT_TRUE("entries across chunk boundaries all resolve", all_resolve);
+    ASSERT_EQ("size spans chunks", map.size(), n);
+}
+
+TEST(snapshot_lists_live_entries) {
+    SlotMap<std::string> map;
+    uint64_t a = map.insert(std::make_shared<std::string>("a"));
+    uint64_t b = map.insert(std::make_shared<std::string>("b"));
+    uint64_t c = map.insert(std::make_shared<std::string>("c"));
+    map.erase(b);
+
+    auto live = map.snapshot();
+    ASSERT_EQ("snapshot lists only live entries", live.size(), size_t{2});
+    ASSERT_TRUE("snapshot preserves slot order and pairs IDs with values",
+                live[0].first == a && *live[0].second == "a" &&
+                live[1].first == c && *live[1].second == "c");
+
+    map.erase(a);
+    ASSERT_TRUE("snapshot's shared_ptr keeps an erased value alive",
+                *live[0].second == "a");
+}
+
+// ---------------------------------------------------------------------------
+// Thread safety
+// ---------------------------------------------------------------------------
+
+TEST(concurrent_inserts_produce_unique_ids) {
+    SlotMap<int> map;
+    constexpr int N_THREADS    = 8;
+    constexpr int N_PER_THREAD = 200;
+
+    std::vector<std::vector<uint64_t>> ids(N_THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < N_THREADS; ++t) {
+        threads.emplace_back([&map, &ids, t]() {
+            for (int i = 0; i < N_PER_THREAD; ++i)
+                ids[t].push_back(map.insert(std::make_shared<int>(t)));
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    std::set<uint64_t> all_ids;
+    for (const auto& thread_ids : ids)
+        for (uint64_t id : thread_ids)
+            all_ids.insert(id);
+    ASSERT_EQ("concurrent inserts: all IDs unique",
+              all_ids.size(), size_t{N_THREADS * N_PER_THREAD});
+    ASSERT_EQ("concurrent inserts: all entries live",
+              map.size(), size_t{N_THREADS * N_PER_THREAD});
+}
+
+TEST(concurrent_reads_during_churn_on_other_ids) {
+    SlotMap<int> map;
+    constexpr int N_KEEP = 100;
+    std::vector<uint64_t> keep_ids;
+    for (int i = 0; i < N_KEEP; ++i)
+        keep_ids.push_back(map.insert(std::make_shared<int>(i)));
+
+    std::atomic<int> read_errors{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int pass = 0; pass < 200; ++pass)
+                for (int i = 0; i < N_KEEP; ++i) {
+                    int* v = map.get(keep_ids[i]);
+                    if (!v || *v != i)
+                        read_errors.fetch_add(1, std::memory_order_relaxed);
+                }
+        });
+    }
+    // Churn unrelated entries (insert + erase) while the readers run.
+    threads.emplace_back([&map]() {
+        for (int i = 0; i < 2000; ++i) {
+            uint64_t id = map.insert(std::make_shared<int>(-1));
+            map.erase(id);
+        }
+    });
+    for (auto& th : threads) th.join();
+
+    ASSERT_EQ("reads stay correct during unrelated churn", read_errors.load(), 0);
+    ASSERT_EQ("churned entries all freed", map.size(), size_t{N_KEEP});
+}
+
+// ---------------------------------------------------------------------------
+// Runner
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "=== slot_map unit tests ===\n";
+
+    std::cout << "\n-- lifecycle --\n";
+    test_insert_get_roundtrip();
+    test_invalid_ids_miss();
+    test_erase_invalidates_id();
+    test_slot_reuse_gets_fresh_generation();
+    test_get_shared_extends_lifetime();
+    test_growth_across_chunks();
+    test_snapshot_lists_live_entries();
+
+    std::cout << "\n-- thread safety --\n";
+    test_concurrent_inserts_produce_unique_ids();
+    test_concurrent_reads_during_churn_on_other_ids();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+// test_stl_import.cpp
+//
+// Unit tests for the memory-mapped binary STL parser in stl_import.h.
+//
+// Compiles without OCCT.
+//
+// Build:
+//   g++ -std=c++17 -I.. -pthread test_stl_import.cpp -o test_stl_import
+// Run:
+//   ./test_stl_import
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <iostream>
+
+#include "stl_import.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define ASSERT_NEAR(label, a, b, tol) \
+    do { if (std::fabs((a) - (b)) <= (tol)) pass(label); \
+         else fail(label, #a " not within " #tol " of " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+// ---------------------------------------------------------------------------
+// Fixtures
+// ---------------------------------------------------------------------------
+
+// Serialize triangles (9 floats each) as a binary STL blob with a garbage
+// stored normal (parsers must recompute from the winding).
+static std::vector<uint8_t> make_binary_stl(
+    const std::vector<std::array<float, 9>>& tris) {
+    std::vector<uint8_t> out(stl_import::kHeaderSize +
+                             tris.size() * stl_import::kRecordSize, 0);
+    const uint32_t n = uint32_t(tris.size());
+    std::memcpy(out.data() + 80, &n, sizeof n);
+    uint8_t* rec = out.data() + stl_import::kHeaderSize;
+    for (const auto& t : tris) {
+        const float junk[3] = {9.0f, 9.0f, 9.0f};
+        std::memcpy(rec, junk, sizeof junk);
+        std::memcpy(rec + 12, t.data(), 9 * sizeof(float));
+        rec += stl_import::kRecordSize;
+    }
+    return out;
+}
+
+static std::string write_temp(const std::vector<uint8_t>& bytes) {
+    const std::string path = "test_stl_import.tmp.stl";
+    FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), f);
+    std::fclose(f);
+    return path;
+}
+
+// ---------------------------------------------------------------------------
+// Header validation
+// ---------------------------------------------------------------------------
+
+TEST(header_validation) {
+    auto blob = make_binary_stl({{{0,0,0, 1,0,0, 0,1,0}}});
+    uint32_t n = 0;
+    ASSERT_TRUE("valid binary header accepted",
+                stl_import::binary_triangle_count(blob.data(), blob.size(), n));
+    ASSERT_EQ("triangle count read from the header", n, uint32_t{1});
+
+    ASSERT_TRUE("truncated file rejected",
+                !stl_import::binary_triangle_count(blob.data(),
+                                                   blob.size() - 1, n));
+
+    std::vector<uint8_t> ascii(200, ' ');
+    std::memcpy(ascii.data(), "solid box", 9);
+    ASSERT_TRUE("ASCII file rejected by the size check",
+                !stl_import::binary_triangle_count(ascii.data(), ascii.size(),
+                                                   n));
+}
+
+// ---------------------------------------------------------------------------
+// Parsing
+// ---------------------------------------------------------------------------
+
+TEST(parse_through_a_mapped_file) {
+    auto blob = make_binary_stl({{{0,0,0, 2,0,0, 0,2,0}},
+                                 {{2,0,0, 2,2,0, 0,2,0}}});
+    const std::string path = write_temp(blob);
+
+    stl_import::FileMapping map;
+    ASSERT_TRUE("file maps", map.open(path.c_str()));
+    ASSERT_EQ("mapped size matches", map.size(), blob.size());
+
+    uint32_t n = 0;
+    ASSERT_TRUE("header validates through the map",
+                stl_import::binary_triangle_count(map.data(), map.size(), n));
+
+    std::vector<double> v, nrm;
+    std::vector<uint32_t> idx;
+    stl_import::parse_binary(map.data(), n, v, nrm, idx);
+    ASSERT_EQ("six unshared vertices", v.size(), size_t{18});
+    ASSERT_EQ("six indices", idx.size(), size_t{6});
+    ASSERT_NEAR("second triangle's first x", v[9], 2.0, 0.0);
+
+    // Stored (junk) normals are ignored; winding says +Z, area weighted.
+    ASSERT_NEAR("recomputed normal is +Z area-weighted", nrm[2], 4.0, 1e-12);
+    ASSERT_NEAR("normal x is zero", nrm[0], 0.0, 0.0);
+
+    map.close();
+    std::remove(path.c_str());
+}
+
+TEST(worker_counts_agree) {
+    // Enough triangles to span several parse chunks.
+    std::vector<std::array<float, 9>> tris;
+    for (int i = 0; i < 10000; ++i) {
+        const float x = float(i % 100), y = float(i / 100);
+        tris.push_back({x,y,0, x+1,y,0, x,y+1,0});
+    }
+    auto blob = make_binary_stl(tris);
+    uint32_t n = 0;
+    stl_import::binary_triangle_count(blob.data(), blob.size(), n);
+
+    std::vector<float> v1, n1, v8, n8;
+    std::vector<uint32_t> i1, i8;
+    stl_import::parse_binary(blob.data(), n, v1, n1, i1, 1);
+    stl_import::parse_binary(blob.data(), n, v8, n8, i8, 8);
+    ASSERT_TRUE("1- and 8-worker parses are identical",
+                v1 == v8 && n1 == n8 && i1 == i8);
+    ASSERT_EQ("vertex count scales with triangles", v1.size(), size_t{90000});
+}
+
+TEST(missing_file_fails_to_map) {
+    stl_import::FileMapping map;
+    ASSERT_TRUE("nonexistent path refuses to map",
+                !map.open("no_such_file.stl"));
+}
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "test_stl_import\n";
+
+    test_header_validation();
+    test_parse_through_a_mapped_file();
+    test_worker_counts_agree();
+    test_missing_file_fails_to_map();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+// test_weld.cpp
+//
+// Unit tests for the vertex welding helper in mesh_weld.h.
+//
+// Compiles without OCCT.
+//
+// Build:
+//   g++ -std=c++17 -I.. test_weld.cpp -o test_weld
+// Run:
+//   ./test_weld
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <iostream>
+
+#include "mesh_weld.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define ASSERT_NEAR(label, a, b, tol) \
+    do { if (std::fabs((a) - (b)) <= (tol)) pass(label); \
+         else fail(label, #a " not within " #tol " of " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+// Two abutting triangles stored unwelded: the shared edge's endpoints appear
+// twice (vertices 1/2 and 3/4 coincide).
+static void make_quad(std::vector<double>& v, std::vector<double>& n,
+                      std::vector<uint32_t>& idx, double jitter = 0.0) {
+    v = {0, 0, 0,   1, 0, 0,          1, 1, 0,
+         1, 0, jitter,  0, 1, 0,      1, 1, jitter};
+    // Unnormalized per-vertex normals as assembly would accumulate them.
+    n.assign(v.size(), 0.0);
+    for (size_t i = 2; i < n.size(); i += 3) n[i] = 0.5;
+    idx = {0, 1, 2, 3, 4, 5};
+}
+
+// ---------------------------------------------------------------------------
+// Welding
+// ---------------------------------------------------------------------------
+
+TEST(coincident_vertices_merge) {
+    std::vector<double> v, n;
+    std::vector<uint32_t> idx;
+    make_quad(v, n, idx);
+
+    const size_t welded = mesh_weld::weld(v, n, idx, 1e-6);
+    ASSERT_EQ("six vertices weld to four", welded, size_t{4});
+    ASSERT_EQ("vertex buffer shrank to match", v.size(), size_t{12});
+    ASSERT_EQ("both triangles survive", idx.size(), size_t{6});
+    for (uint32_t i : idx)
+        ASSERT_TRUE("indices stay in range", i < welded);
+}
+
+TEST(normals_accumulate_across_the_seam) {
+    std::vector<double> v, n;
+    std::vector<uint32_t> idx;
+    make_quad(v, n, idx);
+    mesh_weld::weld(v, n, idx, 1e-6);
+
+    // The two seam vertices absorbed both copies' contributions.
+    int doubled = 0;
+    for (size_t i = 0; i < v.size() / 3; ++i)
+        if (std::fabs(n[i * 3 + 2] - 1.0) < 1e-12) ++doubled;
+    ASSERT_EQ("both seam vertices carry the summed normal", doubled, 2);
+}
+
+TEST(tolerance_controls_merging) {
+    std::vector<double> v, n;
+    std::vector<uint32_t> idx;
+
+    // Seam copies jittered 1e-4 apart: a tight weld keeps them distinct,
+    // a loose one merges them.
+    make_quad(v, n, idx, 1e-4);
+    ASSERT_EQ("tight tolerance keeps jittered seam split",
+              mesh_weld::weld(v, n, idx, 1e-6), size_t{6});
+
+    make_quad(v, n, idx, 1e-4);
+    ASSERT_EQ("loose tolerance welds the jittered seam",
+              mesh_weld::weld(v, n, idx, 1e-3), size_t{4});
+}
+
+TEST(degenerate_triangles_are_dropped) {
+    // A sliver whose three corners all weld to one point.
+    std::vector<double> v = {0, 0, 0,  1e-9, 0, 0,  0, 1e-9, 0};
+    std::vector<double> n(9, 0.0);
+    std::vector<uint32_t> idx = {0, 1, 2};
+    ASSERT_EQ("sliver collapses to one vertex",
+              mesh_weld::weld(v, n, idx, 1e-6), size_t{1});
+    ASSERT_TRUE("collapsed triangle is removed", idx.empty());
+}
+
+TEST(float_buffers_weld_too) {
+    std::vector<float> v = {0, 0, 0,  1, 0, 0,  0, 1, 0,
+                            1, 0, 0,  0, 1, 0,  1, 1, 0};
+    std::vector<float> n(v.size(), 0.0f);
+    std::vector<uint32_t> idx = {0, 1, 2, 3, 4, 5};
+    ASSERT_EQ("f32 quad welds to four vertices",
+              mesh_weld::weld(v, n, idx, 1e-6), size_t{4});
+}
+
+TEST(empty_input_is_fine) {
+    std::vector<double> v, n;
+    std::vector<uint32_t> idx;
+    ASSERT_EQ("welding an empty mesh returns 0",
+              mesh_weld::weld(v, n, idx, 1e-6), size_t{0});
+}
+
+TEST(empty_normals_weld_positions_only) {
+    // Lazy-normal meshes weld before any normal buffer exists.
+    std::vector<double> v, n, no_normals;
+    std::vector<uint32_t> idx;
+    make_quad(v, n, idx);
+
+    ASSERT_EQ("quad without normals welds to four vertices",
+              mesh_weld::weld(v, no_normals, idx, 1e-6), size_t{4});
+    ASSERT_TRUE("normals stay empty", no_normals.empty());
+    ASSERT_EQ("both triangles survive", idx.size(), size_t{6});
+}
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "test_weld\n";
+
+    test_coincident_vertices_merge();
+    test_normals_accumulate_across_the_seam();
+    test_tolerance_controls_merging();
+    test_degenerate_triangles_are_dropped();
+    test_float_buffers_weld_too();
+    test_empty_input_is_fine();
+    test_empty_normals_weld_positions_only();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
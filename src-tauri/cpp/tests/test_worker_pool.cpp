@@ -0,0 +1,138 @@
+// test_worker_pool.cpp
+//
+// Unit tests for the kernel worker budget and fork-join helper in
+// worker_pool.h.
+//
+// Compiles without OCCT.
+//
+// Build:
+//   g++ -std=c++17 -I.. -pthread test_worker_pool.cpp -o test_worker_pool
+// Run:
+//   ./test_worker_pool
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <iostream>
+
+#include "worker_pool.h"
+
+// ---------------------------------------------------------------------------
+// Minimal test framework (same style as test_handle_registry.cpp)
+// ---------------------------------------------------------------------------
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+static void pass(const char* label) {
+    std::cout << "  PASS: " << label << "\n";
+    ++g_pass;
+}
+
+static void fail(const char* label, const char* reason = "") {
+    std::cout << "  FAIL: " << label;
+    if (reason && reason[0]) std::cout << " (" << reason << ")";
+    std::cout << "\n";
+    ++g_fail;
+}
+
+#define ASSERT_TRUE(label, cond) \
+    do { if (cond) pass(label); else fail(label, #cond " is false"); } while (0)
+
+#define ASSERT_EQ(label, a, b) \
+    do { if ((a) == (b)) pass(label); else fail(label, #a " != " #b); } while (0)
+
+#define TEST(name) static void test_##name()
+
+// ---------------------------------------------------------------------------
+// Budget
+// ---------------------------------------------------------------------------
+
+TEST(budget_controls_effective) {
+    worker_pool::set_budget(3);
+    ASSERT_EQ("explicit budget is reported", worker_pool::effective(),
+              size_t{3});
+    worker_pool::set_budget(0);
+    ASSERT_TRUE("auto budget is at least one worker",
+                worker_pool::effective() >= 1);
+}
+
+// ---------------------------------------------------------------------------
+// parallel_for
+// ---------------------------------------------------------------------------
+
+TEST(every_index_runs_exactly_once) {
+    worker_pool::set_budget(8);
+    const size_t n = 10000;
+    std::vector<std::atomic<int>> hits(n);
+    worker_pool::parallel_for(n, 64, [&](size_t i) {
+        hits[i].fetch_add(1, std::memory_order_relaxed);
+    });
+    bool ok = true;
+    for (const auto& h : hits)
+        if (h.load() != 1) ok = false;
+    ASSERT_TRUE("each index executed exactly once", ok);
+    worker_pool::set_budget(0);
+}
+
+TEST(budget_of_one_runs_inline) {
+    worker_pool::set_budget(1);
+    const uint64_t batches_before = worker_pool::g_batches.load();
+    std::atomic<size_t> count{0};
+    worker_pool::parallel_for(1000, 16, [&](size_t) { ++count; });
+    ASSERT_EQ("all items ran", count.load(), size_t{1000});
+    ASSERT_EQ("a budget of one never forks",
+              worker_pool::g_batches.load(), batches_before);
+    worker_pool::set_budget(0);
+}
+
+TEST(stats_count_forked_batches) {
+    worker_pool::set_budget(4);
+    const uint64_t batches_before = worker_pool::g_batches.load();
+    const uint64_t tasks_before   = worker_pool::g_tasks.load();
+    worker_pool::parallel_for(500, 8, [](size_t) {});
+    ASSERT_EQ("one batch recorded",
+              worker_pool::g_batches.load(), batches_before + 1);
+    ASSERT_EQ("all tasks recorded",
+              worker_pool::g_tasks.load(), tasks_before + 500);
+    worker_pool::set_budget(0);
+}
+
+TEST(exceptions_reach_the_caller) {
+    worker_pool::set_budget(4);
+    bool thrown = false;
+    try {
+        worker_pool::parallel_for(1000, 8, [](size_t i) {
+            if (i == 777) throw std::runtime_error("boom");
+        });
+    } catch (const std::runtime_error& ex) {
+        thrown = std::string(ex.what()) == "boom";
+    }
+    ASSERT_TRUE("worker exception rethrown on the calling thread", thrown);
+    worker_pool::set_budget(0);
+}
+
+TEST(empty_range_is_a_noop) {
+    worker_pool::parallel_for(0, 8, [](size_t) { throw std::runtime_error("no"); });
+    pass("zero items never invokes the body");
+}
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+int main() {
+    std::cout << "test_worker_pool\n";
+
+    test_budget_controls_effective();
+    test_every_index_runs_exactly_once();
+    test_budget_of_one_runs_inline();
+    test_stats_count_forked_batches();
+    test_exceptions_reach_the_caller();
+    test_empty_range_is_a_noop();
+
+    std::cout << "\n=== " << g_pass << " passed, " << g_fail << " failed ===\n";
+    return g_fail == 0 ? 0 : 1;
+}
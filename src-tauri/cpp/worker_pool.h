@@ -0,0 +1,119 @@
+// worker_pool.h
+//
+// Kernel-wide worker budget and fork-join helper.  Parallelism inside the
+// kernel used to be ad hoc — every feature asked hardware_concurrency() for
+// itself and OCCT's mesher spun up its own threads besides — which
+// oversubscribes the machine when the host application (the Rust side runs a
+// full Rayon pool) is busy too.  All parallel kernel features size their
+// worker sets from the single budget here, so `cg_set_worker_threads(n)`
+// bounds total kernel threads in one place.
+//
+// This header has no dependency on OCCT so it can be compiled and tested
+// independently (same pattern as bvh.h).  The C API (cg_set_worker_threads,
+// cg_pool_stats) lives in cam_threads.cpp.
+//
+// Design:
+//   - Kernel parallel sections are short-lived fork-join loops over presized
+//     disjoint work (face blocks, query batches, grid strips), so a shared
+//     BUDGET plus a chunked fork-join parallel_for gives the composability a
+//     persistent work-stealing pool would, without a scheduler thread that
+//     outlives the C calls.  Workers pull chunks from an atomic cursor, the
+//     calling thread participates, and exceptions are rethrown on the caller
+//     as std::runtime_error (same contract as the tessellation fill pass).
+//   - Stats counters are relaxed atomics; cg_pool_stats() is a snapshot for
+//     tuning, not a synchronization point.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace worker_pool {
+
+// 0 = auto (hardware concurrency).
+inline std::atomic<size_t> g_budget{0};
+
+// Lifetime counters, exposed through cg_pool_stats().
+inline std::atomic<uint64_t> g_batches{0};  // parallel_for calls that forked
+inline std::atomic<uint64_t> g_tasks{0};    // work items executed in them
+
+inline void set_budget(size_t n) {
+    g_budget.store(n, std::memory_order_relaxed);
+}
+
+inline size_t configured() {
+    return g_budget.load(std::memory_order_relaxed);
+}
+
+// The worker count a parallel section may use right now (>= 1).
+inline size_t effective() {
+    const size_t n = configured();
+    if (n != 0) return n;
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw ? hw : 1;
+}
+
+// Record a parallel section that forked with its own machinery (sections
+// with bespoke reduction or error handling size themselves from effective()
+// and report here so cg_pool_stats() still sees them).
+inline void note_batch(size_t n_tasks) {
+    g_batches.fetch_add(1, std::memory_order_relaxed);
+    g_tasks.fetch_add(n_tasks, std::memory_order_relaxed);
+}
+
+// Run fn(i) for i in [0, n) across at most effective() workers, pulling
+// chunks of `chunk` indices from a shared cursor.  Runs inline (no fork, no
+// stats) when one worker suffices.
+template <typename Fn>
+void parallel_for(size_t n, size_t chunk, Fn&& fn) {
+    if (n == 0) return;
+    if (chunk == 0) chunk = 1;
+
+    const size_t n_workers =
+        std::min(effective(), (n + chunk - 1) / chunk);
+    if (n_workers <= 1) {
+        for (size_t i = 0; i < n; ++i) fn(i);
+        return;
+    }
+
+    note_batch(n);
+
+    std::atomic<size_t> cursor{0};
+    std::mutex          err_mutex;
+    std::string         first_error;
+
+    auto worker = [&]() {
+        try {
+            for (size_t begin = cursor.fetch_add(chunk,
+                                                 std::memory_order_relaxed);
+                 begin < n;
+                 begin = cursor.fetch_add(chunk, std::memory_order_relaxed)) {
+                const size_t end = std::min(n, begin + chunk);
+                for (size_t i = begin; i < end; ++i) fn(i);
+            }
+        } catch (const std::exception& ex) {
+            std::lock_guard<std::mutex> lock(err_mutex);
+            if (first_error.empty()) first_error = ex.what();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(err_mutex);
+            if (first_error.empty())
+                first_error = "unknown exception in worker pool";
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_workers - 1);
+    for (size_t w = 1; w < n_workers; ++w) threads.emplace_back(worker);
+    worker();  // the calling thread participates
+    for (auto& t : threads) t.join();
+
+    if (!first_error.empty()) throw std::runtime_error(first_error);
+}
+
+} // namespace worker_pool